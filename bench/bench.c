@@ -0,0 +1,85 @@
+/**
+ * @file     bench.c
+ * @brief    bench.h implementation
+ * @author   Aleix Conchillo Flaque <aconchillo@gmail.com>
+ * @date     Sun Oct 18, 2026 10:12
+ *
+ * @if copyright
+ *
+ * Copyright (C) 2026 Aleix Conchillo Flaque
+ *
+ * SCEW is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * SCEW is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ *
+ * @endif
+ */
+
+#include "bench.h"
+
+#include <time.h>
+#include <unistd.h>
+
+#include <sys/resource.h>
+
+
+double
+bench_now (void)
+{
+  struct timespec ts;
+
+  clock_gettime (CLOCK_MONOTONIC, &ts);
+
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+long
+bench_peak_rss (void)
+{
+  struct rusage usage;
+
+  getrusage (RUSAGE_SELF, &usage);
+
+  return usage.ru_maxrss;
+}
+
+long
+bench_rss (void)
+{
+  long pages = 0;
+  long rss = 0;
+  FILE *file = fopen ("/proc/self/statm", "r");
+
+  if (file != NULL)
+    {
+      if (fscanf (file, "%ld %ld", &pages, &rss) != 2)
+        {
+          rss = 0;
+        }
+      fclose (file);
+    }
+
+  return rss * (sysconf (_SC_PAGESIZE) / 1024);
+}
+
+void
+bench_fail (char const *what)
+{
+  scew_error code = scew_error_code ();
+
+  fprintf (stderr, "%s failed (error #%d: %s)\n",
+           what, code, scew_error_string (code));
+
+  exit (EXIT_FAILURE);
+}
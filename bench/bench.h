@@ -0,0 +1,58 @@
+/**
+ * @file     bench.h
+ * @brief    Common routines for SCEW benchmarks
+ * @author   Aleix Conchillo Flaque <aconchillo@gmail.com>
+ * @date     Sun Oct 18, 2026 10:12
+ *
+ * @if copyright
+ *
+ * Copyright (C) 2026 Aleix Conchillo Flaque
+ *
+ * SCEW is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * SCEW is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ *
+ * @endif
+ */
+
+#ifndef BENCH_H_2610181012
+#define BENCH_H_2610181012
+
+#include <scew/scew.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * Returns a monotonic time stamp in seconds.
+ */
+extern double bench_now (void);
+
+/**
+ * Returns the peak resident set size of the process in kilobytes.
+ */
+extern long bench_peak_rss (void);
+
+/**
+ * Returns the current resident set size of the process in kilobytes.
+ */
+extern long bench_rss (void);
+
+/**
+ * Prints the last SCEW error, with the given description, and exits.
+ */
+extern void bench_fail (char const *what);
+
+#endif /* BENCH_H_2610181012 */
@@ -0,0 +1,127 @@
+/**
+ * @file     bench_attributes.c
+ * @brief    Attribute-heavy documents parsing benchmark
+ * @author   Aleix Conchillo Flaque <aconchillo@gmail.com>
+ * @date     Sun Oct 18, 2026 10:12
+ *
+ * @if copyright
+ *
+ * Copyright (C) 2026 Aleix Conchillo Flaque
+ *
+ * SCEW is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * SCEW is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ *
+ * @endif
+ *
+ * This benchmark loads documents made of telemetry-like records with
+ * many attributes each (20, 40 and 80), with and without the parser
+ * arena mode, and reports the loading time per record.
+ *
+ * Usage: bench_attributes [n_records] (default: 20000)
+ */
+
+#include "bench.h"
+
+static char*
+create_document_ (unsigned long n_records,
+                  unsigned int n_attributes,
+                  size_t *length)
+{
+  unsigned long i = 0;
+  unsigned int j = 0;
+  size_t pos = 0;
+  size_t total = 32 + n_records * (32 + n_attributes * 32);
+  char *document = malloc (total);
+
+  if (NULL == document)
+    {
+      return NULL;
+    }
+
+  pos += sprintf (document + pos, "<records>\n");
+  for (i = 0; i < n_records; ++i)
+    {
+      pos += sprintf (document + pos, "  <record");
+      for (j = 0; j < n_attributes; ++j)
+        {
+          pos += sprintf (document + pos, " metric%u=\"%lu\"", j, i + j);
+        }
+      pos += sprintf (document + pos, "/>\n");
+    }
+  pos += sprintf (document + pos, "</records>\n");
+
+  *length = pos;
+
+  return document;
+}
+
+static void
+run_ (unsigned long n_records, unsigned int n_attributes, scew_bool arena)
+{
+  size_t length = 0;
+  double start = 0;
+  double elapsed = 0;
+  scew_parser *parser = NULL;
+  scew_reader *reader = NULL;
+  scew_tree *tree = NULL;
+  char *document = create_document_ (n_records, n_attributes, &length);
+
+  if (NULL == document)
+    {
+      fprintf (stderr, "Unable to allocate document\n");
+      exit (EXIT_FAILURE);
+    }
+
+  parser = scew_parser_create ();
+  reader = scew_reader_buffer_create (document, length);
+
+  scew_parser_set_arena (parser, arena);
+
+  start = bench_now ();
+  tree = scew_parser_load (parser, reader);
+  elapsed = bench_now () - start;
+
+  if (NULL == tree)
+    {
+      bench_fail ("Loading document");
+    }
+
+  printf ("%2u attributes, %-5s: %8.3f s (%8.2f us/record)\n",
+          n_attributes, arena ? "arena" : "heap",
+          elapsed, elapsed * 1e6 / n_records);
+
+  scew_tree_free (tree);
+  scew_reader_free (reader);
+  scew_parser_free (parser);
+  free (document);
+}
+
+int
+main (int argc, char *argv[])
+{
+  static unsigned int const N_ATTRIBUTES[] = { 20, 40, 80 };
+
+  int i = 0;
+  unsigned long n_records =
+    (argc < 2) ? 20000 : strtoul (argv[1], NULL, 10);
+
+  for (i = 0; i < 3; ++i)
+    {
+      run_ (n_records, N_ATTRIBUTES[i], SCEW_FALSE);
+      run_ (n_records, N_ATTRIBUTES[i], SCEW_TRUE);
+    }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,155 @@
+/**
+ * @file     bench_batch.c
+ * @brief    Batch loading benchmark
+ * @author   Aleix Conchillo Flaque <aconchillo@gmail.com>
+ * @date     Sun Oct 18, 2026 10:12
+ *
+ * @if copyright
+ *
+ * Copyright (C) 2026 Aleix Conchillo Flaque
+ *
+ * SCEW is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * SCEW is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ *
+ * @endif
+ *
+ * This benchmark writes many small XML files (2000 by default) and
+ * loads all of them, as an application would do at startup, first
+ * one after another with a single parser and then with
+ * scew_parser_load_batch_files using from 1 up to the given number of
+ * threads (the number of processors by default).
+ *
+ * Usage: bench_batch [files] [max_threads]
+ */
+
+#include "bench.h"
+
+#include <unistd.h>
+
+static void
+create_file_ (char const *file_name, unsigned long index)
+{
+  unsigned long i = 0;
+  FILE *file = fopen (file_name, "w");
+
+  if (NULL == file)
+    {
+      fprintf (stderr, "Unable to create %s\n", file_name);
+      exit (EXIT_FAILURE);
+    }
+
+  fprintf (file, "<config id=\"%lu\">\n", index);
+  for (i = 0; i < 200; ++i)
+    {
+      fprintf (file,
+               "  <option name=\"option%lu\" enabled=\"true\">"
+               "value %lu</option>\n", i, i);
+    }
+  fprintf (file, "</config>\n");
+
+  fclose (file);
+}
+
+static void
+run_sequential_ (char const **file_names, unsigned long n_files)
+{
+  unsigned long i = 0;
+  double start = 0;
+  double elapsed = 0;
+  scew_parser *parser = scew_parser_create ();
+
+  start = bench_now ();
+  for (i = 0; i < n_files; ++i)
+    {
+      scew_reader *reader = scew_reader_mmap_create (file_names[i]);
+      scew_tree *tree = scew_parser_load (parser, reader);
+
+      if (NULL == tree)
+        {
+          bench_fail ("Loading document");
+        }
+
+      scew_tree_free (tree);
+      scew_reader_free (reader);
+    }
+  elapsed = bench_now () - start;
+
+  printf ("sequential: %8.3f s\n", elapsed);
+
+  scew_parser_free (parser);
+}
+
+static void
+run_batch_ (char const **file_names, unsigned long n_files,
+            unsigned int n_threads)
+{
+  unsigned long i = 0;
+  double start = 0;
+  double elapsed = 0;
+  scew_tree **trees = calloc (n_files, sizeof (scew_tree *));
+
+  start = bench_now ();
+  if (!scew_parser_load_batch_files (NULL, file_names, n_files, n_threads,
+                                     trees, NULL))
+    {
+      bench_fail ("Loading batch");
+    }
+  elapsed = bench_now () - start;
+
+  printf ("%3u threads: %8.3f s\n", n_threads, elapsed);
+
+  for (i = 0; i < n_files; ++i)
+    {
+      scew_tree_free (trees[i]);
+    }
+  free (trees);
+}
+
+int
+main (int argc, char *argv[])
+{
+  unsigned long i = 0;
+  unsigned int n_threads = 0;
+  unsigned long n_files = (argc < 2) ? 2000 : strtoul (argv[1], NULL, 10);
+  unsigned int max_threads = (argc < 3)
+    ? (unsigned int) sysconf (_SC_NPROCESSORS_ONLN)
+    : (unsigned int) strtoul (argv[2], NULL, 10);
+  char const **file_names = calloc (n_files, sizeof (char const *));
+
+  for (i = 0; i < n_files; ++i)
+    {
+      char *file_name = malloc (64);
+      snprintf (file_name, 64, "bench_batch_%lu.xml", i);
+      create_file_ (file_name, i);
+      file_names[i] = file_name;
+    }
+
+  printf ("%lu files\n", n_files);
+
+  run_sequential_ (file_names, n_files);
+  for (n_threads = 1; n_threads <= max_threads; n_threads *= 2)
+    {
+      run_batch_ (file_names, n_files, n_threads);
+    }
+
+  for (i = 0; i < n_files; ++i)
+    {
+      remove (file_names[i]);
+      free ((char *) file_names[i]);
+    }
+  free (file_names);
+
+  return EXIT_SUCCESS;
+}
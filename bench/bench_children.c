@@ -0,0 +1,111 @@
+/**
+ * @file     bench_children.c
+ * @brief    Element children access benchmark
+ * @author   Aleix Conchillo Flaque <aconchillo@gmail.com>
+ * @date     Sun Oct 18, 2026 10:12
+ *
+ * @if copyright
+ *
+ * Copyright (C) 2026 Aleix Conchillo Flaque
+ *
+ * SCEW is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * SCEW is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ *
+ * @endif
+ *
+ * This benchmark creates elements with many children (1000, 10000
+ * and 100000 by default) and measures the time needed to build them
+ * and to visit all the children by index and via the children list.
+ *
+ * Usage: bench_children [n_children ...]
+ */
+
+#include "bench.h"
+
+static void
+run_ (unsigned long n_children)
+{
+  unsigned long i = 0;
+  unsigned long visited = 0;
+  double start = 0;
+  double build = 0;
+  double by_index = 0;
+  double by_list = 0;
+  scew_list *list = NULL;
+  scew_element *root = scew_element_create (_XT("root"));
+
+  start = bench_now ();
+  for (i = 0; i < n_children; ++i)
+    {
+      if (NULL == scew_element_add (root, _XT("child")))
+        {
+          bench_fail ("Adding child");
+        }
+    }
+  build = bench_now () - start;
+
+  start = bench_now ();
+  for (i = 0; i < scew_element_count (root); ++i)
+    {
+      visited += (scew_element_by_index (root, i) != NULL);
+    }
+  by_index = bench_now () - start;
+
+  start = bench_now ();
+  list = scew_element_children (root);
+  while (list != NULL)
+    {
+      visited += (scew_list_data (list) != NULL);
+      list = scew_list_next (list);
+    }
+  by_list = bench_now () - start;
+
+  if (visited != 2 * n_children)
+    {
+      fprintf (stderr, "Unexpected number of visited children\n");
+      exit (EXIT_FAILURE);
+    }
+
+  printf ("%8lu children: build %8.4f s, by index %8.4f s, "
+          "by list %8.4f s\n",
+          n_children, build, by_index, by_list);
+
+  scew_element_free (root);
+}
+
+int
+main (int argc, char *argv[])
+{
+  static unsigned long const DEFAULT_SIZES[] = { 1000, 10000, 100000 };
+
+  int i = 0;
+
+  if (argc < 2)
+    {
+      for (i = 0; i < 3; ++i)
+        {
+          run_ (DEFAULT_SIZES[i]);
+        }
+    }
+  else
+    {
+      for (i = 1; i < argc; ++i)
+        {
+          run_ (strtoul (argv[i], NULL, 10));
+        }
+    }
+
+  return EXIT_SUCCESS;
+}
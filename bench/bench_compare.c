@@ -0,0 +1,123 @@
+/**
+ * @file     bench_compare.c
+ * @brief    Tree comparison benchmark
+ * @author   Aleix Conchillo Flaque <aconchillo@gmail.com>
+ * @date     Sun Oct 18, 2026 10:12
+ *
+ * @if copyright
+ *
+ * Copyright (C) 2026 Aleix Conchillo Flaque
+ *
+ * SCEW is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * SCEW is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ *
+ * @endif
+ *
+ *
+ * This benchmark compares a configuration-like tree (1000000 elements
+ * by default) against an equal copy and against a copy with a
+ * different last element, as done when reloading configurations. It
+ * reports the time of a full comparison, of computing the structural
+ * hashes, and of comparing again once hashes are available.
+ *
+ * Usage: bench_compare [n_elements]
+ */
+
+#include "bench.h"
+
+static scew_tree*
+create_tree_ (unsigned long n_elements)
+{
+  unsigned long i = 0;
+  scew_tree *tree = scew_tree_create ();
+  scew_element *root = scew_tree_set_root (tree, _XT("config"));
+
+  /* Each group has one element and three children. */
+  for (i = 0; i < n_elements / 4; ++i)
+    {
+      scew_element *group = scew_element_add (root, _XT("group"));
+      scew_element *value = NULL;
+
+      scew_element_add_attribute_pair (group, _XT("id"), _XT("12345"));
+      scew_element_add_attribute_pair (group, _XT("enabled"), _XT("true"));
+      scew_element_add_pair (group, _XT("name"), _XT("group name"));
+      value = scew_element_add_pair (group, _XT("value"), _XT("12345"));
+      scew_element_add_attribute_pair (value, _XT("type"), _XT("int"));
+      scew_element_add (group, _XT("option"));
+    }
+
+  return tree;
+}
+
+static void
+run_ (char const *what, scew_tree const *live, unsigned long n_elements,
+      scew_bool modify)
+{
+  double start = 0;
+  double walk = 0;
+  double hash = 0;
+  double cached = 0;
+  scew_bool equal = SCEW_FALSE;
+  scew_tree *fresh = create_tree_ (n_elements);
+  scew_element *root = scew_tree_root (fresh);
+
+  if (modify)
+    {
+      scew_element *last =
+        scew_element_by_index (root, scew_element_count (root) - 1);
+      scew_element_set_contents (scew_element_by_index (last, 0),
+                                 _XT("new name"));
+    }
+
+  start = bench_now ();
+  equal = scew_tree_compare (live, fresh, NULL);
+  walk = bench_now () - start;
+
+  start = bench_now ();
+  scew_element_hash (root);
+  hash = bench_now () - start;
+
+  start = bench_now ();
+  if (scew_tree_compare (live, fresh, NULL) != equal)
+    {
+      bench_fail ("Comparing hashed trees");
+    }
+  cached = bench_now () - start;
+
+  printf ("%-10s walk %8.2f ms, hash %8.2f ms, hashed compare %8.4f ms\n",
+          what, walk * 1000.0, hash * 1000.0, cached * 1000.0);
+
+  scew_tree_free (fresh);
+}
+
+int
+main (int argc, char *argv[])
+{
+  unsigned long n_elements =
+    (argc < 2) ? 1000000 : strtoul (argv[1], NULL, 10);
+  scew_tree *live = create_tree_ (n_elements);
+
+  printf ("%lu elements\n", n_elements);
+
+  /* The live tree is only hashed once. */
+  scew_element_hash (scew_tree_root (live));
+
+  run_ ("equal", live, n_elements, SCEW_FALSE);
+  run_ ("different", live, n_elements, SCEW_TRUE);
+
+  scew_tree_free (live);
+
+  return EXIT_SUCCESS;
+}
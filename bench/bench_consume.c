@@ -0,0 +1,230 @@
+/**
+ * @file     bench_consume.c
+ * @brief    SCEW parser consume hook benchmark
+ * @author   Aleix Conchillo Flaque <aconchillo@gmail.com>
+ * @date     Sun Oct 18, 2026 10:12
+ *
+ * @if copyright
+ *
+ * Copyright (C) 2026 Aleix Conchillo Flaque
+ *
+ * SCEW is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * SCEW is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ *
+ * @endif
+ *
+ * This benchmark loads documents formed by one root element and many
+ * record children (from 100K up to 10M records by default) with
+ * scew_parser_load_stream and a consume hook that frees every record
+ * once parsed. Documents are generated on the fly by a custom reader,
+ * so their size is not limited by memory or disk. The peak resident
+ * set size is reported after each document, and it should not grow
+ * with the document size. Finally, the smallest document is loaded
+ * without the consume hook for comparison.
+ *
+ * Usage: bench_consume [max_records]
+ */
+
+#include "bench.h"
+
+static char const *RECORD =
+  "  <record id=\"%lu\"><name>customer</name>"
+  "<note>Some text that is not really needed.</note></record>\n";
+
+typedef struct
+{
+  unsigned long records;        /* Records to generate */
+  unsigned long next;           /* Next record to generate */
+  scew_bool finished;           /* Whether the root end tag is given */
+  char chunk[256];              /* Document piece being read */
+  size_t length;                /* Characters in chunk */
+  size_t offset;                /* Characters of chunk already read */
+} generator;
+
+static size_t
+generator_read_ (scew_reader *reader, XML_Char *buffer, size_t char_no)
+{
+  size_t read_no = 0;
+  generator *gen = scew_reader_data (reader);
+
+  while (read_no < char_no)
+    {
+      size_t length = 0;
+
+      if (gen->offset == gen->length)
+        {
+          if (0 == gen->next)
+            {
+              gen->length = sprintf (gen->chunk, "<records>\n");
+            }
+          else if (gen->next <= gen->records)
+            {
+              gen->length = sprintf (gen->chunk, RECORD, gen->next);
+            }
+          else if (!gen->finished)
+            {
+              gen->length = sprintf (gen->chunk, "</records>\n");
+              gen->finished = SCEW_TRUE;
+            }
+          else
+            {
+              break;
+            }
+          gen->next += 1;
+          gen->offset = 0;
+        }
+
+      length = gen->length - gen->offset;
+      if (length > char_no - read_no)
+        {
+          length = char_no - read_no;
+        }
+      memcpy (buffer + read_no, gen->chunk + gen->offset, length);
+      gen->offset += length;
+      read_no += length;
+    }
+
+  buffer[read_no] = '\0';
+
+  return read_no;
+}
+
+static scew_bool
+generator_end_ (scew_reader *reader)
+{
+  generator *gen = scew_reader_data (reader);
+
+  return gen->finished && (gen->offset == gen->length);
+}
+
+static scew_bool
+generator_error_ (scew_reader *reader)
+{
+  return SCEW_FALSE;
+}
+
+static scew_bool
+generator_close_ (scew_reader *reader)
+{
+  return SCEW_TRUE;
+}
+
+static void
+generator_free_ (scew_reader *reader)
+{
+  free (scew_reader_data (reader));
+}
+
+static scew_reader_hooks const generator_hooks_ =
+  {
+    generator_read_,
+    generator_end_,
+    generator_error_,
+    generator_close_,
+    generator_free_,
+    NULL
+  };
+
+static scew_parser_consume
+consume_hook_ (scew_parser *parser, scew_element *element, void *user_data)
+{
+  unsigned long *counter = user_data;
+
+  if (strcmp (scew_element_name (element), "record") != 0)
+    {
+      return scew_parser_consume_keep;
+    }
+
+  *counter += 1;
+
+  return scew_parser_consume_free;
+}
+
+static scew_bool
+tree_hook_ (scew_parser *parser, void *tree, void *user_data)
+{
+  unsigned long *counter = user_data;
+
+  *counter += scew_element_count (scew_tree_root (tree));
+
+  scew_tree_free (tree);
+
+  return SCEW_TRUE;
+}
+
+static void
+run_ (unsigned long records, scew_bool consume)
+{
+  unsigned long counter = 0;
+  double start = 0;
+  double elapsed = 0;
+  scew_reader *reader = NULL;
+  scew_parser *parser = scew_parser_create ();
+  generator *gen = calloc (1, sizeof (generator));
+
+  reader = scew_reader_create (&generator_hooks_, gen);
+  if ((NULL == parser) || (NULL == reader))
+    {
+      bench_fail ("Creating parser");
+    }
+  gen->records = records;
+
+  scew_parser_set_tree_hook (parser, tree_hook_, &counter);
+  if (consume)
+    {
+      scew_parser_set_consume_hook (parser, consume_hook_, &counter);
+    }
+
+  start = bench_now ();
+  if (!scew_parser_load_stream (parser, reader))
+    {
+      bench_fail ("Loading stream");
+    }
+  elapsed = bench_now () - start;
+
+  if (counter != records)
+    {
+      fprintf (stderr, "Loaded %lu records, expected %lu\n",
+               counter, records);
+      exit (EXIT_FAILURE);
+    }
+
+  printf ("%-7s: %9lu records (%8.1f MB) in %8.3f s (peak RSS %8ld KB)\n",
+          consume ? "consume" : "keep", records,
+          records * (strlen (RECORD) + 3) / (1024.0 * 1024.0), elapsed,
+          bench_peak_rss ());
+
+  scew_reader_free (reader);
+  scew_parser_free (parser);
+}
+
+int
+main (int argc, char *argv[])
+{
+  unsigned long records = 0;
+  unsigned long max_records =
+    (argc < 2) ? 10000000 : strtoul (argv[1], NULL, 10);
+
+  printf ("Initial peak RSS %ld KB\n", bench_peak_rss ());
+
+  /* Consuming goes first, as peak RSS never decreases. */
+  for (records = 100000; records <= max_records; records *= 10)
+    {
+      run_ (records, SCEW_TRUE);
+    }
+  run_ (100000, SCEW_FALSE);
+
+  return EXIT_SUCCESS;
+}
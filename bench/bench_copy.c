@@ -0,0 +1,124 @@
+/**
+ * @file     bench_copy.c
+ * @brief    Tree copy benchmark
+ * @author   Aleix Conchillo Flaque <aconchillo@gmail.com>
+ * @date     Sun Oct 18, 2026 10:12
+ *
+ * @if copyright
+ *
+ * Copyright (C) 2026 Aleix Conchillo Flaque
+ *
+ * SCEW is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * SCEW is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ *
+ * @endif
+ *
+ *
+ * This benchmark creates trees from 10000 elements up to the given
+ * number of elements (10000000 by default), and measures the latency
+ * of copying them with #scew_tree_copy and #scew_tree_copy_parallel
+ * (with one thread and with one thread per processor). The time
+ * needed to free the copies is also reported. Each copy is done three
+ * times and the best times are reported, so memory freshly obtained
+ * from the system does not dominate.
+ *
+ * Usage: bench_copy [max_elements]
+ */
+
+#include "bench.h"
+
+static scew_tree*
+create_tree_ (unsigned long n_elements)
+{
+  unsigned long i = 0;
+  scew_tree *tree = scew_tree_create ();
+  scew_element *root = scew_tree_set_root (tree, _XT("config"));
+
+  /* Each group has one element and three children. */
+  for (i = 0; i < n_elements / 4; ++i)
+    {
+      scew_element *group = scew_element_add (root, _XT("group"));
+      scew_element *value = NULL;
+
+      scew_element_add_attribute_pair (group, _XT("id"), _XT("12345"));
+      scew_element_add_attribute_pair (group, _XT("enabled"), _XT("true"));
+      scew_element_add_pair (group, _XT("name"), _XT("group name"));
+      value = scew_element_add_pair (group, _XT("value"), _XT("12345"));
+      scew_element_add_attribute_pair (value, _XT("type"), _XT("int"));
+      scew_element_add (group, _XT("option"));
+    }
+
+  return tree;
+}
+
+static void
+run_ (scew_tree const *tree, char const *what, scew_bool parallel,
+      unsigned int n_threads)
+{
+  enum { REPEAT = 3 };
+
+  double start = 0;
+  double copy = 0;
+  double release = 0;
+  unsigned int i = 0;
+
+  for (i = 0; i < REPEAT; ++i)
+    {
+      scew_tree *tree_copy = NULL;
+
+      start = bench_now ();
+      tree_copy = parallel
+        ? scew_tree_copy_parallel (tree, n_threads)
+        : scew_tree_copy (tree);
+      start = bench_now () - start;
+      copy = ((0 == i) || (start < copy)) ? start : copy;
+
+      if (NULL == tree_copy)
+        {
+          bench_fail ("Copying tree");
+        }
+
+      start = bench_now ();
+      scew_tree_free (tree_copy);
+      start = bench_now () - start;
+      release = ((0 == i) || (start < release)) ? start : release;
+    }
+
+  printf ("  %-20s copy %9.2f ms, free %9.2f ms\n",
+          what, copy * 1000.0, release * 1000.0);
+}
+
+int
+main (int argc, char *argv[])
+{
+  unsigned long max_elements =
+    (argc < 2) ? 10000000 : strtoul (argv[1], NULL, 10);
+  unsigned long n_elements = 0;
+
+  for (n_elements = 10000; n_elements <= max_elements; n_elements *= 10)
+    {
+      scew_tree *tree = create_tree_ (n_elements);
+
+      printf ("%lu elements\n", n_elements);
+
+      run_ (tree, "scew_tree_copy", SCEW_FALSE, 1);
+      run_ (tree, "parallel, 1 thread", SCEW_TRUE, 1);
+      run_ (tree, "parallel, all cpus", SCEW_TRUE, 0);
+
+      scew_tree_free (tree);
+    }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,109 @@
+/**
+ * @file     bench_print.c
+ * @brief    Escaped text printing benchmark
+ * @author   Aleix Conchillo Flaque <aconchillo@gmail.com>
+ * @date     Sun Oct 18, 2026 10:12
+ *
+ * @if copyright
+ *
+ * Copyright (C) 2026 Aleix Conchillo Flaque
+ *
+ * SCEW is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * SCEW is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ *
+ * @endif
+ *
+ * This benchmark prints elements with long text contents and
+ * attribute values to /dev/null, both for plain text (nothing to
+ * escape) and for markup-heavy text (many entities), and reports the
+ * printing throughput.
+ *
+ * Usage: bench_escape [n_elements] [text_length]
+ */
+
+#include "bench.h"
+
+static scew_tree*
+create_tree_ (unsigned long n_elements, size_t length, char const *alphabet)
+{
+  unsigned long i = 0;
+  size_t j = 0;
+  size_t n_chars = strlen (alphabet);
+  char *text = malloc (length + 1);
+  scew_tree *tree = scew_tree_create ();
+  scew_element *root = scew_tree_set_root (tree, "root");
+
+  for (j = 0; j < length; ++j)
+    {
+      text[j] = alphabet[j % n_chars];
+    }
+  text[length] = '\0';
+
+  for (i = 0; i < n_elements; ++i)
+    {
+      scew_element *element = scew_element_add_pair (root, "text", text);
+      scew_element_add_attribute_pair (element, "value", text);
+    }
+
+  free (text);
+
+  return tree;
+}
+
+static void
+run_ (char const *what, scew_tree const *tree, size_t length)
+{
+  double start = 0;
+  double elapsed = 0;
+  unsigned long n_elements = scew_element_count (scew_tree_root (tree));
+  FILE *file = fopen ("/dev/null", "w");
+  scew_writer *writer = scew_writer_fp_buffered_create (file, 65536);
+  scew_printer *printer = scew_printer_create (writer);
+
+  start = bench_now ();
+  if (!scew_printer_print_tree (printer, tree))
+    {
+      bench_fail ("Printing tree");
+    }
+  elapsed = bench_now () - start;
+
+  printf ("%-8s: %8.3f s (%8.2f MB/s of text)\n", what, elapsed,
+          2.0 * n_elements * length / (1024.0 * 1024.0) / elapsed);
+
+  scew_printer_free (printer);
+  scew_writer_free (writer);
+}
+
+int
+main (int argc, char *argv[])
+{
+  unsigned long n_elements = (argc < 2) ? 50000 : strtoul (argv[1], NULL, 10);
+  size_t length = (argc < 3) ? 1000 : strtoul (argv[2], NULL, 10);
+  scew_tree *plain = create_tree_ (n_elements, length,
+                                   "The quick brown fox jumps over a dog. ");
+  scew_tree *markup = create_tree_ (n_elements, length,
+                                    "if (a < b && c > d) say 'hi' \"x\"; ");
+
+  printf ("%lu elements (%lu characters)\n", n_elements,
+          (unsigned long) length);
+
+  run_ ("plain", plain, length);
+  run_ ("markup", markup, length);
+
+  scew_tree_free (plain);
+  scew_tree_free (markup);
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,138 @@
+/**
+ * @file     bench_feed.c
+ * @brief    SCEW push parsing benchmark
+ * @author   Aleix Conchillo Flaque <aconchillo@gmail.com>
+ * @date     Sun Oct 18, 2026 10:12
+ *
+ * @if copyright
+ *
+ * Copyright (C) 2026 Aleix Conchillo Flaque
+ *
+ * SCEW is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * SCEW is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ *
+ * @endif
+ *
+ * This benchmark simulates an event loop serving many connections
+ * (1000 by default) from a single thread. Each connection has its own
+ * parser and receives a stream of small documents, which is given to
+ * scew_parser_feed in small pieces (64 characters), one connection
+ * after the other as if data arrived interleaved from sockets. It
+ * reports the number of documents loaded per second and the peak
+ * resident set size.
+ *
+ * Usage: bench_feed [connections] [documents per connection]
+ */
+
+#include "bench.h"
+
+enum { PIECE_SIZE = 64 };
+
+static char const *DOCUMENT =
+  "<message id=\"%lu\"><from>sender</from><to>receiver</to>"
+  "<body type=\"text\">Hello, this is a short message.</body></message>\n";
+
+static scew_bool
+tree_hook_ (scew_parser *parser, void *tree, void *user_data)
+{
+  unsigned long *counter = user_data;
+
+  *counter += 1;
+
+  scew_tree_free (tree);
+
+  return SCEW_TRUE;
+}
+
+int
+main (int argc, char *argv[])
+{
+  unsigned long i = 0;
+  unsigned long counter = 0;
+  size_t size = 0;
+  size_t offset = 0;
+  char *stream = NULL;
+  scew_parser **parsers = NULL;
+  double start = 0;
+  double elapsed = 0;
+  unsigned long connections =
+    (argc < 2) ? 1000 : strtoul (argv[1], NULL, 10);
+  unsigned long documents =
+    (argc < 3) ? 1000 : strtoul (argv[2], NULL, 10);
+
+  /* All the connections receive the same stream. */
+  stream = malloc (documents * (strlen (DOCUMENT) + 20) + 1);
+  parsers = calloc (connections, sizeof (scew_parser *));
+  if ((NULL == stream) || (NULL == parsers))
+    {
+      fprintf (stderr, "Unable to create streams\n");
+      exit (EXIT_FAILURE);
+    }
+
+  for (i = 0; i < documents; ++i)
+    {
+      size += sprintf (stream + size, DOCUMENT, i);
+    }
+
+  for (i = 0; i < connections; ++i)
+    {
+      parsers[i] = scew_parser_create ();
+      if (NULL == parsers[i])
+        {
+          bench_fail ("Creating parser");
+        }
+      scew_parser_set_tree_hook (parsers[i], tree_hook_, &counter);
+    }
+
+  start = bench_now ();
+  for (offset = 0; offset < size; offset += PIECE_SIZE)
+    {
+      size_t length = (size - offset < PIECE_SIZE)
+        ? size - offset
+        : PIECE_SIZE;
+      scew_bool is_final = (offset + length == size);
+
+      for (i = 0; i < connections; ++i)
+        {
+          if (!scew_parser_feed (parsers[i], stream + offset, length,
+                                 is_final))
+            {
+              bench_fail ("Feeding parser");
+            }
+        }
+    }
+  elapsed = bench_now () - start;
+
+  if (counter != connections * documents)
+    {
+      fprintf (stderr, "Loaded %lu documents, expected %lu\n",
+               counter, connections * documents);
+      exit (EXIT_FAILURE);
+    }
+
+  printf ("%lu connections: %lu documents in %8.3f s "
+          "(%10.0f docs/s, peak RSS %ld KB)\n",
+          connections, counter, elapsed, counter / elapsed,
+          bench_peak_rss ());
+
+  for (i = 0; i < connections; ++i)
+    {
+      scew_parser_free (parsers[i]);
+    }
+  free (parsers);
+  free (stream);
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,137 @@
+/**
+ * @file     bench_filter.c
+ * @brief    SCEW parser filter hook benchmark
+ * @author   Aleix Conchillo Flaque <aconchillo@gmail.com>
+ * @date     Sun Oct 18, 2026 10:12
+ *
+ * @if copyright
+ *
+ * Copyright (C) 2026 Aleix Conchillo Flaque
+ *
+ * SCEW is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * SCEW is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ *
+ * @endif
+ *
+ * This benchmark loads a document with many records (1M by default)
+ * from a file, first keeping only 10% of the records with a filter
+ * hook and then building the whole tree, and reports the time and
+ * the peak resident set size after each of them.
+ *
+ * Usage: bench_filter [records]
+ */
+
+#include "bench.h"
+
+static char const *RECORD =
+  "  <record id=\"%lu\" region=\"%s\"><name>customer</name>"
+  "<address><street>Main street</street><city>Springfield</city>"
+  "</address><note>Some text that is not really needed.</note>"
+  "</record>\n";
+
+static scew_parser_filter
+filter_hook_ (scew_parser *parser, scew_element *parent, XML_Char const *name,
+              XML_Char const **attributes, void *user_data)
+{
+  /* Only records (children of the root) of one region are built. */
+  return ((NULL == scew_element_parent (parent))
+          && (strcmp (attributes[3], "north") != 0))
+    ? scew_parser_filter_skip
+    : scew_parser_filter_build;
+}
+
+static void
+run_ (char const *name, char const *file_name, scew_bool filter,
+      unsigned long expected)
+{
+  double start = 0;
+  double elapsed = 0;
+  scew_tree *tree = NULL;
+  scew_parser *parser = scew_parser_create ();
+  scew_reader *reader = scew_reader_file_create (file_name);
+
+  if ((NULL == parser) || (NULL == reader))
+    {
+      bench_fail ("Opening document");
+    }
+
+  if (filter)
+    {
+      scew_parser_set_filter_hook (parser, filter_hook_, NULL);
+    }
+
+  start = bench_now ();
+  tree = scew_parser_load (parser, reader);
+  elapsed = bench_now () - start;
+
+  if (NULL == tree)
+    {
+      bench_fail ("Loading document");
+    }
+
+  if (scew_element_count (scew_tree_root (tree)) != expected)
+    {
+      fprintf (stderr, "Loaded %u records, expected %lu\n",
+               scew_element_count (scew_tree_root (tree)), expected);
+      exit (EXIT_FAILURE);
+    }
+
+  printf ("%-6s: %8lu records in %8.3f s (peak RSS %8ld KB)\n", name,
+          expected, elapsed, bench_peak_rss ());
+
+  scew_tree_free (tree);
+  scew_reader_free (reader);
+  scew_parser_free (parser);
+}
+
+int
+main (int argc, char *argv[])
+{
+  static char const *FILE_NAME = "bench_filter.xml";
+  static char const *REGIONS[] =
+    {
+      "north", "south", "east", "west", "south", "east", "west", "south",
+      "east", "west"
+    };
+
+  unsigned long i = 0;
+  FILE *file = fopen (FILE_NAME, "w");
+  unsigned long records =
+    (argc < 2) ? 1000000 : strtoul (argv[1], NULL, 10);
+
+  if (NULL == file)
+    {
+      fprintf (stderr, "Unable to create %s\n", FILE_NAME);
+      exit (EXIT_FAILURE);
+    }
+
+  fputs ("<records>\n", file);
+  for (i = 0; i < records; ++i)
+    {
+      fprintf (file, RECORD, i, REGIONS[i % 10]);
+    }
+  fputs ("</records>\n", file);
+  fclose (file);
+
+  printf ("Initial peak RSS %ld KB\n", bench_peak_rss ());
+
+  /* Filtering goes first, as peak RSS never decreases. */
+  run_ ("filter", FILE_NAME, SCEW_TRUE, (records + 9) / 10);
+  run_ ("full", FILE_NAME, SCEW_FALSE, records);
+
+  remove (FILE_NAME);
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,184 @@
+/**
+ * @file     bench_index.c
+ * @brief    Tree index benchmark
+ * @author   Aleix Conchillo Flaque <aconchillo@gmail.com>
+ * @date     Sun Oct 18, 2026 10:12
+ *
+ * @if copyright
+ *
+ * Copyright (C) 2026 Aleix Conchillo Flaque
+ *
+ * SCEW is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * SCEW is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ *
+ * @endif
+ *
+ * This benchmark creates a tree with 1000 groups of 1000 elements,
+ * one out of every 100 of them named "route" (with a unique "id"
+ * attribute), and measures the time needed to find all the route
+ * elements and a route by id, either walking the tree or with a tree
+ * index. The time needed to build the index and to add elements to an
+ * indexed tree is also measured.
+ *
+ * Usage: bench_index [lookups] (default: 100)
+ */
+
+#include "bench.h"
+
+enum
+  {
+    N_GROUPS = 1000,
+    N_ELEMENTS = 1000,
+    ROUTE_EVERY = 100
+  };
+
+static unsigned long
+walk_ (scew_element *element, XML_Char const *name, XML_Char const *id,
+       scew_element **found)
+{
+  unsigned long count = 0;
+  unsigned int i = 0;
+
+  if (scew_strcmp (scew_element_name (element), name) == 0)
+    {
+      scew_attribute *attribute =
+        scew_element_attribute_by_name (element, _XT("id"));
+      if ((id != NULL) && (attribute != NULL)
+          && (scew_strcmp (scew_attribute_value (attribute), id) == 0))
+        {
+          *found = element;
+        }
+      ++count;
+    }
+
+  for (i = 0; i < scew_element_count (element); ++i)
+    {
+      count += walk_ (scew_element_by_index (element, i), name, id, found);
+    }
+
+  return count;
+}
+
+static void
+add_ (scew_tree *tree, char const *what)
+{
+  enum { N_ADDED = 100000 };
+
+  unsigned long i = 0;
+  double start = bench_now ();
+  scew_element *root = scew_tree_root (tree);
+
+  /* Elements are added to the first group, before all the others. */
+  for (i = 0; i < N_ADDED; ++i)
+    {
+      scew_element *group = scew_element_by_index (root, i % 10);
+      if (NULL == scew_element_add (group, _XT("added")))
+        {
+          bench_fail ("Adding element");
+        }
+    }
+
+  printf ("  add %d elements (%s): %8.3f ms\n", N_ADDED, what,
+          (bench_now () - start) * 1e3);
+}
+
+int
+main (int argc, char *argv[])
+{
+  enum { MAX_ID = 32 };
+
+  unsigned long lookups = (argc < 2) ? 100 : strtoul (argv[1], NULL, 10);
+  unsigned long i = 0;
+  unsigned long j = 0;
+  unsigned long count = 0;
+  double start = 0;
+  char id[MAX_ID];
+  scew_element *found = NULL;
+  scew_element * const *elements = NULL;
+  scew_tree *tree = scew_tree_create ();
+  scew_element *root = scew_tree_set_root (tree, _XT("root"));
+
+  for (i = 0; i < N_GROUPS; ++i)
+    {
+      scew_element *group = scew_element_add (root, _XT("group"));
+      for (j = 0; j < N_ELEMENTS; ++j)
+        {
+          scew_element *element = NULL;
+          if (j % ROUTE_EVERY == 0)
+            {
+              snprintf (id, MAX_ID, "r%lu", i * N_ELEMENTS + j);
+              element = scew_element_add (group, _XT("route"));
+              if ((element != NULL)
+                  && (NULL == scew_element_add_attribute_pair
+                      (element, _XT("id"), id)))
+                {
+                  element = NULL;
+                }
+            }
+          else
+            {
+              element = scew_element_add (group, _XT("item"));
+            }
+          if (NULL == element)
+            {
+              bench_fail ("Adding element");
+            }
+        }
+    }
+
+  add_ (tree, "no index");
+
+  start = bench_now ();
+  for (i = 0; i < lookups; ++i)
+    {
+      count = walk_ (root, _XT("route"), _XT("r500500"), &found);
+    }
+  printf ("  walk: %lu routes, %8.3f ms per lookup\n", count,
+          (bench_now () - start) * 1e3 / lookups);
+
+  start = bench_now ();
+  if (!scew_tree_build_index (tree, _XT("id")))
+    {
+      bench_fail ("Building index");
+    }
+  printf ("  build index: %8.3f ms\n", (bench_now () - start) * 1e3);
+
+  start = bench_now ();
+  for (i = 0; i < lookups; ++i)
+    {
+      count = scew_tree_elements_by_name (tree, _XT("route"), &elements);
+      if (scew_tree_element_by_attribute (tree, _XT("r500500")) != found)
+        {
+          fprintf (stderr, "Route not found\n");
+          exit (EXIT_FAILURE);
+        }
+    }
+  printf ("  index: %lu routes, %8.6f ms per lookup\n", count,
+          (bench_now () - start) * 1e3 / lookups);
+
+  add_ (tree, "index");
+
+  /* Added elements are merged into place by the next lookup. */
+  start = bench_now ();
+  count = scew_tree_elements_by_name (tree, _XT("added"), &elements);
+  printf ("  first lookup after adding: %lu elements, %8.3f ms\n", count,
+          (bench_now () - start) * 1e3);
+
+  start = bench_now ();
+  scew_tree_free (tree);
+  printf ("  free (index): %8.3f ms\n", (bench_now () - start) * 1e3);
+
+  return EXIT_SUCCESS;
+}
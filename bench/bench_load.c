@@ -0,0 +1,131 @@
+/**
+ * @file     bench_load.c
+ * @brief    File loading benchmark
+ * @author   Aleix Conchillo Flaque <aconchillo@gmail.com>
+ * @date     Sun Oct 18, 2026 10:12
+ *
+ * @if copyright
+ *
+ * Copyright (C) 2026 Aleix Conchillo Flaque
+ *
+ * SCEW is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * SCEW is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ *
+ * @endif
+ *
+ * This benchmark loads a big XML file (100 MB by default) from a file
+ * reader with different parser buffer sizes (see
+ * scew_parser_set_buffer_size) and from a memory-mapped file reader,
+ * and reports the loading throughput.
+ *
+ * Usage: bench_load [size_mb]
+ */
+
+#include "bench.h"
+
+static void
+create_file_ (char const *file_name, size_t size_mb)
+{
+  static char const *GROUP =
+    "  <group id=\"%lu\" enabled=\"true\">\n"
+    "    <name>group name</name>\n"
+    "    <value type=\"int\">12345</value>\n"
+    "  </group>\n";
+
+  unsigned long i = 0;
+  size_t size = 0;
+  size_t total = size_mb * 1024 * 1024;
+  FILE *file = fopen (file_name, "w");
+
+  if (NULL == file)
+    {
+      fprintf (stderr, "Unable to create %s\n", file_name);
+      exit (EXIT_FAILURE);
+    }
+
+  size += fprintf (file, "<config>\n");
+  for (i = 0; size < total; ++i)
+    {
+      size += fprintf (file, GROUP, i);
+    }
+  fprintf (file, "</config>\n");
+
+  fclose (file);
+}
+
+static void
+run_ (char const *file_name, size_t size_mb, size_t buffer_size)
+{
+  /* A zero buffer size means a memory-mapped reader. */
+  double start = 0;
+  double elapsed = 0;
+  scew_parser *parser = scew_parser_create ();
+  scew_reader *reader = (0 == buffer_size)
+    ? scew_reader_mmap_create (file_name)
+    : scew_reader_file_create (file_name);
+  scew_tree *tree = NULL;
+
+  /* Tree allocation is not what we want to measure. */
+  scew_parser_set_arena (parser, SCEW_TRUE);
+  if (buffer_size > 0)
+    {
+      scew_parser_set_buffer_size (parser, buffer_size);
+    }
+
+  start = bench_now ();
+  tree = scew_parser_load (parser, reader);
+  elapsed = bench_now () - start;
+
+  if (NULL == tree)
+    {
+      bench_fail ("Loading document");
+    }
+
+  if (buffer_size > 0)
+    {
+      printf ("buffer %8lu: %8.3f s (%8.2f MB/s)\n",
+              (unsigned long) buffer_size, elapsed, size_mb / elapsed);
+    }
+  else
+    {
+      printf ("mmap           : %8.3f s (%8.2f MB/s)\n",
+              elapsed, size_mb / elapsed);
+    }
+
+  scew_tree_free (tree);
+  scew_reader_free (reader);
+  scew_parser_free (parser);
+}
+
+int
+main (int argc, char *argv[])
+{
+  static char const *FILE_NAME = "bench_load.xml";
+
+  size_t size_mb = (argc < 2) ? 100 : strtoul (argv[1], NULL, 10);
+
+  create_file_ (FILE_NAME, size_mb);
+
+  printf ("%lu MB document\n", (unsigned long) size_mb);
+
+  run_ (FILE_NAME, size_mb, 1024);
+  run_ (FILE_NAME, size_mb, 32 * 1024);
+  run_ (FILE_NAME, size_mb, 1024 * 1024);
+  run_ (FILE_NAME, size_mb, 0);
+
+  remove (FILE_NAME);
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,145 @@
+/**
+ * @file     bench_names.c
+ * @brief    Element names memory benchmark
+ * @author   Aleix Conchillo Flaque <aconchillo@gmail.com>
+ * @date     Sun Oct 18, 2026 10:12
+ *
+ * @if copyright
+ *
+ * Copyright (C) 2026 Aleix Conchillo Flaque
+ *
+ * SCEW is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * SCEW is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ *
+ * @endif
+ *
+ * This benchmark loads a document with many elements (1000000 by
+ * default) sharing a few long element and attribute names, and reports
+ * the memory used by the loaded tree with and without the parser arena
+ * mode. Names are only stored once per tree in arena mode.
+ *
+ * Usage: bench_names [n_elements]
+ */
+
+#include "bench.h"
+
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+static char*
+create_document_ (unsigned long n_elements, size_t *length)
+{
+  static char const *NAMES[] =
+    {
+      "applicationSetting", "configurationEntry", "environmentVariable",
+      "networkInterface", "databaseConnection", "securityPolicy",
+      "loggingConfiguration", "serviceDefinition"
+    };
+  static size_t const N_NAMES = sizeof (NAMES) / sizeof (NAMES[0]);
+
+  unsigned long i = 0;
+  size_t pos = 0;
+  size_t total = (n_elements + 2) * 80;
+  char *document = malloc (total);
+
+  if (NULL == document)
+    {
+      return NULL;
+    }
+
+  pos += sprintf (document + pos, "<configurationRoot>\n");
+  for (i = 0; i < n_elements; ++i)
+    {
+      pos += sprintf (document + pos,
+                      "<%s identifier=\"%lu\" enabledFlag=\"1\"/>\n",
+                      NAMES[i % N_NAMES], i);
+    }
+  pos += sprintf (document + pos, "</configurationRoot>\n");
+
+  *length = pos;
+
+  return document;
+}
+
+static void
+run_ (char const *document, size_t length, scew_bool use_arena)
+{
+  long before = 0;
+  long after = 0;
+  double start = 0;
+  double elapsed = 0;
+  scew_parser *parser = scew_parser_create ();
+  scew_reader *reader = scew_reader_buffer_create (document, length);
+  scew_tree *tree = NULL;
+
+  scew_parser_set_arena (parser, use_arena);
+
+  before = bench_rss ();
+  start = bench_now ();
+  tree = scew_parser_load (parser, reader);
+  elapsed = bench_now () - start;
+  after = bench_rss ();
+
+  if (NULL == tree)
+    {
+      bench_fail ("Loading document");
+    }
+
+  printf ("%-6s tree memory: %8ld KB   load: %8.3f s\n",
+          use_arena ? "arena" : "heap", after - before, elapsed);
+
+  scew_tree_free (tree);
+  scew_reader_free (reader);
+  scew_parser_free (parser);
+}
+
+int
+main (int argc, char *argv[])
+{
+  size_t length = 0;
+  int i = 0;
+  unsigned long n_elements =
+    (argc < 2) ? 1000000 : strtoul (argv[1], NULL, 10);
+  char *document = create_document_ (n_elements, &length);
+
+  if (NULL == document)
+    {
+      fprintf (stderr, "Unable to allocate document\n");
+      return EXIT_FAILURE;
+    }
+
+  printf ("%lu elements (%lu bytes)\n", n_elements, (unsigned long) length);
+  fflush (stdout);
+
+  /* Run each mode in its own process, so memory is not reused. */
+  for (i = 0; i < 2; ++i)
+    {
+      pid_t pid = fork ();
+      if (0 == pid)
+        {
+          run_ (document, length, (1 == i) ? SCEW_TRUE : SCEW_FALSE);
+          exit (EXIT_SUCCESS);
+        }
+      else if (pid > 0)
+        {
+          waitpid (pid, NULL, 0);
+        }
+    }
+
+  free (document);
+
+  return EXIT_SUCCESS;
+}
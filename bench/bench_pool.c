@@ -0,0 +1,138 @@
+/**
+ * @file     bench_pool.c
+ * @brief    Parser pool benchmark
+ * @author   Aleix Conchillo Flaque <aconchillo@gmail.com>
+ * @date     Sun Oct 18, 2026 10:12
+ *
+ * @if copyright
+ *
+ * Copyright (C) 2026 Aleix Conchillo Flaque
+ *
+ * SCEW is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * SCEW is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ *
+ * @endif
+ *
+ * This benchmark loads small in-memory documents from several threads
+ * at the same time, either creating and freeing a parser for each
+ * document or acquiring parsers from a parser pool, and reports the
+ * throughput of both.
+ *
+ * Usage: bench_pool [threads] [documents per thread]
+ */
+
+#include "bench.h"
+
+#include <pthread.h>
+
+static char const *REQUEST =
+  "<request id=\"42\" method=\"update\">\n"
+  "  <auth user=\"someone\" token=\"0123456789abcdef\"/>\n"
+  "  <item id=\"1\" qty=\"3\">first item</item>\n"
+  "  <item id=\"2\" qty=\"1\">second item</item>\n"
+  "</request>\n";
+
+typedef struct
+{
+  scew_parser_pool *pool;
+  unsigned long documents;
+} thread_args;
+
+static void
+load_ (scew_parser *parser)
+{
+  scew_reader *reader = scew_reader_buffer_create (REQUEST, strlen (REQUEST));
+  scew_tree *tree = scew_parser_load (parser, reader);
+
+  if (NULL == tree)
+    {
+      bench_fail ("Loading document");
+    }
+
+  scew_tree_free (tree);
+  scew_reader_free (reader);
+}
+
+static void*
+thread_run_ (void *data)
+{
+  thread_args const *args = data;
+  unsigned long i = 0;
+
+  for (i = 0; i < args->documents; ++i)
+    {
+      if (args->pool != NULL)
+        {
+          scew_parser *parser = scew_parser_pool_acquire (args->pool);
+          load_ (parser);
+          scew_parser_pool_release (args->pool, parser);
+        }
+      else
+        {
+          scew_parser *parser = scew_parser_create ();
+          load_ (parser);
+          scew_parser_free (parser);
+        }
+    }
+
+  return NULL;
+}
+
+static void
+run_ (char const *what, scew_parser_pool *pool,
+      unsigned int n_threads, unsigned long documents)
+{
+  unsigned int i = 0;
+  double start = 0;
+  double elapsed = 0;
+  thread_args args;
+  pthread_t *threads = calloc (n_threads, sizeof (pthread_t));
+
+  args.pool = pool;
+  args.documents = documents;
+
+  start = bench_now ();
+  for (i = 0; i < n_threads; ++i)
+    {
+      pthread_create (&threads[i], NULL, thread_run_, &args);
+    }
+  for (i = 0; i < n_threads; ++i)
+    {
+      pthread_join (threads[i], NULL);
+    }
+  elapsed = bench_now () - start;
+
+  printf ("%-6s: %8.3f s (%10.0f documents/s)\n", what, elapsed,
+          n_threads * documents / elapsed);
+
+  free (threads);
+}
+
+int
+main (int argc, char *argv[])
+{
+  unsigned int n_threads = (argc < 2) ? 4 : strtoul (argv[1], NULL, 10);
+  unsigned long documents = (argc < 3) ? 100000 : strtoul (argv[2], NULL, 10);
+  scew_parser_pool *pool = scew_parser_pool_create ();
+
+  printf ("%u threads, %lu documents each\n", n_threads, documents);
+
+  run_ ("create", NULL, n_threads, documents);
+  run_ ("pool", pool, n_threads, documents);
+
+  scew_parser_pool_free (pool);
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,164 @@
+/**
+ * @file     bench_print.c
+ * @brief    Tree printing benchmark
+ * @author   Aleix Conchillo Flaque <aconchillo@gmail.com>
+ * @date     Sun Oct 18, 2026 10:12
+ *
+ * @if copyright
+ *
+ * Copyright (C) 2026 Aleix Conchillo Flaque
+ *
+ * SCEW is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * SCEW is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ *
+ * @endif
+ *
+ * This benchmark prints a big tree (500000 groups of elements by
+ * default) to /dev/null through file writers with different internal
+ * buffer sizes, and reports the printing throughput. It then does the
+ * same with a deeply nested tree, where indentation dominates. Each
+ * tree is also printed with one thread per processor.
+ *
+ * Usage: bench_print [n_groups]
+ */
+
+#include "bench.h"
+
+static scew_tree*
+create_tree_ (unsigned long n_groups)
+{
+  unsigned long i = 0;
+  scew_tree *tree = scew_tree_create ();
+  scew_element *root = scew_tree_set_root (tree, _XT("config"));
+
+  for (i = 0; i < n_groups; ++i)
+    {
+      scew_element *group = scew_element_add (root, _XT("group"));
+      scew_element *value = NULL;
+
+      scew_element_add_attribute_pair (group, _XT("id"), _XT("12345"));
+      scew_element_add_attribute_pair (group, _XT("enabled"), _XT("true"));
+      scew_element_add_pair (group, _XT("name"), _XT("group name"));
+      value = scew_element_add_pair (group, _XT("value"), _XT("12345"));
+      scew_element_add_attribute_pair (value, _XT("type"), _XT("int"));
+      scew_element_add_pair (group, _XT("description"),
+                             _XT("Some longer text with <markup> & entities"));
+    }
+
+  return tree;
+}
+
+static scew_tree*
+create_deep_tree_ (unsigned long n_groups)
+{
+  enum { DEPTH = 12 };
+
+  unsigned long i = 0;
+  scew_tree *tree = scew_tree_create ();
+  scew_element *root = scew_tree_set_root (tree, _XT("config"));
+
+  for (i = 0; i < n_groups / DEPTH; ++i)
+    {
+      unsigned int j = 0;
+      scew_element *element = root;
+
+      for (j = 0; j < DEPTH; ++j)
+        {
+          element = scew_element_add (element, _XT("level"));
+          scew_element_add_pair (element, _XT("id"), _XT("1"));
+        }
+    }
+
+  return tree;
+}
+
+static long
+document_size_ (scew_tree const *tree)
+{
+  long size = 0;
+  FILE *file = tmpfile ();
+  scew_writer *writer = scew_writer_fp_create (file);
+  scew_printer *printer = scew_printer_create (writer);
+
+  if (!scew_printer_print_tree (printer, tree))
+    {
+      bench_fail ("Printing tree");
+    }
+  size = ftell (file);
+
+  scew_printer_free (printer);
+  scew_writer_free (writer);
+
+  return size;
+}
+
+static void
+run_ (scew_tree const *tree, long size, size_t buffer_size,
+      unsigned int n_threads)
+{
+  double start = 0;
+  double elapsed = 0;
+  FILE *file = fopen ("/dev/null", "w");
+  scew_writer *writer = scew_writer_fp_buffered_create (file, buffer_size);
+  scew_printer *printer = scew_printer_create (writer);
+
+  scew_printer_set_threads (printer, n_threads);
+
+  start = bench_now ();
+  if (!scew_printer_print_tree (printer, tree))
+    {
+      bench_fail ("Printing tree");
+    }
+  elapsed = bench_now () - start;
+
+  printf ("buffer %6lu, %s: %8.3f s (%8.2f MB/s)\n",
+          (unsigned long) buffer_size,
+          (1 == n_threads) ? "sequential" : "parallel  ", elapsed,
+          size / (1024.0 * 1024.0) / elapsed);
+
+  scew_printer_free (printer);
+  scew_writer_free (writer);
+}
+
+int
+main (int argc, char *argv[])
+{
+  unsigned long n_groups = (argc < 2) ? 500000 : strtoul (argv[1], NULL, 10);
+  scew_tree *tree = create_tree_ (n_groups);
+  long size = document_size_ (tree);
+
+  printf ("%lu groups (%ld bytes)\n", n_groups, size);
+
+  run_ (tree, size, 0, 1);
+  run_ (tree, size, 4096, 1);
+  run_ (tree, size, 65536, 1);
+  run_ (tree, size, 65536, 0);
+
+  scew_tree_free (tree);
+
+  tree = create_deep_tree_ (n_groups);
+  size = document_size_ (tree);
+
+  printf ("%lu groups, deep (%ld bytes)\n", n_groups, size);
+
+  run_ (tree, size, 0, 1);
+  run_ (tree, size, 4096, 1);
+  run_ (tree, size, 65536, 1);
+  run_ (tree, size, 65536, 0);
+
+  scew_tree_free (tree);
+
+  return EXIT_SUCCESS;
+}
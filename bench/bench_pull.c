@@ -0,0 +1,171 @@
+/**
+ * @file     bench_pull.c
+ * @brief    SCEW pull parser benchmark
+ * @author   Aleix Conchillo Flaque <aconchillo@gmail.com>
+ * @date     Sun Oct 18, 2026 10:12
+ *
+ * @if copyright
+ *
+ * Copyright (C) 2026 Aleix Conchillo Flaque
+ *
+ * SCEW is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * SCEW is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ *
+ * @endif
+ *
+ * This benchmark sums an attribute over a big document (1M records by
+ * default) read from a file, first with the pull parser and then by
+ * loading the whole tree, and reports the time and the peak resident
+ * set size after each of them.
+ *
+ * Usage: bench_pull [records]
+ */
+
+#include "bench.h"
+
+static char const *RECORD =
+  "  <record id=\"%lu\" amount=\"%lu\"><name>customer</name>"
+  "<note>Some text that is not really needed.</note></record>\n";
+
+static unsigned long
+pull_sum_ (scew_reader *reader)
+{
+  unsigned long sum = 0;
+  scew_pull_event event = scew_pull_start_element;
+  scew_parser *parser = scew_parser_create ();
+  scew_pull *pull = scew_pull_create (parser, reader);
+
+  if (NULL == pull)
+    {
+      bench_fail ("Creating pull parser");
+    }
+
+  while ((event = scew_pull_next (pull)) != scew_pull_end_document)
+    {
+      if (scew_pull_error == event)
+        {
+          bench_fail ("Pulling events");
+        }
+      if ((scew_pull_start_element == event)
+          && (strcmp (scew_pull_name (pull), "record") == 0))
+        {
+          sum += strtoul (scew_pull_attribute_by_name (pull, "amount"),
+                          NULL, 10);
+        }
+    }
+
+  scew_pull_free (pull);
+  scew_parser_free (parser);
+
+  return sum;
+}
+
+static unsigned long
+tree_sum_ (scew_reader *reader)
+{
+  unsigned long sum = 0;
+  scew_list *list = NULL;
+  scew_tree *tree = NULL;
+  scew_parser *parser = scew_parser_create ();
+
+  tree = scew_parser_load (parser, reader);
+  if (NULL == tree)
+    {
+      bench_fail ("Loading tree");
+    }
+
+  list = scew_element_children (scew_tree_root (tree));
+  while (list != NULL)
+    {
+      scew_element *record = scew_list_data (list);
+      scew_attribute *amount =
+        scew_element_attribute_by_name (record, "amount");
+
+      sum += strtoul (scew_attribute_value (amount), NULL, 10);
+      list = scew_list_next (list);
+    }
+
+  scew_tree_free (tree);
+  scew_parser_free (parser);
+
+  return sum;
+}
+
+static void
+run_ (char const *name, unsigned long (*sum_) (scew_reader *),
+      char const *file_name, unsigned long expected)
+{
+  double start = 0;
+  double elapsed = 0;
+  unsigned long sum = 0;
+  scew_reader *reader = scew_reader_file_create (file_name);
+
+  if (NULL == reader)
+    {
+      bench_fail ("Opening document");
+    }
+
+  start = bench_now ();
+  sum = sum_ (reader);
+  elapsed = bench_now () - start;
+
+  if (sum != expected)
+    {
+      fprintf (stderr, "Sum is %lu, expected %lu\n", sum, expected);
+      exit (EXIT_FAILURE);
+    }
+
+  printf ("%-4s: %8.3f s (peak RSS %8ld KB)\n", name, elapsed,
+          bench_peak_rss ());
+
+  scew_reader_free (reader);
+}
+
+int
+main (int argc, char *argv[])
+{
+  static char const *FILE_NAME = "bench_pull.xml";
+
+  unsigned long i = 0;
+  unsigned long expected = 0;
+  FILE *file = fopen (FILE_NAME, "w");
+  unsigned long records =
+    (argc < 2) ? 1000000 : strtoul (argv[1], NULL, 10);
+
+  if (NULL == file)
+    {
+      fprintf (stderr, "Unable to create %s\n", FILE_NAME);
+      exit (EXIT_FAILURE);
+    }
+
+  fputs ("<records>\n", file);
+  for (i = 0; i < records; ++i)
+    {
+      fprintf (file, RECORD, i, i % 1000);
+      expected += i % 1000;
+    }
+  fputs ("</records>\n", file);
+  fclose (file);
+
+  printf ("Initial peak RSS %ld KB\n", bench_peak_rss ());
+
+  /* Pull parsing goes first, as peak RSS never decreases. */
+  run_ ("pull", pull_sum_, FILE_NAME, expected);
+  run_ ("tree", tree_sum_, FILE_NAME, expected);
+
+  remove (FILE_NAME);
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,174 @@
+/**
+ * @file     bench_query.c
+ * @brief    Path query benchmark
+ * @author   Aleix Conchillo Flaque <aconchillo@gmail.com>
+ * @date     Sun Oct 18, 2026 10:12
+ *
+ * @if copyright
+ *
+ * Copyright (C) 2026 Aleix Conchillo Flaque
+ *
+ * SCEW is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * SCEW is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ *
+ * @endif
+ *
+ * This benchmark creates a configuration tree with a number of
+ * servers (1000 and 100000), a third of them with role "primary", and
+ * measures the time needed to find the port of all the primary
+ * servers, either with hand-rolled loops or with a compiled query
+ * (/config/servers/server[@role='primary']/port).
+ *
+ * Usage: bench_query [runs] (default: 100)
+ */
+
+#include "bench.h"
+
+static scew_bool
+count_hook_ (scew_element *element, void *data)
+{
+  unsigned long *count = data;
+
+  *count += (scew_element_contents (element) != NULL);
+
+  return SCEW_TRUE;
+}
+
+static unsigned long
+hand_rolled_ (scew_element *root)
+{
+  unsigned long count = 0;
+  scew_list *list = NULL;
+  scew_element *servers = NULL;
+
+  if (scew_strcmp (scew_element_name (root), _XT("config")) != 0)
+    {
+      return 0;
+    }
+
+  servers = scew_element_by_name (root, _XT("servers"));
+  if (NULL == servers)
+    {
+      return 0;
+    }
+
+  for (list = scew_element_children (servers);
+       list != NULL;
+       list = scew_list_next (list))
+    {
+      scew_element *server = scew_list_data (list);
+      scew_attribute *role = NULL;
+      scew_element *port = NULL;
+
+      if (scew_strcmp (scew_element_name (server), _XT("server")) != 0)
+        {
+          continue;
+        }
+      role = scew_element_attribute_by_name (server, _XT("role"));
+      if ((NULL == role)
+          || (scew_strcmp (scew_attribute_value (role), _XT("primary")) != 0))
+        {
+          continue;
+        }
+      port = scew_element_by_name (server, _XT("port"));
+      if (port != NULL)
+        {
+          count_hook_ (port, &count);
+        }
+    }
+
+  return count;
+}
+
+static void
+run_ (unsigned long n_servers, unsigned long runs)
+{
+  enum { MAX_PORT = 32 };
+
+  unsigned long i = 0;
+  unsigned long hand_count = 0;
+  unsigned long query_count = 0;
+  double start = 0;
+  double hand_elapsed = 0;
+  double query_elapsed = 0;
+  char port[MAX_PORT];
+  scew_element *root = scew_element_create (_XT("config"));
+  scew_element *servers = scew_element_add (root, _XT("servers"));
+  scew_query *query =
+    scew_query_create (_XT("/config/servers/server[@role='primary']/port"));
+
+  if ((NULL == servers) || (NULL == query))
+    {
+      bench_fail ("Creating tree");
+    }
+
+  for (i = 0; i < n_servers; ++i)
+    {
+      scew_element *server = scew_element_add (servers, _XT("server"));
+      scew_element *child = NULL;
+
+      snprintf (port, MAX_PORT, "%lu", 1024 + i);
+      if ((NULL == server)
+          || (NULL == scew_element_add_attribute_pair
+              (server, _XT("name"), port))
+          || (NULL == scew_element_add_attribute_pair
+              (server, _XT("role"),
+               (i % 3) ? _XT("backup") : _XT("primary")))
+          || (NULL == scew_element_add (server, _XT("host")))
+          || (NULL == (child = scew_element_add (server, _XT("port"))))
+          || (NULL == scew_element_set_contents (child, port)))
+        {
+          bench_fail ("Adding server");
+        }
+    }
+
+  start = bench_now ();
+  for (i = 0; i < runs; ++i)
+    {
+      hand_count += hand_rolled_ (root);
+    }
+  hand_elapsed = bench_now () - start;
+
+  start = bench_now ();
+  for (i = 0; i < runs; ++i)
+    {
+      scew_query_run (query, root, count_hook_, &query_count);
+    }
+  query_elapsed = bench_now () - start;
+
+  if (hand_count != query_count)
+    {
+      fprintf (stderr, "Match count mismatch (%lu != %lu)\n",
+               hand_count, query_count);
+      exit (EXIT_FAILURE);
+    }
+
+  printf ("%8lu servers: hand-rolled %8.3f ms, query %8.3f ms (per run)\n",
+          n_servers, hand_elapsed * 1e3 / runs, query_elapsed * 1e3 / runs);
+
+  scew_query_free (query);
+  scew_element_free (root);
+}
+
+int
+main (int argc, char *argv[])
+{
+  unsigned long runs = (argc < 2) ? 100 : strtoul (argv[1], NULL, 10);
+
+  run_ (1000, runs);
+  run_ (100000, runs);
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,95 @@
+/**
+ * @file     bench_request.c
+ * @brief    In-memory request parsing latency benchmark
+ * @author   Aleix Conchillo Flaque <aconchillo@gmail.com>
+ * @date     Sun Oct 18, 2026 10:12
+ *
+ * @if copyright
+ *
+ * Copyright (C) 2026 Aleix Conchillo Flaque
+ *
+ * SCEW is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * SCEW is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ *
+ * @endif
+ *
+ * This benchmark repeatedly loads small in-memory documents (as
+ * typical requests would be) from buffer readers, and reports the
+ * average latency per document.
+ *
+ * Usage: bench_request [iterations] (default: 200000)
+ */
+
+#include "bench.h"
+
+static char const *REQUEST =
+  "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+  "<request id=\"42\" method=\"update\">\n"
+  "  <auth user=\"someone\" token=\"0123456789abcdef\"/>\n"
+  "  <items>\n"
+  "    <item id=\"1\" qty=\"3\">first item</item>\n"
+  "    <item id=\"2\" qty=\"1\">second item</item>\n"
+  "    <item id=\"3\" qty=\"7\">third item</item>\n"
+  "    <item id=\"4\" qty=\"2\">fourth item</item>\n"
+  "  </items>\n"
+  "  <comment>Please process this request as soon as possible, "
+  "there are more requests waiting in the queue.</comment>\n"
+  "</request>\n";
+
+static void
+run_ (scew_bool use_arena, unsigned long iterations)
+{
+  unsigned long i = 0;
+  size_t length = strlen (REQUEST);
+  double start = 0;
+  double elapsed = 0;
+  scew_parser *parser = scew_parser_create ();
+
+  scew_parser_set_arena (parser, use_arena);
+
+  start = bench_now ();
+  for (i = 0; i < iterations; ++i)
+    {
+      scew_reader *reader = scew_reader_buffer_create (REQUEST, length);
+      scew_tree *tree = scew_parser_load (parser, reader);
+
+      if (NULL == tree)
+        {
+          bench_fail ("Loading request");
+        }
+
+      scew_tree_free (tree);
+      scew_reader_free (reader);
+    }
+  elapsed = bench_now () - start;
+
+  printf ("%-5s: %lu requests (%lu bytes) in %8.3f s (%6.2f us/request)\n",
+          use_arena ? "arena" : "heap", iterations, (unsigned long) length,
+          elapsed, elapsed * 1e6 / iterations);
+
+  scew_parser_free (parser);
+}
+
+int
+main (int argc, char *argv[])
+{
+  unsigned long iterations =
+    (argc < 2) ? 200000 : strtoul (argv[1], NULL, 10);
+
+  run_ (SCEW_FALSE, iterations);
+  run_ (SCEW_TRUE, iterations);
+
+  return EXIT_SUCCESS;
+}
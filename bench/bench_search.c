@@ -0,0 +1,90 @@
+/**
+ * @file     bench_search.c
+ * @brief    Children search by name benchmark
+ * @author   Aleix Conchillo Flaque <aconchillo@gmail.com>
+ * @date     Sun Oct 18, 2026 10:12
+ *
+ * @if copyright
+ *
+ * Copyright (C) 2026 Aleix Conchillo Flaque
+ *
+ * SCEW is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * SCEW is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ *
+ * @endif
+ *
+ * This benchmark creates elements with different number of children
+ * (10, 1000 and 100000), all of them with different names, and
+ * measures the average time needed to find a child by name (via
+ * scew_element_by_name).
+ *
+ * Usage: bench_search [lookups] (default: 100000)
+ */
+
+#include "bench.h"
+
+static void
+run_ (unsigned long n_children, unsigned long lookups)
+{
+  enum { MAX_NAME = 32 };
+
+  unsigned long i = 0;
+  double start = 0;
+  double elapsed = 0;
+  char name[MAX_NAME];
+  scew_element *root = scew_element_create (_XT("root"));
+
+  for (i = 0; i < n_children; ++i)
+    {
+      snprintf (name, MAX_NAME, "child%lu", i);
+      if (NULL == scew_element_add (root, name))
+        {
+          bench_fail ("Adding child");
+        }
+    }
+
+  start = bench_now ();
+  for (i = 0; i < lookups; ++i)
+    {
+      /* Visit children in a scattered order. */
+      unsigned long child = (i * 7919) % n_children;
+      snprintf (name, MAX_NAME, "child%lu", child);
+      if (scew_element_by_name (root, name)
+          != scew_element_by_index (root, child))
+        {
+          fprintf (stderr, "Child %lu not found\n", child);
+          exit (EXIT_FAILURE);
+        }
+    }
+  elapsed = bench_now () - start;
+
+  printf ("%8lu children: %lu lookups in %8.4f s (%10.3f us/lookup)\n",
+          n_children, lookups, elapsed, elapsed * 1e6 / lookups);
+
+  scew_element_free (root);
+}
+
+int
+main (int argc, char *argv[])
+{
+  unsigned long lookups =
+    (argc < 2) ? 100000 : strtoul (argv[1], NULL, 10);
+
+  run_ (10, lookups);
+  run_ (1000, lookups);
+  run_ (100000, lookups);
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,121 @@
+/**
+ * @file     bench_stream.c
+ * @brief    Concatenated documents stream benchmark
+ * @author   Aleix Conchillo Flaque <aconchillo@gmail.com>
+ * @date     Sun Oct 18, 2026 10:12
+ *
+ * @if copyright
+ *
+ * Copyright (C) 2026 Aleix Conchillo Flaque
+ *
+ * SCEW is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * SCEW is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ *
+ * @endif
+ *
+ * This benchmark loads a stream of many small concatenated documents
+ * (1M by default, as received from a socket feed) via
+ * scew_parser_load_stream, both from an in-memory buffer and from a
+ * file, and reports the number of documents loaded per second.
+ *
+ * Usage: bench_stream [documents]
+ */
+
+#include "bench.h"
+
+static char const *DOCUMENT =
+  "<message id=\"%lu\"><from>sender</from><to>receiver</to>"
+  "<body type=\"text\">Hello, this is a short message.</body></message>\n";
+
+static scew_bool
+tree_hook_ (scew_parser *parser, void *tree, void *user_data)
+{
+  unsigned long *counter = user_data;
+
+  *counter += 1;
+
+  scew_tree_free (tree);
+
+  return SCEW_TRUE;
+}
+
+static void
+run_ (char const *name, scew_reader *reader, unsigned long documents,
+      size_t size)
+{
+  unsigned long counter = 0;
+  double start = 0;
+  double elapsed = 0;
+  scew_parser *parser = scew_parser_create ();
+
+  scew_parser_set_arena (parser, SCEW_TRUE);
+  scew_parser_set_tree_hook (parser, tree_hook_, &counter);
+
+  start = bench_now ();
+  if (!scew_parser_load_stream (parser, reader))
+    {
+      bench_fail ("Loading stream");
+    }
+  elapsed = bench_now () - start;
+
+  if (counter != documents)
+    {
+      fprintf (stderr, "Loaded %lu documents, expected %lu\n",
+               counter, documents);
+      exit (EXIT_FAILURE);
+    }
+
+  printf ("%-6s: %lu documents in %8.3f s (%10.0f docs/s, %8.2f MB/s)\n",
+          name, documents, elapsed, documents / elapsed,
+          size / (1024.0 * 1024.0) / elapsed);
+
+  scew_reader_free (reader);
+  scew_parser_free (parser);
+}
+
+int
+main (int argc, char *argv[])
+{
+  unsigned long i = 0;
+  size_t size = 0;
+  size_t capacity = 0;
+  char *stream = NULL;
+  FILE *file = NULL;
+  unsigned long documents =
+    (argc < 2) ? 1000000 : strtoul (argv[1], NULL, 10);
+
+  capacity = documents * (strlen (DOCUMENT) + 20) + 1;
+  stream = malloc (capacity);
+  file = tmpfile ();
+  if ((NULL == stream) || (NULL == file))
+    {
+      fprintf (stderr, "Unable to create stream\n");
+      exit (EXIT_FAILURE);
+    }
+
+  for (i = 0; i < documents; ++i)
+    {
+      size += sprintf (stream + size, DOCUMENT, i);
+    }
+  fwrite (stream, 1, size, file);
+  rewind (file);
+
+  run_ ("buffer", scew_reader_buffer_create (stream, size), documents, size);
+  run_ ("file", scew_reader_fp_create (file), documents, size);
+
+  free (stream);
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,142 @@
+/**
+ * @file     bench_text.c
+ * @brief    Large text node parsing benchmark
+ * @author   Aleix Conchillo Flaque <aconchillo@gmail.com>
+ * @date     Sun Oct 18, 2026 10:12
+ *
+ * @if copyright
+ *
+ * Copyright (C) 2026 Aleix Conchillo Flaque
+ *
+ * SCEW is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * SCEW is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ *
+ * @endif
+ *
+ * This benchmark loads documents with a single element containing a
+ * large base64-like text payload (split in 76 characters lines, as
+ * Expat reports each line separately). Loading time should grow
+ * linearly with the size of the text.
+ *
+ * Usage: bench_text [size_mb ...] (default: 1 10 100)
+ */
+
+#include "bench.h"
+
+static char*
+create_document_ (size_t text_size, size_t *length)
+{
+  static char const *START = "<payload>";
+  static char const *END = "</payload>";
+  static char const *ALPHABET =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+  size_t i = 0;
+  size_t pos = 0;
+  size_t total = strlen (START) + text_size + strlen (END);
+  char *document = malloc (total + 1);
+
+  if (NULL == document)
+    {
+      return NULL;
+    }
+
+  memcpy (document, START, strlen (START));
+  pos = strlen (START);
+  for (i = 0; i < text_size; ++i)
+    {
+      document[pos++] = ((i % 77) == 76) ? '\n' : ALPHABET[i % 64];
+    }
+  memcpy (document + pos, END, strlen (END));
+  pos += strlen (END);
+  document[pos] = '\0';
+
+  *length = pos;
+
+  return document;
+}
+
+static void
+run_ (size_t size_mb)
+{
+  size_t length = 0;
+  size_t text_size = size_mb * 1024 * 1024;
+  double start = 0;
+  double elapsed = 0;
+  scew_parser *parser = NULL;
+  scew_reader *reader = NULL;
+  scew_tree *tree = NULL;
+  XML_Char const *contents = NULL;
+  char *document = create_document_ (text_size, &length);
+
+  if (NULL == document)
+    {
+      fprintf (stderr, "Unable to allocate %lu MB document\n",
+               (unsigned long) size_mb);
+      exit (EXIT_FAILURE);
+    }
+
+  parser = scew_parser_create ();
+  reader = scew_reader_buffer_create (document, length);
+
+  start = bench_now ();
+  tree = scew_parser_load (parser, reader);
+  elapsed = bench_now () - start;
+
+  if (NULL == tree)
+    {
+      bench_fail ("Loading document");
+    }
+
+  contents = scew_element_contents (scew_tree_root (tree));
+  if ((NULL == contents) || (scew_strlen (contents) != text_size))
+    {
+      fprintf (stderr, "Unexpected text length\n");
+      exit (EXIT_FAILURE);
+    }
+
+  printf ("%6lu MB text node: %8.3f s (%8.2f MB/s)\n",
+          (unsigned long) size_mb, elapsed, size_mb / elapsed);
+
+  scew_tree_free (tree);
+  scew_reader_free (reader);
+  scew_parser_free (parser);
+  free (document);
+}
+
+int
+main (int argc, char *argv[])
+{
+  static size_t const DEFAULT_SIZES[] = { 1, 10, 100 };
+
+  int i = 0;
+
+  if (argc < 2)
+    {
+      for (i = 0; i < 3; ++i)
+        {
+          run_ (DEFAULT_SIZES[i]);
+        }
+    }
+  else
+    {
+      for (i = 1; i < argc; ++i)
+        {
+          run_ (strtoul (argv[i], NULL, 10));
+        }
+    }
+
+  return EXIT_SUCCESS;
+}
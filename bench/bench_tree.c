@@ -0,0 +1,124 @@
+/**
+ * @file     bench_tree.c
+ * @brief    Tree allocation benchmark
+ * @author   Aleix Conchillo Flaque <aconchillo@gmail.com>
+ * @date     Sun Oct 18, 2026 10:12
+ *
+ * @if copyright
+ *
+ * Copyright (C) 2026 Aleix Conchillo Flaque
+ *
+ * SCEW is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * SCEW is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ *
+ * @endif
+ *
+ * This benchmark loads a configuration-like document with many small
+ * elements (200000 by default) with and without the parser arena mode,
+ * and measures the time needed to load and free the tree.
+ *
+ * Usage: bench_tree [n_elements]
+ */
+
+#include "bench.h"
+
+static char*
+create_document_ (unsigned long n_elements, size_t *length)
+{
+  /* Each group has one element and three children. */
+  static char const *GROUP =
+    "  <group id=\"%lu\" enabled=\"true\">\n"
+    "    <name>group name</name>\n"
+    "    <value type=\"int\">12345</value>\n"
+    "    <option key=\"k\" value=\"v\"/>\n"
+    "  </group>\n";
+
+  unsigned long i = 0;
+  size_t pos = 0;
+  unsigned long n_groups = n_elements / 4;
+  size_t total = (n_groups + 1) * (strlen (GROUP) + 32);
+  char *document = malloc (total);
+
+  if (NULL == document)
+    {
+      return NULL;
+    }
+
+  pos += sprintf (document + pos, "<config>\n");
+  for (i = 0; i < n_groups; ++i)
+    {
+      pos += sprintf (document + pos, GROUP, i);
+    }
+  pos += sprintf (document + pos, "</config>\n");
+
+  *length = pos;
+
+  return document;
+}
+
+static void
+run_ (char const *document, size_t length, scew_bool use_arena)
+{
+  double start = 0;
+  double load = 0;
+  double release = 0;
+  scew_parser *parser = scew_parser_create ();
+  scew_reader *reader = scew_reader_buffer_create (document, length);
+  scew_tree *tree = NULL;
+
+  scew_parser_set_arena (parser, use_arena);
+
+  start = bench_now ();
+  tree = scew_parser_load (parser, reader);
+  load = bench_now () - start;
+
+  if (NULL == tree)
+    {
+      bench_fail ("Loading document");
+    }
+
+  start = bench_now ();
+  scew_tree_free (tree);
+  release = bench_now () - start;
+
+  printf ("%-6s load: %8.3f s   free: %8.3f s\n",
+          use_arena ? "arena" : "heap", load, release);
+
+  scew_reader_free (reader);
+  scew_parser_free (parser);
+}
+
+int
+main (int argc, char *argv[])
+{
+  size_t length = 0;
+  unsigned long n_elements = (argc < 2) ? 200000 : strtoul (argv[1], NULL, 10);
+  char *document = create_document_ (n_elements, &length);
+
+  if (NULL == document)
+    {
+      fprintf (stderr, "Unable to allocate document\n");
+      return EXIT_FAILURE;
+    }
+
+  printf ("%lu elements (%lu bytes)\n", n_elements, (unsigned long) length);
+
+  run_ (document, length, SCEW_FALSE);
+  run_ (document, length, SCEW_TRUE);
+
+  free (document);
+
+  return EXIT_SUCCESS;
+}
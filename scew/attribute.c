@@ -29,6 +29,8 @@
 #include "attribute.h"
 
 #include "xattribute.h"
+#include "xelement.h"
+#include "xtree.h"
 
 #include "xerror.h"
 
@@ -45,24 +47,7 @@
 scew_attribute*
 scew_attribute_create (XML_Char const *name, XML_Char const *value)
 {
-  scew_attribute *attribute = NULL;
-
-  assert (name != NULL);
-  assert (value != NULL);
-
-  attribute = calloc (1, sizeof (scew_attribute));
-
-  if (attribute != NULL)
-    {
-      attribute->name = scew_strdup(name);
-      attribute->value = scew_strdup(value);
-    }
-  else
-    {
-      scew_error_set_last_error_ (scew_error_no_memory);
-    }
-
-  return attribute;
+  return scew_attribute_arena_create_ (NULL, name, value);
 }
 
 scew_attribute*
@@ -95,9 +80,11 @@ scew_attribute_free (scew_attribute *attribute)
 {
   if (attribute != NULL)
     {
-      free (attribute->name);
-      free (attribute->value);
-      free (attribute);
+      scew_arena *arena = attribute->arena;
+
+      scew_arena_release_ (arena, attribute->name);
+      scew_arena_release_ (arena, attribute->value);
+      scew_arena_release_ (arena, attribute);
     }
 }
 
@@ -110,7 +97,7 @@ scew_attribute_compare (scew_attribute const *a, scew_attribute const *b)
   assert (a != NULL);
   assert (b != NULL);
 
-  return (scew_strcmp (a->name, b->name) == 0)
+  return ((a->name == b->name) || (scew_strcmp (a->name, b->name) == 0))
     && (scew_strcmp (a->value, b->value) == 0);
 }
 
@@ -141,11 +128,14 @@ scew_attribute_set_name (scew_attribute *attribute, XML_Char const *name)
   assert (attribute != NULL);
   assert (name != NULL);
 
-  new_name = scew_strdup (name);
+  new_name = scew_arena_intern_ (attribute->arena, name);
   if (new_name != NULL)
     {
-      free (attribute->name);
+      scew_tree_index_remove_attribute_ (attribute);
+      scew_arena_release_ (attribute->arena, attribute->name);
       attribute->name = new_name;
+      scew_element_hash_invalidate_ (attribute->parent);
+      scew_tree_index_add_attribute_ (attribute);
     }
   else
     {
@@ -163,11 +153,14 @@ scew_attribute_set_value (scew_attribute *attribute, XML_Char const *value)
   assert (attribute != NULL);
   assert (value != NULL);
 
-  new_value = scew_strdup (value);
+  new_value = scew_arena_strdup_ (attribute->arena, value);
   if (new_value != NULL)
     {
-      free (attribute->value);
+      scew_tree_index_remove_attribute_ (attribute);
+      scew_arena_release_ (attribute->arena, attribute->value);
       attribute->value = new_value;
+      scew_element_hash_invalidate_ (attribute->parent);
+      scew_tree_index_add_attribute_ (attribute);
     }
   else
     {
@@ -31,8 +31,21 @@
 #include "str.h"
 
 #include "xerror.h"
+#include "xlist.h"
+#include "xtree.h"
 
 #include <assert.h>
+#include <string.h>
+
+
+/* Private */
+
+enum
+  {
+    MIN_CHILDREN_SIZE_ = 4    /**< Initial slots for children */
+  };
+
+static scew_bool grow_children_ (scew_element *element);
 
 
 
@@ -44,22 +57,7 @@
 scew_element*
 scew_element_create (XML_Char const *name)
 {
-  scew_element *element = NULL;
-
-  assert (name != NULL);
-
-  element = calloc (1, sizeof (scew_element));
-
-  if (element != NULL)
-    {
-      scew_element_set_name (element, name);
-    }
-  else
-    {
-      scew_error_set_last_error_ (scew_error_no_memory);
-    }
-
-  return element;
+  return scew_element_arena_create_ (NULL, name);
 }
 
 void
@@ -69,11 +67,18 @@ scew_element_free (scew_element *element)
     {
       scew_element_delete_all (element);
       scew_element_delete_attribute_all (element);
+
+      /* Root elements are not detached, but still leave the index. */
+      scew_tree_index_remove_ (element->tree_index, element,
+                               SCEW_TRUE, SCEW_FALSE);
       scew_element_detach (element);
 
-      free (element->name);
-      free (element->contents);
-      free (element);
+      scew_element_index_free_ (element);
+      scew_list_arena_free_ (element->arena, element->children_list);
+      scew_arena_release_ (element->arena, element->children);
+      scew_arena_release_ (element->arena, element->name);
+      scew_arena_release_ (element->arena, element->contents);
+      scew_arena_release_ (element->arena, element);
     }
 }
 
@@ -104,11 +109,27 @@ scew_element_set_name (scew_element *element, XML_Char const *name)
   assert (element != NULL);
   assert (name != NULL);
 
-  new_name = scew_strdup (name);
+  new_name = scew_arena_intern_ (element->arena, name);
   if (new_name != NULL)
     {
-      free (element->name);
+      scew_tree_index *tree_index = element->tree_index;
+
+      /* Keep the children index of the parent up to date. */
+      if ((element->parent != NULL) && (element->name != NULL))
+        {
+          scew_element_index_remove_ (element->parent, element);
+        }
+      scew_tree_index_remove_ (tree_index, element, SCEW_TRUE, SCEW_FALSE);
+
+      scew_arena_release_ (element->arena, element->name);
       element->name = new_name;
+      scew_element_hash_invalidate_ (element);
+
+      if (element->parent != NULL)
+        {
+          scew_element_index_add_ (element->parent, element);
+        }
+      scew_tree_index_add_ (tree_index, element, SCEW_TRUE, SCEW_FALSE);
     }
   else
     {
@@ -126,11 +147,12 @@ scew_element_set_contents (scew_element *element, XML_Char const *contents)
   assert (element != NULL);
   assert (contents != NULL);
 
-  new_contents = scew_strdup (contents);
+  new_contents = scew_arena_strdup_ (element->arena, contents);
   if (new_contents != NULL)
     {
-      free (element->contents);
+      scew_arena_release_ (element->arena, element->contents);
       element->contents = new_contents;
+      scew_element_hash_invalidate_ (element);
     }
   else
     {
@@ -147,8 +169,9 @@ scew_element_free_contents (scew_element *element)
 
   if (element->contents != NULL)
     {
-      free (element->contents);
+      scew_arena_release_ (element->arena, element->contents);
       element->contents = NULL;
+      scew_element_hash_invalidate_ (element);
     }
 }
 
@@ -174,9 +197,29 @@ scew_element_parent (scew_element const *element)
 scew_list*
 scew_element_children (scew_element const *element)
 {
+  /* The list view is a cache, so it might be updated here. */
+  scew_element *view_element = (scew_element *) element;
+
   assert (element != NULL);
 
-  return element->children;
+  if (!element->children_list_valid)
+    {
+      view_element->children_list =
+        scew_list_arena_assign_ (element->arena,
+                                 element->children_list,
+                                 (void * const *) element->children,
+                                 element->n_children);
+      if ((NULL == element->children_list) && (element->n_children > 0))
+        {
+          scew_error_set_last_error_ (scew_error_no_memory);
+        }
+      else
+        {
+          view_element->children_list_valid = SCEW_TRUE;
+        }
+    }
+
+  return element->children_list;
 }
 
 scew_element*
@@ -188,7 +231,7 @@ scew_element_add (scew_element *element, XML_Char const *name)
   assert (element != NULL);
   assert (name != NULL);
 
-  new_elem = scew_element_create (name);
+  new_elem = scew_element_arena_create_ (element->arena, name);
 
   if (new_elem != NULL)
     {
@@ -221,7 +264,7 @@ scew_element_add_pair (scew_element *element,
   assert (contents != NULL);
 
   add_elem = NULL;
-  new_elem = scew_element_create (name);
+  new_elem = scew_element_arena_create_ (element->arena, name);
 
   if (new_elem != NULL)
     {
@@ -254,55 +297,63 @@ scew_element_add_pair (scew_element *element,
 scew_element*
 scew_element_add_element (scew_element *element, scew_element *child)
 {
-  scew_list *item = NULL;
-
   assert (element != NULL);
   assert (child != NULL);
   assert (scew_element_parent (child) == NULL);
 
-  item = scew_list_append (element->last_child, child);
-
-  if (item != NULL)
+  if ((element->n_children == element->children_size)
+      && !grow_children_ (element))
     {
-      if (NULL == element->children)
-        {
-          element->children = item;
-        }
-      child->parent = element;
-      child->myself = item;
-
-      element->last_child = item;
-      element->n_children += 1;
+      scew_error_set_last_error_ (scew_error_no_memory);
+      return NULL;
     }
-  else
+
+  /* Indexed root elements leave the index of their tree. */
+  scew_tree_index_remove_ (child->tree_index, child, SCEW_TRUE, SCEW_TRUE);
+
+  /* The child will need to be freed separately from the arena. */
+  if (child->arena != element->arena)
     {
-      scew_error_set_last_error_ (scew_error_no_memory);
-      child = NULL;
+      scew_arena_set_foreign_ (element->arena);
     }
 
+  child->parent = element;
+  child->index = element->n_children;
+
+  element->children[element->n_children] = child;
+  element->n_children += 1;
+  element->children_list_valid = SCEW_FALSE;
+  scew_element_hash_invalidate_ (element);
+
+  scew_element_index_add_ (element, child);
+  scew_tree_index_add_ (element->tree_index, child, SCEW_TRUE, SCEW_TRUE);
+
   return child;
 }
 
 void
 scew_element_delete_all (scew_element *element)
 {
-  scew_list *list = NULL;
+  unsigned int i = 0;
 
   assert (element != NULL);
 
-  list = element->children;
-  while (list != NULL)
+  scew_tree_index_remove_ (element->tree_index, element,
+                           SCEW_FALSE, SCEW_TRUE);
+
+  /* Detach children here, so they do not need to be moved one by one. */
+  for (i = 0; i < element->n_children; ++i)
     {
-      scew_element *aux = scew_list_data (list);
-      list = scew_list_next (list);
-      scew_element_free (aux);
+      scew_element *child = element->children[i];
+      child->parent = NULL;
+      scew_element_free (child);
     }
 
-  /* Do not free element->children as childs are already detached. */
-
-  element->children = NULL;
-  element->last_child = NULL;
   element->n_children = 0;
+  element->children_list_valid = SCEW_FALSE;
+  scew_element_hash_invalidate_ (element);
+
+  scew_element_index_free_ (element);
 }
 
 void
@@ -351,22 +402,85 @@ scew_element_detach (scew_element *element)
 
   if (parent != NULL)
     {
-      if (parent->last_child == element->myself)
+      unsigned int i = 0;
+
+      scew_element_index_remove_ (parent, element);
+      scew_tree_index_remove_ (element->tree_index, element,
+                               SCEW_TRUE, SCEW_TRUE);
+
+      /* Move the following siblings one position back. */
+      for (i = element->index + 1; i < parent->n_children; ++i)
         {
-          parent->last_child = scew_list_previous (element->myself);
+          parent->children[i - 1] = parent->children[i];
+          parent->children[i - 1]->index = i - 1;
         }
 
-      parent->children = scew_list_delete_item (parent->children,
-                                                element->myself);
+      parent->n_children -= 1;
+      parent->children_list_valid = SCEW_FALSE;
+      scew_element_hash_invalidate_ (parent);
+
+      element->parent = NULL;
+      element->index = 0;
+    }
+}
+
+
+
+/* Protected */
+
+scew_element*
+scew_element_arena_create_ (scew_arena *arena, XML_Char const *name)
+{
+  scew_element *element = NULL;
+
+  assert (name != NULL);
 
-      --parent->n_children;
-      if (0 == parent->n_children)
+  element = scew_arena_alloc_ (arena, sizeof (scew_element));
+
+  if (element != NULL)
+    {
+      element->arena = arena;
+      if (NULL == scew_element_set_name (element, name))
         {
-          parent->children = NULL;
-          parent->last_child = NULL;
+          scew_arena_release_ (arena, element);
+          element = NULL;
         }
+    }
+  else
+    {
+      scew_error_set_last_error_ (scew_error_no_memory);
+    }
 
-      element->parent = NULL;
-      element->myself = NULL;
+  return element;
+}
+
+
+/* Private */
+
+scew_bool
+grow_children_ (scew_element *element)
+{
+  scew_element **children = NULL;
+  unsigned int size = (0 == element->children_size)
+    ? MIN_CHILDREN_SIZE_
+    : 2 * element->children_size;
+
+  children = scew_arena_alloc_ (element->arena,
+                                size * sizeof (scew_element *));
+  if (NULL == children)
+    {
+      return SCEW_FALSE;
     }
+
+  if (element->n_children > 0)
+    {
+      memcpy (children, element->children,
+              element->n_children * sizeof (scew_element *));
+    }
+  scew_arena_release_ (element->arena, element->children);
+
+  element->children = children;
+  element->children_size = size;
+
+  return SCEW_TRUE;
 }
@@ -40,6 +40,7 @@
 
 #include "export.h"
 
+#include "hash.h"
 #include "list.h"
 
 #include <expat.h>
@@ -95,6 +96,28 @@ typedef scew_bool (*scew_element_cmp_hook) (scew_element const *,
  */
 extern SCEW_API scew_element* scew_element_create (XML_Char const *name);
 
+/**
+ * Creates a new element with the given @a name and attributes. The
+ * attributes are given in @a attrs as a NULL terminated array of
+ * name and value pairs (i.e. name, value, name, value, ..., NULL), as
+ * Expat reports them.
+ *
+ * This is faster than creating the element and adding its attributes
+ * one by one (see #scew_element_add_attribute_pair), as attribute
+ * names are not checked for duplicates.
+ *
+ * @pre name != NULL
+ * @pre attrs != NULL
+ * @pre attribute names in @a attrs are unique
+ *
+ * @return the created element, or NULL if an error is found.
+ *
+ * @ingroup SCEWElementAlloc
+ */
+extern SCEW_API scew_element*
+scew_element_create_with_attributes (XML_Char const *name,
+                                     XML_Char const **attrs);
+
 /**
  * Makes a deep copy of the given @a element. Attributes and children
  * elements will be copied. The new element will not belong to any XML
@@ -129,6 +152,12 @@ extern SCEW_API void scew_element_free (scew_element *element);
  * Returns the first child from the specified @a element that matches
  * the given @a name. Remember that XML names are case-sensitive.
  *
+ * Elements with many children keep an index of their children by
+ * name, which is updated as children are added, so searching them
+ * does not depend on the number of children. Searching does not
+ * modify @a element, so it might be done from different threads at
+ * the same time (as long as no thread modifies @a element).
+ *
  * @pre element != NULL
  * @pre name != NULL
  *
@@ -142,7 +171,8 @@ scew_element_by_name (scew_element const *element, XML_Char const *name);
 
 /**
  * Returns the child of the given @a element at the specified
- * zero-based @a index.
+ * zero-based @a index. Children are stored in an array, so this takes
+ * constant time and is the preferred way to iterate over children.
  *
  * @pre element != NULL
  * @pre index < #scew_element_count
@@ -159,7 +189,8 @@ scew_element_by_index (scew_element const *element, unsigned int index);
  * Returns a list of children from the specified @a element that
  * matches the given @a name. This list must be freed after using it
  * via #scew_list_free (the elements will not be freed, only the list
- * pointing to them).
+ * pointing to them). As with #scew_element_by_name, searching does
+ * not modify @a element.
  *
  * @pre element != NULL
  * @pre name != NULL
@@ -197,6 +228,12 @@ scew_element_list_by_name (scew_element const *element, XML_Char const *name);
  * thus the user is responsible to define how the comparison is to be
  * done.
  *
+ * With the default comparison, elements whose structural hashes have
+ * already been computed (see #scew_element_hash) are compared by
+ * their hashes, without traversing their children. Elements with
+ * different hashes are never equal. Elements with equal hashes are
+ * considered equal, as collisions of 64-bit hashes are very unlikely.
+ *
  * @pre a != NULL
  * @pre b != NULL
  *
@@ -214,6 +251,33 @@ extern SCEW_API scew_bool scew_element_compare (scew_element const *a,
                                                 scew_element const *b,
                                                 scew_element_cmp_hook hook);
 
+/**
+ * Returns the structural hash of the given @a element. The hash is
+ * computed, Merkle-style, from the element's name, contents and
+ * attributes (in order) and the hashes of its children (in order), so
+ * elements considered equal by the default #scew_element_compare have
+ * the same hash. Hashes do not depend on the platform word size, so
+ * they might be used as cache keys.
+ *
+ * Hashes are computed the first time they are needed and kept until
+ * the element or any of its descendants is modified, so calling this
+ * function again is O(1). Computing the hash of an element computes
+ * the hashes of all its descendants.
+ *
+ * Note that computing hashes modifies the given elements, so this
+ * function must not be called from different threads on the same
+ * tree at the same time.
+ *
+ * @pre element != NULL
+ *
+ * @param element the element to obtain the hash for.
+ *
+ * @return the structural hash of @a element.
+ *
+ * @ingroup SCEWElementCompare
+ */
+extern SCEW_API scew_hash scew_element_hash (scew_element const *element);
+
 
 /**
  * @defgroup SCEWElementAcc Accessors
@@ -321,10 +385,25 @@ extern SCEW_API scew_element*
 scew_element_parent (scew_element const *element);
 
 /**
- * Returns the list of all the @a element's children. This is the
- * internal list where @a element's children are stored, so no
+ * Returns the list of all the @a element's children. Children are
+ * internally stored in an array (see #scew_element_by_index), and
+ * this list is a view of it owned by the @a element, so no
  * modifications or deletions should be performed on this list.
  *
+ * The list is created the first time this function is called and it
+ * is updated in later calls if children have been added or
+ * removed. Items of the previous list are reused or freed when it
+ * is updated, so a list returned before becomes invalid once this
+ * function is called again after the children changed. Lists must
+ * not be kept while the element children are being modified; call
+ * this function again to get an up-to-date list instead.
+ *
+ * Note that updating the list modifies the given @a element, so this
+ * function must not be called from different threads on the same
+ * element at the same time. Concurrent readers might use
+ * #scew_element_count and #scew_element_by_index instead, which do
+ * not modify the element.
+ *
  * @pre element != NULL
  *
  * @return the list of the given @a element's children, or NULL if the
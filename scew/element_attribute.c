@@ -32,6 +32,8 @@
 
 #include "xattribute.h"
 #include "xerror.h"
+#include "xlist.h"
+#include "xtree.h"
 
 #include <assert.h>
 
@@ -51,6 +53,13 @@ static scew_attribute* update_attribute_ (scew_element *element,
 
 /* Public */
 
+scew_element*
+scew_element_create_with_attributes (XML_Char const *name,
+                                     XML_Char const **attrs)
+{
+  return scew_element_arena_create_with_attributes_ (NULL, name, attrs);
+}
+
 unsigned int
 scew_element_attribute_count (scew_element const *element)
 {
@@ -149,7 +158,8 @@ scew_element_add_attribute_pair (scew_element *element,
        * If the attribute does not exist, create a new one and try to
        * add it.
        */
-      scew_attribute *attribute = scew_attribute_create (name, value);
+      scew_attribute *attribute =
+        scew_attribute_arena_create_ (element->arena, name, value);
 
       if (attribute != NULL)
         {
@@ -175,13 +185,30 @@ void
 scew_element_delete_attribute (scew_element *element,
                                scew_attribute *attribute)
 {
+  scew_list *item = NULL;
+
   assert (element != NULL);
   assert (attribute != NULL);
 
-  element->attributes = scew_list_delete (element->attributes, attribute);
-  element->n_attributes -= 1;
+  item = scew_list_find (element->attributes, attribute);
+
+  if (item != NULL)
+    {
+      scew_tree_index_remove_attribute_ (attribute);
+
+      if (element->last_attribute == item)
+        {
+          element->last_attribute = scew_list_previous (item);
+        }
+
+      element->attributes = scew_list_arena_delete_item_ (element->arena,
+                                                          element->attributes,
+                                                          item);
+      element->n_attributes -= 1;
+      scew_element_hash_invalidate_ (element);
 
-  scew_attribute_free (attribute);
+      scew_attribute_free (attribute);
+    }
 }
 
 void
@@ -197,13 +224,15 @@ scew_element_delete_attribute_all (scew_element *element)
     {
       scew_attribute *aux = scew_list_data (list);
       list = scew_list_next (list);
+      scew_tree_index_remove_attribute_ (aux);
       scew_attribute_free (aux);
     }
-  scew_list_free (element->attributes);
+  scew_list_arena_free_ (element->arena, element->attributes);
 
   element->attributes = NULL;
   element->last_attribute = NULL;
   element->n_attributes = 0;
+  scew_element_hash_invalidate_ (element);
 }
 
 void
@@ -245,14 +274,55 @@ scew_element_delete_attribute_by_index (scew_element *element,
     }
 }
 
+
+/* Protected */
+
+scew_element*
+scew_element_arena_create_with_attributes_ (scew_arena *arena,
+                                            XML_Char const *name,
+                                            XML_Char const **attrs)
+{
+  unsigned int i = 0;
+  scew_element *element = NULL;
+
+  assert (name != NULL);
+  assert (attrs != NULL);
+
+  element = scew_element_arena_create_ (arena, name);
+
+  /**
+   * Attribute names are known to be unique, so attributes are
+   * directly appended without looking for existent ones.
+   */
+  for (i = 0; (element != NULL) && (attrs[i] != NULL); i += 2)
+    {
+      scew_attribute *attribute =
+        scew_attribute_arena_create_ (arena, attrs[i], attrs[i + 1]);
+
+      if ((NULL == attribute)
+          || (NULL == add_new_attribute_ (element, attribute)))
+        {
+          scew_attribute_free (attribute);
+          scew_element_free (element);
+          element = NULL;
+        }
+    }
+
+  return element;
+}
+
 
 /* Private */
 
 scew_bool
 cmp_attr_name_ (void const *attribute, void const *name)
 {
-  return (scew_strcmp (scew_attribute_name ((scew_attribute *) attribute),
-                       (XML_Char *) name) == 0);
+  XML_Char const *attr_name =
+    scew_attribute_name ((scew_attribute const *) attribute);
+
+  /* Names interned in the same arena can be compared by pointer. */
+  return ((attr_name == name)
+          || (scew_strcmp (attr_name, (XML_Char *) name) == 0));
 }
 
 scew_attribute*
@@ -264,10 +334,18 @@ add_new_attribute_ (scew_element *element, scew_attribute *attribute)
   assert (element != NULL);
   assert (attribute != NULL);
 
-  item = scew_list_append (element->last_attribute, attribute);
+  item = scew_list_arena_append_ (element->arena,
+                                  element->last_attribute,
+                                  attribute);
 
   if (item != NULL)
     {
+      /* The attribute will need to be freed separately from the arena. */
+      if (attribute->arena != element->arena)
+        {
+          scew_arena_set_foreign_ (element->arena);
+        }
+
       /* Initialise attributes list. */
       if (NULL == element->attributes)
         {
@@ -279,6 +357,8 @@ add_new_attribute_ (scew_element *element, scew_attribute *attribute)
       /* Update performance variables. */
       element->last_attribute = item;
       element->n_attributes += 1;
+      scew_element_hash_invalidate_ (element);
+      scew_tree_index_add_attribute_ (attribute);
 
       /* Update the return value. */
       new_attribute = attribute;
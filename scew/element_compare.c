@@ -61,6 +61,12 @@ scew_element_compare (scew_element const *a,
 
   cmp_hook = (NULL == hook) ? compare_element_ : hook;
 
+  /* Hashes summarize the default comparison of the whole subtrees. */
+  if ((compare_element_ == cmp_hook) && a->hash_valid && b->hash_valid)
+    {
+      return (a->hash == b->hash);
+    }
+
   return (cmp_hook (a, b) && compare_children_ (a, b, cmp_hook));
 }
 
@@ -75,7 +81,7 @@ compare_element_ (scew_element const *a, scew_element const *b)
   assert (a != NULL);
   assert (b != NULL);
 
-  equal = (scew_strcmp (a->name, b->name) == 0)
+  equal = ((a->name == b->name) || (scew_strcmp (a->name, b->name) == 0))
     && (scew_strcmp (a->contents, b->contents) == 0)
     && compare_attributes_ (a, b);
 
@@ -114,23 +120,16 @@ compare_children_ (scew_element const *a,
                    scew_element_cmp_hook hook)
 {
   scew_bool equal = SCEW_TRUE;
-  scew_list *list_a = NULL;
-  scew_list *list_b = NULL;
+  unsigned int i = 0;
 
   assert (a != NULL);
   assert (b != NULL);
 
   equal = (a->n_children == b->n_children);
 
-  list_a = a->children;
-  list_b = b->children;
-  while (equal && (list_a != NULL) && (list_b != NULL))
+  for (i = 0; equal && (i < a->n_children); ++i)
     {
-      scew_element *child_a = scew_list_data (list_a);
-      scew_element *child_b = scew_list_data (list_b);
-      equal = scew_element_compare (child_a, child_b, hook);
-      list_a = scew_list_next (list_a);
-      list_b = scew_list_next (list_b);
+      equal = scew_element_compare (a->children[i], b->children[i], hook);
     }
 
   return equal;
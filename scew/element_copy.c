@@ -28,9 +28,17 @@
 
 #include "xelement.h"
 
+#include "xattribute.h"
+#include "xerror.h"
+#include "xlist.h"
+#include "xthread.h"
+
 #include "attribute.h"
+#include "str.h"
 
 #include <assert.h>
+#include <stdlib.h>
+#include <string.h>
 
 
 
@@ -41,6 +49,87 @@ static scew_bool copy_children_ (scew_element *new_element,
 static scew_bool copy_attributes_ (scew_element *new_element,
                                    scew_element const *element);
 
+enum
+  {
+    ALIGNMENT_ = 8,             /**< Alignment of copied objects */
+    TASKS_PER_THREAD_ = 16      /**< Pieces the copy is split in, per
+                                   thread */
+  };
+
+#define ALIGN_(size)                                                    \
+  (((size) + ALIGNMENT_ - 1) & ~((size_t) ALIGNMENT_ - 1))
+
+/**
+ * An element copied by the calling thread before the parallel copy
+ * starts. Only the element itself is copied, its children are copied
+ * by tasks or are also top elements.
+ */
+typedef struct
+{
+  scew_element const *element;  /**< Element to copy */
+  unsigned int parent;          /**< Top element of the parent */
+  unsigned int index;           /**< Position in parent's children */
+  scew_element *copy;           /**< The new element */
+} copy_top_;
+
+/**
+ * A range of siblings deeply copied by a single thread into its own
+ * part of the copy memory block.
+ */
+typedef struct
+{
+  unsigned int parent;          /**< Top element of the siblings' parent */
+  unsigned int first;           /**< First sibling to copy */
+  unsigned int count;           /**< Number of siblings to copy */
+  size_t size;                  /**< Memory needed by the copy */
+  char *memory;                 /**< Memory for the copy */
+} copy_task_;
+
+typedef struct
+{
+  scew_arena *arena;            /**< Arena of the new elements */
+  copy_top_ *tops;              /**< Elements copied first */
+  unsigned int n_tops;          /**< Number of top elements */
+  unsigned int tops_size;       /**< Allocated top elements */
+  copy_task_ *tasks;            /**< Ranges copied in parallel */
+  unsigned int n_tasks;         /**< Number of tasks */
+  unsigned int tasks_size;      /**< Allocated tasks */
+  size_t volatile next;         /**< Next task to process */
+  scew_bool sizing;             /**< Whether tasks are sized or copied */
+} copy_job_;
+
+static scew_bool split_copy_ (copy_job_ *job,
+                              scew_element const *element,
+                              unsigned int n_pieces);
+static scew_bool add_top_ (copy_job_ *job,
+                           scew_element const *element,
+                           unsigned int parent,
+                           unsigned int index);
+static scew_bool add_task_ (copy_job_ *job,
+                            unsigned int parent,
+                            unsigned int first,
+                            unsigned int count);
+static void copy_worker_ (void *data);
+
+static size_t string_size_ (XML_Char const *string);
+static size_t node_size_ (scew_element const *element);
+static size_t element_size_ (scew_element const *element);
+
+static void* take_ (char **memory, size_t size);
+static XML_Char* copy_string_ (char **memory, XML_Char const *string);
+static scew_element* copy_node_ (char **memory,
+                                 scew_arena *arena,
+                                 scew_element const *element,
+                                 scew_element *parent,
+                                 unsigned int index);
+static scew_element* copy_element_ (char **memory,
+                                    scew_arena *arena,
+                                    scew_element const *element,
+                                    scew_element *parent,
+                                    unsigned int index);
+
+static void build_indexes_ (scew_element *element);
+
 
 
 /* Public */
@@ -76,6 +165,92 @@ scew_element_copy (scew_element const *element)
 }
 
 
+
+/* Protected */
+
+scew_element*
+scew_element_arena_copy_ (scew_arena *arena,
+                          scew_element const *element,
+                          unsigned int n_threads)
+{
+  copy_job_ job;
+  scew_bool result = SCEW_TRUE;
+  scew_element *new_elem = NULL;
+  unsigned int i = 0;
+  size_t size = 0;
+  char *memory = NULL;
+
+  assert (arena != NULL);
+  assert (element != NULL);
+  assert (n_threads > 0);
+
+  memset (&job, 0, sizeof (job));
+  job.arena = arena;
+
+  result = split_copy_ (&job, element, TASKS_PER_THREAD_ * n_threads);
+
+  if (result)
+    {
+      /* Size tasks in parallel, top elements are only a few. */
+      job.sizing = SCEW_TRUE;
+      scew_thread_run_ (n_threads, copy_worker_, &job);
+
+      for (i = 0; i < job.n_tops; ++i)
+        {
+          size += node_size_ (job.tops[i].element);
+        }
+      for (i = 0; i < job.n_tasks; ++i)
+        {
+          size += job.tasks[i].size;
+        }
+
+      /* The whole copy lives in a single (zero-initialized) block. */
+      memory = scew_arena_alloc_ (arena, size);
+      result = (memory != NULL);
+    }
+
+  if (result)
+    {
+      /* Parents are always copied before their children. */
+      for (i = 0; i < job.n_tops; ++i)
+        {
+          copy_top_ *top = &job.tops[i];
+          scew_element *parent =
+            (0 == i) ? NULL : job.tops[top->parent].copy;
+
+          top->copy = copy_node_ (&memory, arena, top->element, parent,
+                                  top->index);
+          if (parent != NULL)
+            {
+              parent->children[top->index] = top->copy;
+            }
+        }
+      for (i = 0; i < job.n_tasks; ++i)
+        {
+          job.tasks[i].memory = memory;
+          memory += job.tasks[i].size;
+        }
+
+      job.next = 0;
+      job.sizing = SCEW_FALSE;
+      scew_thread_run_ (n_threads, copy_worker_, &job);
+
+      new_elem = job.tops[0].copy;
+      build_indexes_ (new_elem);
+    }
+
+  if (!result)
+    {
+      scew_error_set_last_error_ (scew_error_no_memory);
+    }
+
+  free (job.tops);
+  free (job.tasks);
+
+  return new_elem;
+}
+
+
 
 /* Private */
 
@@ -83,20 +258,17 @@ scew_bool
 copy_children_ (scew_element *new_element, scew_element const *element)
 {
   scew_bool copied = SCEW_TRUE;
-  scew_list *list = NULL;
+  unsigned int i = 0;
 
   assert (new_element != NULL);
   assert (element != NULL);
 
-  list = element->children;
-  while (copied && (list != NULL))
+  for (i = 0; copied && (i < element->n_children); ++i)
     {
-      scew_element *child = scew_list_data (list);
-      scew_element *new_child = scew_element_copy (child);
+      scew_element *new_child = scew_element_copy (element->children[i]);
       copied =
         ((new_child != NULL)
          && (scew_element_add_element (new_element, new_child) != NULL));
-      list = scew_list_next (list);
     }
 
   return copied;
@@ -124,3 +296,301 @@ copy_attributes_ (scew_element *new_element, scew_element const *element)
 
   return copied;
 }
+
+scew_bool
+split_copy_ (copy_job_ *job, scew_element const *element,
+             unsigned int n_pieces)
+{
+  unsigned int i = 0;
+
+  if (!add_top_ (job, element, 0, 0))
+    {
+      return SCEW_FALSE;
+    }
+
+  /**
+   * Expand top elements breadth-first, until there are enough pieces
+   * to keep all threads busy. Elements with many children have their
+   * children split in ranges instead.
+   */
+  for (i = 0; i < job->n_tops; ++i)
+    {
+      scew_element const *top = job->tops[i].element;
+      unsigned int step = (top->n_children + n_pieces - 1) / n_pieces;
+      unsigned int first = 0;
+
+      for (first = 0; first < top->n_children; first += step)
+        {
+          unsigned int count = top->n_children - first;
+          scew_element const *child = top->children[first];
+          scew_bool added = SCEW_FALSE;
+
+          count = (count < step) ? count : step;
+          if ((1 == count) && (child->n_children > 0)
+              && (job->n_tasks + job->n_tops - i < n_pieces))
+            {
+              added = add_top_ (job, child, i, first);
+            }
+          else
+            {
+              added = add_task_ (job, i, first, count);
+            }
+
+          if (!added)
+            {
+              return SCEW_FALSE;
+            }
+        }
+    }
+
+  return SCEW_TRUE;
+}
+
+scew_bool
+add_top_ (copy_job_ *job, scew_element const *element, unsigned int parent,
+          unsigned int index)
+{
+  if (job->n_tops == job->tops_size)
+    {
+      unsigned int size = (0 == job->tops_size) ? 16 : 2 * job->tops_size;
+      copy_top_ *tops = realloc (job->tops, size * sizeof (copy_top_));
+      if (NULL == tops)
+        {
+          return SCEW_FALSE;
+        }
+      job->tops = tops;
+      job->tops_size = size;
+    }
+
+  job->tops[job->n_tops].element = element;
+  job->tops[job->n_tops].parent = parent;
+  job->tops[job->n_tops].index = index;
+  job->tops[job->n_tops].copy = NULL;
+  job->n_tops += 1;
+
+  return SCEW_TRUE;
+}
+
+scew_bool
+add_task_ (copy_job_ *job, unsigned int parent, unsigned int first,
+           unsigned int count)
+{
+  if (job->n_tasks == job->tasks_size)
+    {
+      unsigned int size = (0 == job->tasks_size) ? 16 : 2 * job->tasks_size;
+      copy_task_ *tasks = realloc (job->tasks, size * sizeof (copy_task_));
+      if (NULL == tasks)
+        {
+          return SCEW_FALSE;
+        }
+      job->tasks = tasks;
+      job->tasks_size = size;
+    }
+
+  job->tasks[job->n_tasks].parent = parent;
+  job->tasks[job->n_tasks].first = first;
+  job->tasks[job->n_tasks].count = count;
+  job->tasks[job->n_tasks].size = 0;
+  job->tasks[job->n_tasks].memory = NULL;
+  job->n_tasks += 1;
+
+  return SCEW_TRUE;
+}
+
+void
+copy_worker_ (void *data)
+{
+  copy_job_ *job = data;
+  size_t index = 0;
+
+  while ((index = scew_atomic_next_ (&job->next)) < job->n_tasks)
+    {
+      copy_task_ *task = &job->tasks[index];
+      scew_element const *element = job->tops[task->parent].element;
+      scew_element *parent = job->tops[task->parent].copy;
+      unsigned int i = 0;
+
+      for (i = task->first; i < task->first + task->count; ++i)
+        {
+          if (job->sizing)
+            {
+              task->size += element_size_ (element->children[i]);
+            }
+          else
+            {
+              parent->children[i] =
+                copy_element_ (&task->memory, job->arena,
+                               element->children[i], parent, i);
+            }
+        }
+    }
+}
+
+size_t
+string_size_ (XML_Char const *string)
+{
+  return (NULL == string)
+    ? 0
+    : ALIGN_ ((scew_strlen (string) + 1) * sizeof (XML_Char));
+}
+
+size_t
+node_size_ (scew_element const *element)
+{
+  size_t size = ALIGN_ (sizeof (scew_element))
+    + string_size_ (element->name)
+    + string_size_ (element->contents)
+    + ALIGN_ (element->n_children * sizeof (scew_element *));
+  scew_list const *list = element->attributes;
+
+  while (list != NULL)
+    {
+      scew_attribute const *attribute = list->data;
+      size += ALIGN_ (sizeof (scew_attribute))
+        + ALIGN_ (sizeof (scew_list))
+        + string_size_ (attribute->name)
+        + string_size_ (attribute->value);
+      list = list->next;
+    }
+
+  return size;
+}
+
+size_t
+element_size_ (scew_element const *element)
+{
+  size_t size = node_size_ (element);
+  unsigned int i = 0;
+
+  for (i = 0; i < element->n_children; ++i)
+    {
+      size += element_size_ (element->children[i]);
+    }
+
+  return size;
+}
+
+void*
+take_ (char **memory, size_t size)
+{
+  void *ptr = *memory;
+
+  *memory += ALIGN_ (size);
+
+  return ptr;
+}
+
+XML_Char*
+copy_string_ (char **memory, XML_Char const *string)
+{
+  XML_Char *new_string = NULL;
+
+  if (string != NULL)
+    {
+      size_t length = scew_strlen (string) + 1;
+      new_string = take_ (memory, length * sizeof (XML_Char));
+      scew_memcpy (new_string, string, length);
+    }
+
+  return new_string;
+}
+
+scew_element*
+copy_node_ (char **memory, scew_arena *arena, scew_element const *element,
+            scew_element *parent, unsigned int index)
+{
+  scew_element *new_elem = take_ (memory, sizeof (scew_element));
+  scew_list const *list = element->attributes;
+  scew_list *last = NULL;
+
+  /* Memory is zero-initialized, so only non-zero fields are set. */
+  new_elem->name = copy_string_ (memory, element->name);
+  new_elem->contents = copy_string_ (memory, element->contents);
+  new_elem->parent = parent;
+  new_elem->index = index;
+  new_elem->arena = arena;
+  new_elem->hash = element->hash;
+  new_elem->hash_valid = element->hash_valid;
+
+  if (element->n_children > 0)
+    {
+      new_elem->children =
+        take_ (memory, element->n_children * sizeof (scew_element *));
+      new_elem->n_children = element->n_children;
+      new_elem->children_size = element->n_children;
+    }
+
+  while (list != NULL)
+    {
+      scew_attribute const *attribute = list->data;
+      scew_attribute *new_attr = take_ (memory, sizeof (scew_attribute));
+      scew_list *item = take_ (memory, sizeof (scew_list));
+
+      new_attr->name = copy_string_ (memory, attribute->name);
+      new_attr->value = copy_string_ (memory, attribute->value);
+      new_attr->parent = new_elem;
+      new_attr->arena = arena;
+
+      item->data = new_attr;
+      item->prev = last;
+      if (NULL == last)
+        {
+          new_elem->attributes = item;
+        }
+      else
+        {
+          last->next = item;
+        }
+      last = item;
+
+      list = list->next;
+    }
+  new_elem->last_attribute = last;
+  new_elem->n_attributes = element->n_attributes;
+
+  return new_elem;
+}
+
+scew_element*
+copy_element_ (char **memory, scew_arena *arena, scew_element const *element,
+               scew_element *parent, unsigned int index)
+{
+  scew_element *new_elem = copy_node_ (memory, arena, element, parent, index);
+  unsigned int i = 0;
+
+  for (i = 0; i < element->n_children; ++i)
+    {
+      new_elem->children[i] =
+        copy_element_ (memory, arena, element->children[i], new_elem, i);
+    }
+
+  return new_elem;
+}
+
+void
+build_indexes_ (scew_element *element)
+{
+  /* Children arrays are filled directly, so indexes are built here
+     (walking the copy without recursion, as it might be deep). */
+  scew_element *current = element;
+
+  while (current != NULL)
+    {
+      scew_element_index_build_ (current);
+
+      if (current->n_children > 0)
+        {
+          current = current->children[0];
+          continue;
+        }
+
+      while ((current != element)
+             && (current->index + 1 >= current->parent->n_children))
+        {
+          current = current->parent;
+        }
+      current = (current == element)
+        ? NULL
+        : current->parent->children[current->index + 1];
+    }
+}
@@ -0,0 +1,167 @@
+/**
+ * @file     element_hash.c
+ * @brief    element.h implementation
+ * @author   Aleix Conchillo Flaque <aconchillo@gmail.com>
+ * @date     Sun Oct 18, 2026 10:12
+ *
+ * @if copyright
+ *
+ * Copyright (C) 2026 Aleix Conchillo Flaque
+ *
+ * SCEW is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * SCEW is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ *
+ * @endif
+ */
+
+#include "xelement.h"
+
+#include "xattribute.h"
+#include "xlist.h"
+
+#include "str.h"
+
+#include <assert.h>
+
+
+/* Private */
+
+#define HASH_CONSTANT_(high, low)                               \
+  (((scew_hash) (high) << 32) | (scew_hash) (low))
+
+/* FNV-1a offset basis and prime. */
+#define HASH_SEED_  HASH_CONSTANT_ (0xcbf29ce4UL, 0x84222325UL)
+#define HASH_PRIME_ HASH_CONSTANT_ (0x00000100UL, 0x000001b3UL)
+
+/* Markers are out of the range of characters. */
+#define HASH_END_   0x110000UL
+#define HASH_NULL_  0x110001UL
+
+#ifdef XML_UNICODE_WCHAR_T
+#define CHAR_VALUE_(c) ((scew_hash) (c))
+#else
+#define CHAR_VALUE_(c) ((scew_hash) (unsigned char) (c))
+#endif /* XML_UNICODE_WCHAR_T */
+
+static scew_hash compute_hash_ (scew_element *element);
+static scew_hash hash_string_ (scew_hash hash, XML_Char const *string);
+static scew_hash hash_value_ (scew_hash hash, scew_hash value);
+static scew_hash finalize_ (scew_hash hash);
+
+
+/* Public */
+
+scew_hash
+scew_element_hash (scew_element const *element)
+{
+  assert (element != NULL);
+
+  /* Hashes are a cache, so they might be computed on const elements. */
+  return compute_hash_ ((scew_element *) element);
+}
+
+
+/* Protected */
+
+void
+scew_element_hash_invalidate_ (scew_element *element)
+{
+  /**
+   * Elements with a valid hash have all their descendants hashed, so
+   * once an invalid element is found, its ancestors are also invalid.
+   */
+  while ((element != NULL) && element->hash_valid)
+    {
+      element->hash_valid = SCEW_FALSE;
+      element = element->parent;
+    }
+}
+
+
+/* Private */
+
+scew_hash
+compute_hash_ (scew_element *element)
+{
+  scew_hash hash = HASH_SEED_;
+  scew_list const *list = NULL;
+  unsigned int i = 0;
+
+  if (element->hash_valid)
+    {
+      return element->hash;
+    }
+
+  hash = hash_string_ (hash, element->name);
+  hash = hash_string_ (hash, element->contents);
+
+  hash = hash_value_ (hash, element->n_attributes);
+  for (list = element->attributes; list != NULL; list = list->next)
+    {
+      scew_attribute const *attribute = list->data;
+      hash = hash_string_ (hash, attribute->name);
+      hash = hash_string_ (hash, attribute->value);
+    }
+
+  hash = hash_value_ (hash, element->n_children);
+  for (i = 0; i < element->n_children; ++i)
+    {
+      hash = hash_value_ (hash, compute_hash_ (element->children[i]));
+    }
+
+  element->hash = finalize_ (hash);
+  element->hash_valid = SCEW_TRUE;
+
+  return element->hash;
+}
+
+scew_hash
+hash_string_ (scew_hash hash, XML_Char const *string)
+{
+  if (NULL == string)
+    {
+      return (hash ^ HASH_NULL_) * HASH_PRIME_;
+    }
+
+  while (*string != _XT('\0'))
+    {
+      hash = (hash ^ CHAR_VALUE_ (*string)) * HASH_PRIME_;
+      ++string;
+    }
+
+  return (hash ^ HASH_END_) * HASH_PRIME_;
+}
+
+scew_hash
+hash_value_ (scew_hash hash, scew_hash value)
+{
+  /* Multiplication only moves bits up, so fold high bits back. */
+  hash = (hash ^ value) * HASH_PRIME_;
+
+  return hash ^ (hash >> 31);
+}
+
+scew_hash
+finalize_ (scew_hash hash)
+{
+  /* SplitMix64 finalizer. */
+  hash ^= hash >> 30;
+  hash *= HASH_CONSTANT_ (0xbf58476dUL, 0x1ce4e5b9UL);
+  hash ^= hash >> 27;
+  hash *= HASH_CONSTANT_ (0x94d049bbUL, 0x133111ebUL);
+  hash ^= hash >> 31;
+
+  return hash;
+}
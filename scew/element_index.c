@@ -0,0 +1,438 @@
+/**
+ * @file     element_index.c
+ * @brief    xelement.h implementation (children index by name)
+ * @author   Aleix Conchillo Flaque <aconchillo@gmail.com>
+ * @date     Sun Oct 18, 2026 10:12
+ *
+ * @if copyright
+ *
+ * Copyright (C) 2026 Aleix Conchillo Flaque
+ *
+ * SCEW is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * SCEW is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ *
+ * @endif
+ */
+
+#include "xelement.h"
+
+#include "str.h"
+
+#include <assert.h>
+#include <string.h>
+
+
+
+/* Private */
+
+enum
+  {
+    INDEX_THRESHOLD_ = 32,      /**< Children needed to build an index */
+    MIN_INDEX_SIZE_ = 16,       /**< Initial slots of an index */
+    MIN_ENTRY_SIZE_ = 4         /**< Initial children of an index entry */
+  };
+
+/**
+ * All the children of an element with the same name, in the same
+ * order as in the element. Entries whose children have all been
+ * removed are kept (with no children) until the index is rehashed.
+ */
+typedef struct
+{
+  size_t hash;                  /**< Hash of the children name */
+  XML_Char const *name;         /**< Name of the first child */
+  scew_element **children;      /**< Children with this name */
+  unsigned int n_children;      /**< Number of children */
+  unsigned int size;            /**< Allocated children (0 if unused) */
+} index_entry;
+
+struct scew_element_index
+{
+  index_entry *entries;         /**< Open addressing table of entries */
+  unsigned int size;            /**< Number of entries (power of 2) */
+  unsigned int n_used;          /**< Used entries (even if empty) */
+};
+
+static size_t hash_name_ (XML_Char const *name);
+
+static index_entry* find_entry_ (scew_element_index const *index,
+                                 XML_Char const *name,
+                                 size_t hash);
+
+static index_entry* insert_entry_ (scew_element *element,
+                                   XML_Char const *name,
+                                   size_t hash);
+
+static scew_bool rehash_ (scew_element *element, unsigned int size);
+
+static scew_bool entry_insert_ (scew_element *element,
+                                index_entry *entry,
+                                scew_element *child);
+
+static unsigned int entry_position_ (index_entry const *entry,
+                                     scew_element const *child);
+
+static scew_bool index_build_ (scew_element *element);
+
+static scew_bool index_add_ (scew_element *element, scew_element *child);
+
+
+
+/* Protected */
+
+scew_bool
+scew_element_index_lookup_ (scew_element const *element,
+                            XML_Char const *name,
+                            scew_element * const **children,
+                            unsigned int *n_children)
+{
+  index_entry *entry = NULL;
+
+  assert (element != NULL);
+  assert (name != NULL);
+  assert (children != NULL);
+  assert (n_children != NULL);
+
+  /* Lookups never build the index, so they do not modify element. */
+  if (NULL == element->children_index)
+    {
+      return SCEW_FALSE;
+    }
+
+  entry = find_entry_ (element->children_index, name, hash_name_ (name));
+
+  *children = entry->children;
+  *n_children = entry->n_children;
+
+  return SCEW_TRUE;
+}
+
+void
+scew_element_index_build_ (scew_element *element)
+{
+  assert (element != NULL);
+
+  /* If the index can not be built, children are searched linearly. */
+  if ((NULL == element->children_index)
+      && (element->n_children >= INDEX_THRESHOLD_))
+    {
+      index_build_ (element);
+    }
+}
+
+void
+scew_element_index_add_ (scew_element *element, scew_element *child)
+{
+  assert (element != NULL);
+  assert (child != NULL);
+
+  /* The index is built as soon as the element has many children. */
+  if (NULL == element->children_index)
+    {
+      scew_element_index_build_ (element);
+    }
+  /* If the index can not be updated, it is built again with the next
+     child. */
+  else if (!index_add_ (element, child))
+    {
+      scew_element_index_free_ (element);
+    }
+}
+
+void
+scew_element_index_remove_ (scew_element *element, scew_element *child)
+{
+  index_entry *entry = NULL;
+  unsigned int position = 0;
+
+  assert (element != NULL);
+  assert (child != NULL);
+
+  if (NULL == element->children_index)
+    {
+      return;
+    }
+
+  entry = find_entry_ (element->children_index,
+                       child->name,
+                       hash_name_ (child->name));
+
+  position = entry_position_ (entry, child);
+
+  assert (position < entry->n_children);
+  assert (entry->children[position] == child);
+
+  entry->n_children -= 1;
+  memmove (entry->children + position,
+           entry->children + position + 1,
+           (entry->n_children - position) * sizeof (scew_element *));
+
+  /* The name of the removed child might be freed. */
+  entry->name = (entry->n_children > 0) ? entry->children[0]->name : NULL;
+}
+
+void
+scew_element_index_free_ (scew_element *element)
+{
+  unsigned int i = 0;
+  scew_element_index *index = NULL;
+
+  assert (element != NULL);
+
+  index = element->children_index;
+  if (index != NULL)
+    {
+      for (i = 0; i < index->size; ++i)
+        {
+          scew_arena_release_ (element->arena, index->entries[i].children);
+        }
+      scew_arena_release_ (element->arena, index->entries);
+      scew_arena_release_ (element->arena, index);
+
+      element->children_index = NULL;
+    }
+}
+
+
+
+/* Private */
+
+size_t
+hash_name_ (XML_Char const *name)
+{
+  /* FNV-1a */
+  size_t hash = 2166136261U;
+
+  while (*name != _XT('\0'))
+    {
+      hash = (hash ^ (size_t) *name) * 16777619U;
+      ++name;
+    }
+
+  return hash;
+}
+
+index_entry*
+find_entry_ (scew_element_index const *index,
+             XML_Char const *name,
+             size_t hash)
+{
+  unsigned int mask = index->size - 1;
+  unsigned int slot = hash & mask;
+  index_entry *unused = NULL;
+
+  while (index->entries[slot].size > 0)
+    {
+      index_entry *entry = &index->entries[slot];
+
+      if (0 == entry->n_children)
+        {
+          /* Remember the first empty entry, so it can be reused. */
+          unused = (NULL == unused) ? entry : unused;
+        }
+      else if ((entry->hash == hash)
+               && ((entry->name == name)
+                   || (scew_strcmp (entry->name, name) == 0)))
+        {
+          return entry;
+        }
+
+      slot = (slot + 1) & mask;
+    }
+
+  /* Not found, this is where the name should be inserted. */
+  return (NULL == unused) ? &index->entries[slot] : unused;
+}
+
+index_entry*
+insert_entry_ (scew_element *element, XML_Char const *name, size_t hash)
+{
+  scew_element_index *index = element->children_index;
+  index_entry *entry = find_entry_ (index, name, hash);
+
+  /* Never used entries will be used now, so the table might grow. */
+  if ((0 == entry->size) && (4 * (index->n_used + 1) > 3 * index->size))
+    {
+      if (!rehash_ (element, 2 * index->size))
+        {
+          return NULL;
+        }
+      index = element->children_index;
+      entry = find_entry_ (index, name, hash);
+    }
+
+  if (0 == entry->size)
+    {
+      index->n_used += 1;
+    }
+  entry->hash = hash;
+
+  return entry;
+}
+
+scew_bool
+rehash_ (scew_element *element, unsigned int size)
+{
+  unsigned int i = 0;
+  scew_element_index *index = element->children_index;
+  index_entry *entries = NULL;
+
+  entries = scew_arena_alloc_ (element->arena, size * sizeof (index_entry));
+  if (NULL == entries)
+    {
+      return SCEW_FALSE;
+    }
+
+  /* Move existing entries, dropping the ones without children. */
+  index->n_used = 0;
+  for (i = 0; i < index->size; ++i)
+    {
+      index_entry *entry = &index->entries[i];
+      if (entry->n_children > 0)
+        {
+          unsigned int slot = entry->hash & (size - 1);
+          while (entries[slot].size > 0)
+            {
+              slot = (slot + 1) & (size - 1);
+            }
+          entries[slot] = *entry;
+          index->n_used += 1;
+        }
+      else
+        {
+          scew_arena_release_ (element->arena, entry->children);
+        }
+    }
+
+  scew_arena_release_ (element->arena, index->entries);
+
+  index->entries = entries;
+  index->size = size;
+
+  return SCEW_TRUE;
+}
+
+scew_bool
+entry_insert_ (scew_element *element, index_entry *entry, scew_element *child)
+{
+  unsigned int position = 0;
+
+  if (entry->n_children == entry->size)
+    {
+      unsigned int size = (0 == entry->size)
+        ? MIN_ENTRY_SIZE_
+        : 2 * entry->size;
+      scew_element **children =
+        scew_arena_alloc_ (element->arena, size * sizeof (scew_element *));
+      if (NULL == children)
+        {
+          return SCEW_FALSE;
+        }
+      if (entry->n_children > 0)
+        {
+          memcpy (children, entry->children,
+                  entry->n_children * sizeof (scew_element *));
+        }
+      scew_arena_release_ (element->arena, entry->children);
+      entry->children = children;
+      entry->size = size;
+    }
+
+  /* Children are usually appended, otherwise keep them in order. */
+  position = entry_position_ (entry, child);
+
+  memmove (entry->children + position + 1,
+           entry->children + position,
+           (entry->n_children - position) * sizeof (scew_element *));
+  entry->children[position] = child;
+  entry->n_children += 1;
+
+  entry->name = entry->children[0]->name;
+
+  return SCEW_TRUE;
+}
+
+unsigned int
+entry_position_ (index_entry const *entry, scew_element const *child)
+{
+  unsigned int low = 0;
+  unsigned int high = entry->n_children;
+
+  if ((0 == high) || (entry->children[high - 1]->index < child->index))
+    {
+      return high;
+    }
+
+  /* First child not before the given one. */
+  while (low < high)
+    {
+      unsigned int middle = low + (high - low) / 2;
+      if (entry->children[middle]->index < child->index)
+        {
+          low = middle + 1;
+        }
+      else
+        {
+          high = middle;
+        }
+    }
+
+  return low;
+}
+
+scew_bool
+index_build_ (scew_element *element)
+{
+  unsigned int i = 0;
+  scew_element_index *index = NULL;
+
+  index = scew_arena_alloc_ (element->arena, sizeof (scew_element_index));
+  if (NULL == index)
+    {
+      return SCEW_FALSE;
+    }
+
+  index->size = MIN_INDEX_SIZE_;
+  index->entries = scew_arena_alloc_ (element->arena,
+                                      index->size * sizeof (index_entry));
+  if (NULL == index->entries)
+    {
+      scew_arena_release_ (element->arena, index);
+      return SCEW_FALSE;
+    }
+
+  element->children_index = index;
+
+  for (i = 0; i < element->n_children; ++i)
+    {
+      if (!index_add_ (element, element->children[i]))
+        {
+          scew_element_index_free_ (element);
+          return SCEW_FALSE;
+        }
+    }
+
+  return SCEW_TRUE;
+}
+
+scew_bool
+index_add_ (scew_element *element, scew_element *child)
+{
+  index_entry *entry = insert_entry_ (element,
+                                      child->name,
+                                      hash_name_ (child->name));
+
+  return (entry != NULL) && entry_insert_ (element, entry, child);
+}
@@ -45,54 +45,74 @@ static scew_bool cmp_name_ (void const *element, void const *name);
 scew_element*
 scew_element_by_name (scew_element const *element, XML_Char const *name)
 {
-  scew_list *item = NULL;
+  unsigned int i = 0;
+  unsigned int n_children = 0;
+  scew_element * const *children = NULL;
 
   assert (element != NULL);
   assert (name != NULL);
 
-  if (element->children != NULL)
+  /* Elements with many children are searched via an index. */
+  if (scew_element_index_lookup_ (element, name, &children, &n_children))
     {
-      item = scew_list_find_custom (element->children, name, cmp_name_);
+      return (n_children > 0) ? children[0] : NULL;
     }
 
-  return (NULL == item) ? NULL : (scew_element *) scew_list_data (item);
+  for (i = 0; i < element->n_children; ++i)
+    {
+      if (cmp_name_ (element->children[i], name))
+        {
+          return element->children[i];
+        }
+    }
+
+  return NULL;
 }
 
 scew_element*
 scew_element_by_index (scew_element const *element, unsigned int index)
 {
-  scew_list *item = NULL;
-
   assert (element != NULL);
   assert (index < element->n_children);
 
-  item = scew_list_index (element->children, index);
-
-  return (NULL == item) ? NULL : (scew_element *) scew_list_data (item);
+  return (index < element->n_children) ? element->children[index] : NULL;
 }
 
 scew_list*
 scew_element_list_by_name (scew_element const *element, XML_Char const *name)
 {
+  unsigned int i = 0;
+  unsigned int n_children = 0;
+  scew_element * const *children = NULL;
   scew_list *list = NULL;
   scew_list *last = NULL;
-  scew_list *item = NULL;
 
   assert (element != NULL);
   assert (name != NULL);
 
-  item = element->children;
-  while (item != NULL)
+  /* Elements with many children are searched via an index. */
+  if (scew_element_index_lookup_ (element, name, &children, &n_children))
     {
-      item = scew_list_find_custom (item, name, cmp_name_);
-      if (item != NULL)
+      for (i = 0; i < n_children; ++i)
         {
-          last = scew_list_append (last, scew_list_data (item));
+          last = scew_list_append (last, children[i]);
+          if (NULL == list)
+            {
+              list = last;
+            }
+        }
+      return list;
+    }
+
+  for (i = 0; i < element->n_children; ++i)
+    {
+      if (cmp_name_ (element->children[i], name))
+        {
+          last = scew_list_append (last, element->children[i]);
           if (NULL == list)
             {
               list = last;
             }
-          item = scew_list_next (item);
         }
     }
 
@@ -105,6 +125,9 @@ scew_element_list_by_name (scew_element const *element, XML_Char const *name)
 scew_bool
 cmp_name_ (void const *element, void const *name)
 {
-  return (scew_strcmp (((scew_element *) element)->name,
-                       (XML_Char *) name) == 0);
+  XML_Char const *element_name = ((scew_element *) element)->name;
+
+  /* Names interned in the same arena can be compared by pointer. */
+  return ((element_name == name)
+          || (scew_strcmp (element_name, (XML_Char *) name) == 0));
 }
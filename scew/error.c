@@ -52,7 +52,8 @@ scew_error_string (scew_error code)
       _XT("Input/Output error"),
       _XT("Error while calling hook"),
       _XT("Internal Expat parser error"),
-      _XT("Internal SCEW error")
+      _XT("Internal SCEW error"),
+      _XT("Invalid query expression")
     };
 
   assert (sizeof(message) / sizeof(message[0]) == scew_error_unknown);
@@ -69,6 +69,7 @@ typedef enum
     scew_error_hook,            /**< Hook returned error. */
     scew_error_expat,           /**< Expat parser error. */
     scew_error_internal,        /**< Internal SCEW error. */
+    scew_error_query,           /**< Invalid query expression. */
     scew_error_unknown          /**< end of list marker */
   } scew_error;
 
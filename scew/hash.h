@@ -0,0 +1,43 @@
+/**
+ * @file     hash.h
+ * @brief    SCEW hash type declaration
+ * @author   Aleix Conchillo Flaque <aconchillo@gmail.com>
+ * @date     Sun Oct 18, 2026 10:12
+ *
+ * @if copyright
+ *
+ * Copyright (C) 2026 Aleix Conchillo Flaque
+ *
+ * SCEW is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * SCEW is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ *
+ * @endif
+ */
+
+#ifndef HASH_H_2610181012
+#define HASH_H_2610181012
+
+/**
+ * Structural hashes of elements (see #scew_element_hash) are always
+ * 64-bit wide.
+ */
+#if defined (_MSC_VER)
+typedef unsigned __int64 scew_hash;
+#else
+#include <stdint.h>
+typedef uint64_t scew_hash;
+#endif /* _MSC_VER */
+
+#endif /* HASH_H_2610181012 */
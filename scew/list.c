@@ -28,19 +28,11 @@
 
 #include "list.h"
 
+#include "xlist.h"
+
 #include <assert.h>
 #include <stdlib.h>
 
-
-/* Private */
-
-struct scew_list
-{
-  void *data;
-  scew_list *prev;
-  scew_list *next;
-};
-
 
 /* Public */
 
@@ -67,12 +59,7 @@ scew_list_create (void *data)
 void
 scew_list_free (scew_list *list)
 {
-  while (list != NULL)
-    {
-      scew_list *tmp = list;
-      list = list->next;
-      free (tmp);
-    }
+  scew_list_arena_free_ (NULL, list);
 }
 
 
@@ -106,20 +93,7 @@ scew_list_size (scew_list *list)
 scew_list*
 scew_list_append (scew_list *list, void *data)
 {
-  scew_list *item = NULL;
-
-  assert (data != NULL);
-
-  item = scew_list_create (data);
-
-  if ((item != NULL) && (list != NULL))
-    {
-      scew_list *last = scew_list_last (list);
-      last->next = item;
-      item->prev = last;
-    }
-
-  return item;
+  return scew_list_arena_append_ (NULL, list, data);
 }
 
 scew_list*
@@ -180,28 +154,7 @@ scew_list_delete (scew_list *list, void *data)
 scew_list*
 scew_list_delete_item (scew_list *list, scew_list *item)
 {
-  assert (list != NULL);
-
-  if (item != NULL)
-    {
-      if (item->prev != NULL)
-        {
-          item->prev->next = item->next;
-        }
-      if (item->next != NULL)
-        {
-          item->next->prev = item->prev;
-        }
-
-      if (item == list)
-        {
-          list = list->next;
-        }
-
-      free (item);
-    }
-
-  return list;
+  return scew_list_arena_delete_item_ (NULL, list, item);
 }
 
 
@@ -319,3 +272,119 @@ scew_list_find_custom (scew_list *list,
 
   return list;
 }
+
+
+
+/* Protected */
+
+scew_list*
+scew_list_arena_append_ (scew_arena *arena, scew_list *list, void *data)
+{
+  scew_list *item = NULL;
+
+  assert (data != NULL);
+
+  item = scew_arena_alloc_ (arena, sizeof (scew_list));
+
+  if (item != NULL)
+    {
+      item->data = data;
+
+      if (list != NULL)
+        {
+          scew_list *last = scew_list_last (list);
+          last->next = item;
+          item->prev = last;
+        }
+    }
+
+  return item;
+}
+
+scew_list*
+scew_list_arena_delete_item_ (scew_arena *arena,
+                              scew_list *list,
+                              scew_list *item)
+{
+  assert (list != NULL);
+
+  if (item != NULL)
+    {
+      if (item->prev != NULL)
+        {
+          item->prev->next = item->next;
+        }
+      if (item->next != NULL)
+        {
+          item->next->prev = item->prev;
+        }
+
+      if (item == list)
+        {
+          list = list->next;
+        }
+
+      scew_arena_release_ (arena, item);
+    }
+
+  return list;
+}
+
+void
+scew_list_arena_free_ (scew_arena *arena, scew_list *list)
+{
+  while (list != NULL)
+    {
+      scew_list *tmp = list;
+      list = list->next;
+      scew_arena_release_ (arena, tmp);
+    }
+}
+
+scew_list*
+scew_list_arena_assign_ (scew_arena *arena,
+                         scew_list *list,
+                         void * const *data,
+                         unsigned int n_data)
+{
+  unsigned int i = 0;
+  scew_list *item = list;
+  scew_list *last = NULL;
+
+  /* Reuse existing items first... */
+  while ((i < n_data) && (item != NULL))
+    {
+      item->data = data[i++];
+      last = item;
+      item = item->next;
+    }
+
+  /* ... release the ones we do not need anymore... */
+  if (last != NULL)
+    {
+      last->next = NULL;
+    }
+  else
+    {
+      list = NULL;
+    }
+  scew_list_arena_free_ (arena, item);
+
+  /* ... or allocate the missing ones. */
+  while (i < n_data)
+    {
+      item = scew_list_arena_append_ (arena, last, data[i++]);
+      if (NULL == item)
+        {
+          scew_list_arena_free_ (arena, list);
+          return NULL;
+        }
+      if (NULL == list)
+        {
+          list = item;
+        }
+      last = item;
+    }
+
+  return list;
+}
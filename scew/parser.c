@@ -36,6 +36,7 @@
 
 #include <assert.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
 
@@ -43,17 +44,18 @@
 
 enum
   {
-    MAX_PARSE_BUFFER_ = 1024    /**< Size (bytes) of the internal buffer */
+    DEFAULT_BUFFER_SIZE_ = 32 * 1024, /**< Default reader chunk (chars) */
+    MAX_PARSE_SPAN_ = 256 * 1024 * 1024, /**< Max. chars per Expat call */
+    STREAM_CHUNK_SIZE_ = 4 * 1024 /**< Max. chars per Expat call (streams) */
   };
 
 static scew_parser* parser_create_ (scew_bool namespace, XML_Char separator);
 
 static scew_bool parse_reader_ (scew_parser *parser, scew_reader *reader);
-static scew_bool parse_buffer_ (scew_parser *parser,
-                                XML_Char const *buffer,
-                                size_t size,
-                                scew_bool done);
-
+static scew_bool parse_span_reader_ (scew_parser *parser,
+                                     scew_reader *reader,
+                                     XML_Char const *span,
+                                     size_t length);
 static scew_bool parse_stream_reader_ (scew_parser *parser,
                                        scew_reader *reader);
 static scew_bool parse_stream_buffer_ (scew_parser *parser,
@@ -90,6 +92,8 @@ scew_parser_free (scew_parser *parser)
           XML_ParserFree (parser->parser);
         }
 
+      free (parser->stack);
+      free (parser->text);
       free (parser);
     }
 }
@@ -104,6 +108,8 @@ scew_parser_load (scew_parser *parser, scew_reader *reader)
 
   scew_parser_reset (parser);
 
+  scew_parser_set_stream_ (parser, SCEW_FALSE);
+
   if (!parse_reader_ (parser, reader))
     {
       /* Free the allocated tree if something goes wrong. */
@@ -127,6 +133,8 @@ scew_parser_load_stream (scew_parser *parser, scew_reader *reader)
   assert (reader != NULL);
   assert (parser->tree_hook.hook != NULL);
 
+  scew_parser_set_stream_ (parser, SCEW_TRUE);
+
   result = parse_stream_reader_ (parser, reader);
   if (!result)
     {
@@ -138,6 +146,56 @@ scew_parser_load_stream (scew_parser *parser, scew_reader *reader)
   return result;
 }
 
+scew_bool
+scew_parser_feed (scew_parser *parser,
+                  XML_Char const *data,
+                  size_t length,
+                  scew_bool is_final)
+{
+  scew_bool result = SCEW_TRUE;
+
+  assert (parser != NULL);
+  assert ((data != NULL) || (0 == length));
+  assert (parser->tree_hook.hook != NULL);
+
+  scew_parser_set_stream_ (parser, SCEW_TRUE);
+
+  if (length > 0)
+    {
+      result = parse_stream_buffer_ (parser, data, length);
+    }
+
+  /**
+   * Expat might still hold the end of the last document. It is
+   * suspended if the root end tag is found (the tree hook has already
+   * been called then), otherwise the document is unfinished.
+   */
+  if (result && is_final && parser->parsing_started)
+    {
+      enum XML_Status status =
+        XML_Parse (parser->parser, NULL, 0, SCEW_TRUE);
+      if ((XML_STATUS_ERROR == status)
+          || ((XML_STATUS_OK == status) && (parser->stack_depth > 0)))
+        {
+          scew_error_set_last_error_ (scew_error_expat);
+          result = SCEW_FALSE;
+        }
+    }
+
+  if (!result)
+    {
+      /* Free the last allocated tree if something goes wrong. */
+      scew_tree_free (parser->tree);
+      parser->tree = NULL;
+    }
+  else if (is_final)
+    {
+      scew_parser_reset (parser);
+    }
+
+  return result;
+}
+
 void
 scew_parser_reset (scew_parser *parser)
 {
@@ -146,6 +204,9 @@ scew_parser_reset (scew_parser *parser)
   /* Free stack (to avoid memory leak if last load went wrong). */
   scew_parser_stack_free_ (parser);
 
+  /* Free the arena of the last (unfinished) tree. */
+  scew_arena_free_ (parser->arena);
+
   /* Free last loaded preamble. */
   free (parser->preamble);
 
@@ -156,7 +217,13 @@ scew_parser_reset (scew_parser *parser)
   /* Initialise structure fields to NULL. */
   parser->tree = NULL;
   parser->preamble = NULL;
-  parser->stack = NULL;
+  parser->arena = NULL;
+  parser->stack_depth = 0;
+  parser->skip_depth = 0;
+  parser->text_length = 0;
+  parser->parsing_started = SCEW_FALSE;
+  parser->stream_offset = 0;
+  parser->stream_end = 0;
 }
 
 void
@@ -181,6 +248,28 @@ scew_parser_set_tree_hook (scew_parser *parser,
   parser->tree_hook.data = user_data;
 }
 
+void
+scew_parser_set_consume_hook (scew_parser *parser,
+                              scew_parser_consume_hook hook,
+                              void *user_data)
+{
+  assert (parser != NULL);
+
+  parser->consume_hook.hook = hook;
+  parser->consume_hook.data = user_data;
+}
+
+void
+scew_parser_set_filter_hook (scew_parser *parser,
+                             scew_parser_filter_hook hook,
+                             void *user_data)
+{
+  assert (parser != NULL);
+
+  parser->filter_hook.hook = hook;
+  parser->filter_hook.data = user_data;
+}
+
 XML_Parser
 scew_parser_expat (scew_parser *parser)
 {
@@ -197,6 +286,23 @@ scew_parser_ignore_whitespaces (scew_parser *parser, scew_bool ignore)
   parser->ignore_whitespaces = ignore;
 }
 
+void
+scew_parser_set_buffer_size (scew_parser *parser, size_t size)
+{
+  assert (parser != NULL);
+  assert (size > 0);
+
+  parser->buffer_size = size;
+}
+
+void
+scew_parser_set_arena (scew_parser *parser, scew_bool use_arena)
+{
+  assert (parser != NULL);
+
+  parser->use_arena = use_arena;
+}
+
 
 /* Private */
 
@@ -226,11 +332,17 @@ parser_create_ (scew_bool namespace, XML_Char separator)
       /* Ignore white spaces by default. */
       parser->ignore_whitespaces = SCEW_TRUE;
 
+      parser->buffer_size = DEFAULT_BUFFER_SIZE_;
+
       /* No load hooks by default. */
       parser->element_hook.hook = NULL;
       parser->element_hook.data = NULL;
       parser->tree_hook.hook = NULL;
       parser->tree_hook.data = NULL;
+      parser->consume_hook.hook = NULL;
+      parser->consume_hook.data = NULL;
+      parser->filter_hook.hook = NULL;
+      parser->filter_hook.data = NULL;
 
       scew_parser_reset (parser);
     }
@@ -249,16 +361,37 @@ parse_reader_ (scew_parser *parser, scew_reader *reader)
 {
   scew_bool done = SCEW_FALSE;
   scew_bool result = SCEW_TRUE;
+  XML_Char const *span = NULL;
+  size_t span_length = 0;
 
   assert (parser != NULL);
   assert (reader != NULL);
 
+  /* Readers that expose their data can be parsed without copies. */
+  span_length = scew_reader_span (reader, &span);
+  if (span != NULL)
+    {
+      return parse_span_reader_ (parser, reader, span, span_length);
+    }
+
   while (!done && result)
     {
-      XML_Char buffer[MAX_PARSE_BUFFER_ + 1];
+      size_t length = 0;
 
-      /* Read files in small chunks. */
-      size_t length = scew_reader_read (reader, buffer, MAX_PARSE_BUFFER_);
+      /**
+       * Read directly into Expat's buffer to avoid an extra copy (one
+       * more character as readers might null-terminate the data).
+       */
+      XML_Char *buffer =
+        XML_GetBuffer (parser->parser,
+                       (parser->buffer_size + 1) * sizeof (XML_Char));
+      if (NULL == buffer)
+        {
+          scew_error_set_last_error_ (scew_error_no_memory);
+          return SCEW_FALSE;
+        }
+
+      length = scew_reader_read (reader, buffer, parser->buffer_size);
       if (scew_reader_error (reader))
         {
           scew_error_set_last_error_ (scew_error_io);
@@ -267,7 +400,18 @@ parse_reader_ (scew_parser *parser, scew_reader *reader)
       else
         {
           done = scew_reader_end (reader);
-          result = parse_buffer_ (parser, buffer, length, done);
+          if ((length > 0) || done)
+            {
+              enum XML_Status status =
+                XML_ParseBuffer (parser->parser,
+                                 length * sizeof (XML_Char),
+                                 done);
+              if (XML_STATUS_ERROR == status)
+                {
+                  scew_error_set_last_error_ (scew_error_expat);
+                  result = SCEW_FALSE;
+                }
+            }
         }
     }
 
@@ -275,24 +419,58 @@ parse_reader_ (scew_parser *parser, scew_reader *reader)
 }
 
 scew_bool
-parse_buffer_ (scew_parser *parser,
-               XML_Char const *buffer,
-               size_t size,
-               scew_bool done)
+parse_span_reader_ (scew_parser *parser,
+                    scew_reader *reader,
+                    XML_Char const *span,
+                    size_t length)
 {
-  scew_bool result = SCEW_TRUE;
-  size_t byte_no = size * sizeof (XML_Char);
+  scew_bool done = SCEW_FALSE;
 
-  if (done || !scew_isempty (buffer))
+  assert (parser != NULL);
+  assert (reader != NULL);
+  assert (span != NULL);
+
+  while (!done)
     {
-      if (!XML_Parse (parser->parser, (char *) buffer, byte_no, done))
+      /* Expat lengths are ints, so huge spans are split. */
+      while (length > MAX_PARSE_SPAN_)
         {
-          scew_error_set_last_error_ (scew_error_expat);
-          result = SCEW_FALSE;
+          enum XML_Status status =
+            XML_Parse (parser->parser,
+                       (char const *) span,
+                       MAX_PARSE_SPAN_ * sizeof (XML_Char),
+                       SCEW_FALSE);
+          if (XML_STATUS_ERROR == status)
+            {
+              scew_error_set_last_error_ (scew_error_expat);
+              return SCEW_FALSE;
+            }
+          span += MAX_PARSE_SPAN_;
+          length -= MAX_PARSE_SPAN_;
+        }
+
+      done = scew_reader_end (reader);
+      if ((length > 0) || done)
+        {
+          enum XML_Status status =
+            XML_Parse (parser->parser,
+                       (char const *) span,
+                       length * sizeof (XML_Char),
+                       done);
+          if (XML_STATUS_ERROR == status)
+            {
+              scew_error_set_last_error_ (scew_error_expat);
+              return SCEW_FALSE;
+            }
+        }
+
+      if (!done)
+        {
+          length = scew_reader_span (reader, &span);
         }
     }
 
-  return result;
+  return SCEW_TRUE;
 }
 
 scew_bool
@@ -300,16 +478,39 @@ parse_stream_reader_ (scew_parser *parser, scew_reader *reader)
 {
   scew_bool done = SCEW_FALSE;
   scew_bool result = SCEW_TRUE;
+  XML_Char const *span = NULL;
+  XML_Char *buffer = NULL;
+  size_t length = 0;
 
-  assert(parser != NULL);
-  assert(reader != NULL);
+  assert (parser != NULL);
+  assert (reader != NULL);
 
-  while (!done && result)
+  /* Readers that expose their data can be parsed without copies. */
+  length = scew_reader_span (reader, &span);
+  if (span != NULL)
     {
-      XML_Char buffer[MAX_PARSE_BUFFER_ + 1];
+      while (result && !done)
+        {
+          result = parse_stream_buffer_ (parser, span, length);
+          done = ((0 == length) || scew_reader_end (reader));
+          if (result && !done)
+            {
+              length = scew_reader_span (reader, &span);
+            }
+        }
+      return result;
+    }
+
+  buffer = malloc ((parser->buffer_size + 1) * sizeof (XML_Char));
+  if (NULL == buffer)
+    {
+      scew_error_set_last_error_ (scew_error_no_memory);
+      return SCEW_FALSE;
+    }
 
-      /* Read files in small chunks. */
-      size_t length = scew_reader_read (reader, buffer, MAX_PARSE_BUFFER_);
+  while (result && !done)
+    {
+      length = scew_reader_read (reader, buffer, parser->buffer_size);
       if (scew_reader_error (reader))
         {
           scew_error_set_last_error_ (scew_error_io);
@@ -322,93 +523,75 @@ parse_stream_reader_ (scew_parser *parser, scew_reader *reader)
         }
     }
 
+  free (buffer);
+
   return result;
 }
 
 scew_bool
 parse_stream_buffer_ (scew_parser *parser, XML_Char const *buffer, size_t size)
 {
-  unsigned int start = 0;
-  unsigned int end = 0;
-  unsigned int length = 0;
-
-  assert(parser != NULL);
-  assert(buffer != NULL);
+  assert (parser != NULL);
+  assert (buffer != NULL);
 
   /**
-   * Loop through the buffer and:
-   *    if we encounter a '>', send the chunk to Expat.
-   *    if we hit the end of the buffer, send whatever remains to Expat.
+   * The whole buffer is given to Expat at once. Whenever a tree is
+   * loaded, Expat is suspended (see the end element handler) and
+   * the remaining data is given to a new document.
    */
-  while ((start < size) && (end <= size))
+  while (size > 0)
     {
-      /**
-       * If we haven't got any non-space character yet, let's check
-       * again. If we have one now, it means there will be something to
-       * parse soon.
-       */
-      if (!parser->parsing_started && !scew_isspace (buffer[start]))
+      enum XML_Status status = XML_STATUS_OK;
+      size_t length = size;
+
+      /* Skip white spaces between documents. */
+      if (!parser->parsing_started)
         {
+          while ((size > 0) && scew_isspace (*buffer))
+            {
+              buffer += 1;
+              size -= 1;
+            }
+          if (0 == size)
+            {
+              break;
+            }
           parser->parsing_started = SCEW_TRUE;
         }
 
       /**
-       * If we still are not doing any real parsing, let's skip
-       * whitespaces.
+       * When suspended, Expat copies all the data it has not parsed,
+       * so it is only given small chunks (streams are usually formed
+       * by small documents).
        */
-      if (!parser->parsing_started && (parser->stack == NULL))
+      length = (size > STREAM_CHUNK_SIZE_) ? STREAM_CHUNK_SIZE_ : size;
+
+      status = XML_Parse (parser->parser,
+                          (char const *) buffer,
+                          length * sizeof (XML_Char),
+                          SCEW_FALSE);
+      if (XML_STATUS_ERROR == status)
         {
-          while ((start < size) && scew_isspace (buffer[start]))
-            {
-              start += 1;
-              end += 1;
-            }
+          scew_error_set_last_error_ (scew_error_expat);
+          return SCEW_FALSE;
         }
 
-      if ((end == size) || (buffer[end] == _XT('>')))
+      if (XML_STATUS_SUSPENDED == status)
         {
-          length = end - start;
-          if (end < size)
-            {
-              length += 1;
-            }
+          /* Only the data up to the root end tag belongs to the tree. */
+          length = (parser->stream_end - parser->stream_offset)
+            / sizeof (XML_Char);
 
-          if (!parse_buffer_ (parser, &buffer[start], length, SCEW_FALSE))
-            {
-              return SCEW_FALSE;
-            }
-
-          if ((parser->tree != NULL)
-              && (scew_tree_root (parser->tree) != NULL)
-              && (NULL == parser->stack))
-            {
-              /* Tell Expat we're done. */
-              if (!parse_buffer_ (parser, _XT(""), 0, SCEW_TRUE))
-                {
-                  return SCEW_FALSE;
-                }
-
-              /**
-               * We don't need to free last loaded XML, as it's the
-               * users responsibility.
-               */
-              parser->tree = NULL;
-
-              /* Reset parser to continue using it. */
-              scew_parser_reset (parser);
-            }
-
-          /* If this was the last element of a tree, reset parsing. */
-          if ((end < size)
-              && (buffer[end] == _XT('>'))
-              && (parser->stack == NULL))
-            {
-              parser->parsing_started = SCEW_FALSE;
-            }
-
-          start = end + 1;
+          /* Reset parser to continue using it. */
+          scew_parser_reset (parser);
         }
-      end += 1;
+      else
+        {
+          parser->stream_offset += length * sizeof (XML_Char);
+        }
+
+      buffer += length;
+      size -= length;
     }
 
   return SCEW_TRUE;
@@ -79,6 +79,78 @@ typedef struct scew_parser scew_parser;
  */
 typedef scew_bool (*scew_parser_load_hook) (scew_parser *, void *, void *);
 
+/**
+ * Possible results of a consume hook (see
+ * #scew_parser_set_consume_hook).
+ *
+ * @ingroup SCEWParserLoad
+ */
+typedef enum
+  {
+    scew_parser_consume_error,  /**< Stop parsing with an error */
+    scew_parser_consume_keep,   /**< Keep the element in the tree */
+    scew_parser_consume_free,   /**< Detach and free the element */
+    scew_parser_consume_take    /**< Detach the element, which belongs
+                                   to the hook from now on */
+  } scew_parser_consume;
+
+/**
+ * SCEW parser consume hooks are called once an XML element is
+ * completely parsed and tell the parser what to do with it (see
+ * #scew_parser_consume).
+ *
+ * @param parser the parser that is loading the XML contents.
+ * @param element the element that has just been parsed.
+ * @param user_data an optional user data pointer to be used by the
+ * hook (might be NULL).
+ *
+ * @return what the parser should do with the @a element.
+ *
+ * @ingroup SCEWParserLoad
+ */
+typedef scew_parser_consume (*scew_parser_consume_hook) (scew_parser *,
+                                                         scew_element *,
+                                                         void *);
+
+/**
+ * Possible results of a filter hook (see #scew_parser_set_filter_hook).
+ *
+ * @ingroup SCEWParserLoad
+ */
+typedef enum
+  {
+    scew_parser_filter_error,   /**< Stop parsing with an error */
+    scew_parser_filter_build,   /**< Build the element */
+    scew_parser_filter_skip,    /**< Skip the element and its subtree */
+    scew_parser_filter_flatten  /**< Skip the element, but not its
+                                   subtree, which is added to the
+                                   parent */
+  } scew_parser_filter;
+
+/**
+ * SCEW parser filter hooks are called when the start tag of an XML
+ * element is found, before the element is created, and tell the
+ * parser whether to build it (see #scew_parser_filter).
+ *
+ * @param parser the parser that is loading the XML contents.
+ * @param parent the nearest built ancestor of the element.
+ * @param name the name of the element.
+ * @param attributes the attributes of the element, as a
+ * NULL-terminated array of names and values.
+ * @param user_data an optional user data pointer to be used by the
+ * hook (might be NULL).
+ *
+ * @return what the parser should do with the element.
+ *
+ * @ingroup SCEWParserLoad
+ */
+typedef scew_parser_filter
+(*scew_parser_filter_hook) (scew_parser *,
+                            scew_element *,
+                            XML_Char const *,
+                            XML_Char const **,
+                            void *);
+
 
 /**
  * @defgroup SCEWParserAlloc Allocation
@@ -168,12 +240,18 @@ extern SCEW_API scew_tree* scew_parser_load (scew_parser *parser,
  *
  * Another important difference is that concatenated XML documents are
  * allowed. Once the parser loads elements or complete XML trees, the
- * appropiate registered hooks will be called.
+ * appropiate registered hooks will be called. Trees passed to the tree
+ * hook are owned by the hook, which might free them right away.
  *
  * It is necessary to register an XML tree hook, otherwise it will not
  * be possible to get a reference to parsed XML trees, causing a
  * memory leak.
  *
+ * An unfinished document at the end of the @a reader is kept for the
+ * next call, as the rest of it might come from another reader. Call
+ * #scew_parser_feed with no data and @a is_final set to know whether
+ * the stream ended in the middle of a document.
+ *
  * @pre parser != NULL
  * @pre reader != NULL
  * @pre tree hook registered (#scew_parser_set_tree_hook)
@@ -191,11 +269,55 @@ extern SCEW_API scew_tree* scew_parser_load (scew_parser *parser,
 extern SCEW_API scew_bool scew_parser_load_stream (scew_parser *parser,
                                                    scew_reader *reader);
 
+/**
+ * Gives the next @a length characters of a stream to the @a
+ * parser. This is the push counterpart of #scew_parser_load_stream:
+ * instead of reading from a reader until it ends, the caller gives
+ * data whenever it is available (e.g. when a non-blocking socket is
+ * readable in an event loop), and this function returns as soon as
+ * the data is parsed.
+ *
+ * The parser keeps its state (open elements, preamble and partial
+ * tree) between calls, and the registered hooks are called as
+ * elements and trees are loaded. As with streams, concatenated XML
+ * documents are allowed, and trees passed to the tree hook are owned
+ * by the hook.
+ *
+ * Note that, in arena mode (see #scew_parser_set_arena), every
+ * unfinished tree holds at least one big memory chunk, so arenas are
+ * not recommended when feeding many parsers at the same time.
+ *
+ * When @a is_final is true, there is no more data to come. An
+ * unfinished document is then reported as an error, and, otherwise,
+ * the parser is reset so it can be used again. If an error is found,
+ * the parser needs to be reset (see #scew_parser_reset) before
+ * giving it new data.
+ *
+ * @pre parser != NULL
+ * @pre data != NULL or length == 0
+ * @pre tree hook registered (#scew_parser_set_tree_hook)
+ *
+ * @param parser the SCEW @a parser that parses the given @a data.
+ * @param data the characters to parse.
+ * @param length the number of characters in @a data (might be 0).
+ * @param is_final whether this is the last data of the stream.
+ *
+ * @return true if the parsing is being successful, false if an error
+ * is found.
+ *
+ * @ingroup SCEWParserLoad
+ */
+extern SCEW_API scew_bool scew_parser_feed (scew_parser *parser,
+                                            XML_Char const *data,
+                                            size_t length,
+                                            scew_bool is_final);
+
 /**
  * Resets the given @a parser for further uses. Resetting a parser
  * allows the parser to be re-used. This function is automatically
  * called in #scew_parser_load, but needs to be called when loading
- * streams, as #scew_parser_load_stream does not reset the parser.
+ * streams, as #scew_parser_load_stream does not reset the parser
+ * (neither does #scew_parser_feed after an error).
  *
  * @pre parser != NULL
  *
@@ -214,7 +336,8 @@ extern SCEW_API void scew_parser_reset (scew_parser *parser);
  * big XML documents.
  *
  * Note that no modification or deletion should be performed on the
- * elements as they might still be needed by the parser.
+ * elements as they might still be needed by the parser. Elements
+ * might be released while loading via #scew_parser_set_consume_hook.
  *
  * @pre parser != NULL
  * @pre hook != NULL
@@ -254,6 +377,70 @@ extern SCEW_API void scew_parser_set_tree_hook (scew_parser *parser,
                                                 scew_parser_load_hook hook,
                                                 void *user_data);
 
+/**
+ * Registers a @a hook to be called once an XML element is
+ * successfully parsed (after the element hook, if any). The hook
+ * decides whether the element stays in the tree or is detached from
+ * its parent right away, either to be freed by the parser or to be
+ * owned by the hook.
+ *
+ * Consuming elements keeps memory usage constant when loading big
+ * documents formed by many records (e.g. one root element with
+ * millions of children), as only the elements being parsed and the
+ * ones kept are in memory.
+ *
+ * The hook is not called for root elements, as they belong to the
+ * loaded tree. If white spaces are ignored (see
+ * #scew_parser_ignore_whitespaces), spaces found before a consumed
+ * element are dropped unless its parent already has some text.
+ *
+ * In arena mode (see #scew_parser_set_arena), memory of consumed
+ * elements is not reclaimed until the tree is freed, and elements
+ * taken by the hook must not be used after that.
+ *
+ * @pre parser != NULL
+ *
+ * @param parser the parser that is loading the XML contents.
+ * @param hook this is the hook to be called once an XML element is
+ * parsed (NULL to remove it).
+ * @param user_data an optional user data pointer to be used by the
+ * hook (might be NULL).
+ *
+ * @ingroup SCEWParserLoad
+ */
+extern SCEW_API void
+scew_parser_set_consume_hook (scew_parser *parser,
+                              scew_parser_consume_hook hook,
+                              void *user_data);
+
+/**
+ * Registers a @a hook to be called when the start tag of an XML
+ * element is found. The hook decides whether the element is built,
+ * skipped with all its subtree, or flattened (only the element is
+ * skipped, and its children and text are added to its parent).
+ *
+ * Skipped subtrees are only tokenized by Expat, no SCEW memory is
+ * allocated for them and no other hooks are called. This makes
+ * loading faster and smaller when only a few branches of a big
+ * document are needed.
+ *
+ * The hook is not called for root elements, which are always built.
+ *
+ * @pre parser != NULL
+ *
+ * @param parser the parser that is loading the XML contents.
+ * @param hook this is the hook to be called for every start tag (NULL
+ * to remove it).
+ * @param user_data an optional user data pointer to be used by the
+ * hook (might be NULL).
+ *
+ * @ingroup SCEWParserLoad
+ */
+extern SCEW_API void
+scew_parser_set_filter_hook (scew_parser *parser,
+                             scew_parser_filter_hook hook,
+                             void *user_data);
+
 /**
  * Tells the @a parser how to treat white spaces. The default is to ignore
  * heading and trailing white spaces, except for text nodes where white spaces
@@ -281,6 +468,53 @@ extern SCEW_API void scew_parser_set_tree_hook (scew_parser *parser,
 extern SCEW_API void scew_parser_ignore_whitespaces (scew_parser *parser,
                                                      scew_bool ignore);
 
+/**
+ * Sets the number of characters the @a parser reads at once from
+ * readers when loading XML documents (see #scew_parser_load and
+ * #scew_parser_load_stream). Data is
+ * read directly into the internal Expat buffer. Bigger sizes mean
+ * less reader calls for big documents, at the cost of more memory.
+ * The default size is 32768 characters.
+ *
+ * @pre parser != NULL
+ * @pre size > 0
+ *
+ * @param parser the parser to set the option to.
+ * @param size number of characters to read at once.
+ *
+ * @ingroup SCEWParserLoad
+ */
+extern SCEW_API void scew_parser_set_buffer_size (scew_parser *parser,
+                                                  size_t size);
+
+/**
+ * Tells the @a parser whether to allocate loaded trees in an
+ * arena. The default is not to use arenas.
+ *
+ * In arena mode, all the elements, attributes, strings and lists of
+ * a tree are allocated from a few big memory chunks owned by the
+ * tree. This makes loading faster and #scew_tree_free only needs to
+ * release the chunks instead of walking the whole tree.
+ *
+ * Trees loaded in arena mode can still be modified. However, note
+ * that:
+ *
+ * - Memory of deleted elements or attributes and replaced names,
+ *   values or contents is not reclaimed until the tree is freed.
+ * - Elements and attributes of the tree must not be used after the
+ *   tree is freed, even if they have been detached from it.
+ * - Attaching elements or attributes created elsewhere to the tree is
+ *   allowed, but #scew_tree_free will then need to walk the tree.
+ *
+ * @param parser the parser to set the option to.
+ * @param use_arena whether the @a parser should allocate trees in an
+ * arena.
+ *
+ * @ingroup SCEWParserLoad
+ */
+extern SCEW_API void scew_parser_set_arena (scew_parser *parser,
+                                            scew_bool use_arena);
+
 
 /**
  * @defgroup SCEWParserAcc Accessors
@@ -0,0 +1,215 @@
+/**
+ * @file     parser_batch.c
+ * @brief    parser_batch.h implementation
+ * @author   Aleix Conchillo Flaque <aconchillo@gmail.com>
+ * @date     Sun Oct 18, 2026 10:12
+ *
+ * @if copyright
+ *
+ * Copyright (C) 2026 Aleix Conchillo Flaque
+ *
+ * SCEW is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * SCEW is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ *
+ * @endif
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "parser_batch.h"
+
+#include "reader_mmap.h"
+#include "xerror.h"
+#include "xthread.h"
+
+#include <assert.h>
+
+
+/* Private */
+
+typedef struct
+{
+  scew_parser_pool *pool;       /**< Pool to take parsers from */
+  scew_reader **readers;        /**< Readers to load (or NULL) */
+  char const **file_names;      /**< Files to load (or NULL) */
+  size_t count;                 /**< Number of documents */
+  scew_tree **trees;            /**< Loaded trees */
+  scew_error *errors;           /**< Error codes (might be NULL) */
+  size_t volatile next;         /**< Next document to load */
+} batch_;
+
+static scew_bool load_batch_ (batch_ *batch, unsigned int n_threads);
+static void batch_worker_ (void *data);
+static scew_tree* batch_load_ (batch_ *batch,
+                               scew_parser *parser,
+                               size_t index,
+                               scew_error *error);
+
+
+/* Public */
+
+scew_bool
+scew_parser_load_batch (scew_parser_pool *pool,
+                        scew_reader **readers,
+                        size_t count,
+                        unsigned int n_threads,
+                        scew_tree **trees,
+                        scew_error *errors)
+{
+  batch_ batch;
+
+  assert (readers != NULL);
+  assert (trees != NULL);
+
+  batch.pool = pool;
+  batch.readers = readers;
+  batch.file_names = NULL;
+  batch.count = count;
+  batch.trees = trees;
+  batch.errors = errors;
+  batch.next = 0;
+
+  return load_batch_ (&batch, n_threads);
+}
+
+scew_bool
+scew_parser_load_batch_files (scew_parser_pool *pool,
+                              char const **file_names,
+                              size_t count,
+                              unsigned int n_threads,
+                              scew_tree **trees,
+                              scew_error *errors)
+{
+  batch_ batch;
+
+  assert (file_names != NULL);
+  assert (trees != NULL);
+
+  batch.pool = pool;
+  batch.readers = NULL;
+  batch.file_names = file_names;
+  batch.count = count;
+  batch.trees = trees;
+  batch.errors = errors;
+  batch.next = 0;
+
+  return load_batch_ (&batch, n_threads);
+}
+
+
+/* Private */
+
+scew_bool
+load_batch_ (batch_ *batch, unsigned int n_threads)
+{
+  size_t i = 0;
+  scew_bool result = SCEW_TRUE;
+
+  if (0 == n_threads)
+    {
+      n_threads = scew_thread_count_ ();
+    }
+
+  /* No need for more threads than documents. */
+  if (n_threads > batch->count)
+    {
+      n_threads = (unsigned int) batch->count;
+    }
+
+  if (n_threads > 0)
+    {
+      scew_thread_run_ (n_threads, batch_worker_, batch);
+    }
+
+  for (i = 0; result && (i < batch->count); ++i)
+    {
+      result = (batch->trees[i] != NULL);
+    }
+
+  return result;
+}
+
+void
+batch_worker_ (void *data)
+{
+  batch_ *batch = data;
+  size_t index = 0;
+
+  /* Each worker keeps the same parser for all its documents. */
+  scew_parser *parser = (batch->pool != NULL)
+    ? scew_parser_pool_acquire (batch->pool)
+    : scew_parser_create ();
+
+  while ((index = scew_atomic_next_ (&batch->next)) < batch->count)
+    {
+      scew_error error = scew_error_no_memory;
+
+      batch->trees[index] = (parser != NULL)
+        ? batch_load_ (batch, parser, index, &error)
+        : NULL;
+
+      if (batch->errors != NULL)
+        {
+          batch->errors[index] = error;
+        }
+    }
+
+  if ((parser != NULL) && (batch->pool != NULL))
+    {
+      scew_parser_pool_release (batch->pool, parser);
+    }
+  else
+    {
+      scew_parser_free (parser);
+    }
+}
+
+scew_tree*
+batch_load_ (batch_ *batch,
+             scew_parser *parser,
+             size_t index,
+             scew_error *error)
+{
+  scew_tree *tree = NULL;
+  scew_reader *reader = (batch->readers != NULL)
+    ? batch->readers[index]
+    : scew_reader_mmap_create (batch->file_names[index]);
+
+  if (NULL == reader)
+    {
+      *error = scew_error_io;
+      return NULL;
+    }
+
+  /* Errors are kept per thread. */
+  scew_error_set_last_error_ (scew_error_none);
+
+  tree = scew_parser_load (parser, reader);
+
+  *error = (tree != NULL) ? scew_error_none : scew_error_code ();
+  if ((NULL == tree) && (scew_error_none == *error))
+    {
+      *error = scew_error_internal;
+    }
+
+  if (NULL == batch->readers)
+    {
+      scew_reader_free (reader);
+    }
+
+  return tree;
+}
@@ -0,0 +1,115 @@
+/**
+ * @file     parser_batch.h
+ * @brief    SCEW parallel batch loading
+ * @author   Aleix Conchillo Flaque <aconchillo@gmail.com>
+ * @date     Sun Oct 18, 2026 10:12
+ * @ingroup  SCEWParserBatch
+ *
+ * @if copyright
+ *
+ * Copyright (C) 2026 Aleix Conchillo Flaque
+ *
+ * SCEW is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * SCEW is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ *
+ * @endif
+ */
+
+/**
+ * @defgroup SCEWParserBatch Batch loading
+ *
+ * Load many independent XML documents at once, using several
+ * threads. Each thread uses its own parser, taken from an optional
+ * parser pool (see @ref SCEWParserPool), and documents are handed
+ * out to threads as they become idle.
+ *
+ * Note that registered load hooks are called from the loading
+ * threads.
+ */
+
+#ifndef PARSER_BATCH_H_2610181012
+#define PARSER_BATCH_H_2610181012
+
+#include "export.h"
+
+#include "bool.h"
+#include "error.h"
+#include "parser_pool.h"
+#include "reader.h"
+#include "tree.h"
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * Loads the XML trees of the given @a readers using @a n_threads
+ * threads. Trees are returned in @a trees in the same order as the
+ * readers. If a document can not be loaded, its tree is NULL and the
+ * reason is stored in @a errors (if given), otherwise
+ * #scew_error_none is stored. Expat specific error information is
+ * not available for batch loads.
+ *
+ * @pre readers != NULL
+ * @pre trees != NULL
+ *
+ * @param pool the pool to take parsers from (one per thread), or NULL
+ * to use parsers with the default configuration.
+ * @param readers the readers to load XML documents from.
+ * @param count the number of readers.
+ * @param n_threads the number of threads to use. If 0, the number of
+ * available processors is used.
+ * @param trees where the @a count loaded trees are stored.
+ * @param errors where the @a count error codes are stored (might be
+ * NULL).
+ *
+ * @return true if all the documents were loaded, false otherwise.
+ *
+ * @ingroup SCEWParserBatch
+ */
+extern SCEW_API scew_bool
+scew_parser_load_batch (scew_parser_pool *pool,
+                        scew_reader **readers,
+                        size_t count,
+                        unsigned int n_threads,
+                        scew_tree **trees,
+                        scew_error *errors);
+
+/**
+ * Loads the XML trees of the given files using @a n_threads
+ * threads. This works as #scew_parser_load_batch, but files are
+ * opened (see #scew_reader_mmap_create) by the loading threads. If a
+ * file can not be opened, #scew_error_io is stored in its error code.
+ *
+ * @pre file_names != NULL
+ * @pre trees != NULL
+ *
+ * @ingroup SCEWParserBatch
+ */
+extern SCEW_API scew_bool
+scew_parser_load_batch_files (scew_parser_pool *pool,
+                              char const **file_names,
+                              size_t count,
+                              unsigned int n_threads,
+                              scew_tree **trees,
+                              scew_error *errors);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* PARSER_BATCH_H_2610181012 */
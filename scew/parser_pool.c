@@ -0,0 +1,482 @@
+/**
+ * @file     parser_pool.c
+ * @brief    parser_pool.h implementation
+ * @author   Aleix Conchillo Flaque <aconchillo@gmail.com>
+ * @date     Sun Oct 18, 2026 10:12
+ *
+ * @if copyright
+ *
+ * Copyright (C) 2026 Aleix Conchillo Flaque
+ *
+ * SCEW is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * SCEW is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ *
+ * @endif
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "parser_pool.h"
+
+#include "xparser.h"
+#include "xerror.h"
+#include "xthread.h"
+
+#include <assert.h>
+#include <stdlib.h>
+
+#if defined(SCEW_SINGLE_THREADED_)
+#elif defined(_MSC_VER)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+
+/* Private */
+
+enum
+  {
+    CACHE_SIZE_ = 4,            /**< Parsers cached per thread */
+    SHARED_SPINS_ = 64          /**< Checks of an empty shared list */
+  };
+
+typedef struct parser_cache parser_cache;
+
+struct parser_cache
+{
+  scew_parser_pool *pool;       /**< Pool this cache belongs to */
+  void *volatile owned;         /**< NULL if no thread owns the cache */
+  parser_cache *next;           /**< Next cache of the pool */
+  unsigned int count;           /**< Number of cached parsers */
+  scew_parser *parsers[CACHE_SIZE_]; /**< Cached parsers */
+};
+
+struct scew_parser_pool
+{
+  scew_bool namespace;          /**< Whether parsers use namespaces */
+  XML_Char separator;           /**< Namespace separator */
+  scew_bool ignore_whitespaces; /**< Whether to ignore white spaces */
+  scew_bool use_arena;          /**< Whether to allocate trees in arenas */
+  size_t buffer_size;           /**< Reader chunk size (0 for default) */
+  load_hook element_hook;       /**< Hook for loaded elements */
+  load_hook tree_hook;          /**< Hook for loaded trees */
+  void *volatile shared;        /**< Lock-free list of free parsers */
+  void *volatile caches;        /**< All the per-thread caches */
+#if defined(SCEW_SINGLE_THREADED_)
+  parser_cache *cache;          /**< The only cache */
+#elif defined(_MSC_VER)
+  DWORD cache_key;              /**< FLS index of the thread cache */
+#else
+  pthread_key_t cache_key;      /**< Key of the thread cache */
+#endif
+};
+
+static scew_parser_pool* pool_create_ (scew_bool namespace,
+                                       XML_Char separator);
+static void pool_configure_ (scew_parser_pool *pool, scew_parser *parser);
+static parser_cache* pool_cache_ (scew_parser_pool *pool);
+#if defined(SCEW_SINGLE_THREADED_)
+#elif defined(_MSC_VER)
+static VOID WINAPI cache_release_ (PVOID data);
+#else
+static void cache_release_ (void *data);
+#endif
+static void shared_push_ (scew_parser_pool *pool,
+                          scew_parser *first,
+                          scew_parser *last);
+static scew_parser* shared_pop_ (scew_parser_pool *pool,
+                                 parser_cache *cache);
+
+
+/* Public */
+
+scew_parser_pool*
+scew_parser_pool_create (void)
+{
+  return pool_create_ (SCEW_FALSE, 0);
+}
+
+scew_parser_pool*
+scew_parser_pool_namespace_create (XML_Char separator)
+{
+  return pool_create_ (SCEW_TRUE, separator);
+}
+
+void
+scew_parser_pool_free (scew_parser_pool *pool)
+{
+  if (pool != NULL)
+    {
+      scew_parser *parser = NULL;
+      parser_cache *cache = NULL;
+
+#if defined(SCEW_SINGLE_THREADED_)
+#elif defined(_MSC_VER)
+      /* This releases the caches of running threads, unlike pthreads. */
+      FlsFree (pool->cache_key);
+#else
+      /* Thread exit destructors will not run after this. */
+      pthread_key_delete (pool->cache_key);
+#endif
+
+      parser = pool->shared;
+      cache = pool->caches;
+
+      while (parser != NULL)
+        {
+          scew_parser *next = parser->pool_next;
+          scew_parser_free (parser);
+          parser = next;
+        }
+
+      while (cache != NULL)
+        {
+          parser_cache *next = cache->next;
+          while (cache->count > 0)
+            {
+              scew_parser_free (cache->parsers[--cache->count]);
+            }
+          free (cache);
+          cache = next;
+        }
+
+      free (pool);
+    }
+}
+
+void
+scew_parser_pool_set_element_hook (scew_parser_pool *pool,
+                                   scew_parser_load_hook hook,
+                                   void *user_data)
+{
+  assert (pool != NULL);
+
+  pool->element_hook.hook = hook;
+  pool->element_hook.data = user_data;
+}
+
+void
+scew_parser_pool_set_tree_hook (scew_parser_pool *pool,
+                                scew_parser_load_hook hook,
+                                void *user_data)
+{
+  assert (pool != NULL);
+
+  pool->tree_hook.hook = hook;
+  pool->tree_hook.data = user_data;
+}
+
+void
+scew_parser_pool_ignore_whitespaces (scew_parser_pool *pool, scew_bool ignore)
+{
+  assert (pool != NULL);
+
+  pool->ignore_whitespaces = ignore;
+}
+
+void
+scew_parser_pool_set_buffer_size (scew_parser_pool *pool, size_t size)
+{
+  assert (pool != NULL);
+  assert (size > 0);
+
+  pool->buffer_size = size;
+}
+
+void
+scew_parser_pool_set_arena (scew_parser_pool *pool, scew_bool use_arena)
+{
+  assert (pool != NULL);
+
+  pool->use_arena = use_arena;
+}
+
+scew_parser*
+scew_parser_pool_acquire (scew_parser_pool *pool)
+{
+  scew_parser *parser = NULL;
+  parser_cache *cache = NULL;
+
+  assert (pool != NULL);
+
+  cache = pool_cache_ (pool);
+
+  if ((cache != NULL) && (cache->count > 0))
+    {
+      parser = cache->parsers[--cache->count];
+    }
+  else
+    {
+      parser = shared_pop_ (pool, cache);
+    }
+
+  if (NULL == parser)
+    {
+      parser = pool->namespace
+        ? scew_parser_namespace_create (pool->separator)
+        : scew_parser_create ();
+
+      if (parser != NULL)
+        {
+          pool_configure_ (pool, parser);
+        }
+    }
+
+  return parser;
+}
+
+void
+scew_parser_pool_release (scew_parser_pool *pool, scew_parser *parser)
+{
+  parser_cache *cache = NULL;
+
+  assert (pool != NULL);
+  assert (parser != NULL);
+
+  /* Leave the parser ready for the next acquire. */
+  scew_parser_reset (parser);
+  pool_configure_ (pool, parser);
+
+  cache = pool_cache_ (pool);
+
+  if ((cache != NULL) && (cache->count < CACHE_SIZE_))
+    {
+      cache->parsers[cache->count++] = parser;
+    }
+  else
+    {
+      shared_push_ (pool, parser, parser);
+    }
+}
+
+
+/* Private */
+
+scew_parser_pool*
+pool_create_ (scew_bool namespace, XML_Char separator)
+{
+  scew_parser_pool *pool = calloc (1, sizeof (scew_parser_pool));
+
+  if (NULL == pool)
+    {
+      scew_error_set_last_error_ (scew_error_no_memory);
+      return NULL;
+    }
+
+  pool->namespace = namespace;
+  pool->separator = separator;
+
+  /* Same defaults as scew_parser_create. */
+  pool->ignore_whitespaces = SCEW_TRUE;
+  pool->use_arena = SCEW_FALSE;
+  pool->buffer_size = 0;
+
+#if defined(SCEW_SINGLE_THREADED_)
+#elif defined(_MSC_VER)
+  /* Unlike TLS, FLS runs a callback when threads finish. */
+  pool->cache_key = FlsAlloc (cache_release_);
+  if (FLS_OUT_OF_INDEXES == pool->cache_key)
+    {
+      scew_error_set_last_error_ (scew_error_no_memory);
+      free (pool);
+      pool = NULL;
+    }
+#else
+  if (pthread_key_create (&pool->cache_key, cache_release_) != 0)
+    {
+      scew_error_set_last_error_ (scew_error_no_memory);
+      free (pool);
+      pool = NULL;
+    }
+#endif
+
+  return pool;
+}
+
+void
+pool_configure_ (scew_parser_pool *pool, scew_parser *parser)
+{
+  scew_parser_ignore_whitespaces (parser, pool->ignore_whitespaces);
+  scew_parser_set_arena (parser, pool->use_arena);
+  if (pool->buffer_size > 0)
+    {
+      scew_parser_set_buffer_size (parser, pool->buffer_size);
+    }
+  scew_parser_set_element_hook (parser,
+                                pool->element_hook.hook,
+                                pool->element_hook.data);
+  scew_parser_set_tree_hook (parser,
+                             pool->tree_hook.hook,
+                             pool->tree_hook.data);
+  scew_parser_set_consume_hook (parser, NULL, NULL);
+  scew_parser_set_filter_hook (parser, NULL, NULL);
+}
+
+parser_cache*
+pool_cache_ (scew_parser_pool *pool)
+{
+  parser_cache *cache = NULL;
+
+#if defined(SCEW_SINGLE_THREADED_)
+  cache = pool->cache;
+#elif defined(_MSC_VER)
+  cache = FlsGetValue (pool->cache_key);
+#else
+  cache = pthread_getspecific (pool->cache_key);
+#endif
+
+  if (cache != NULL)
+    {
+      return cache;
+    }
+
+  /* Reuse the cache of a finished thread, if any. */
+  cache = scew_atomic_load_ (&pool->caches);
+  for (; cache != NULL; cache = cache->next)
+    {
+      if ((NULL == scew_atomic_load_ (&cache->owned))
+          && scew_atomic_cas_ (&cache->owned, NULL, pool))
+        {
+          break;
+        }
+    }
+
+  if (NULL == cache)
+    {
+      cache = calloc (1, sizeof (parser_cache));
+      if (NULL == cache)
+        {
+          /* We can still work with the shared list. */
+          return NULL;
+        }
+
+      cache->pool = pool;
+      cache->owned = pool;
+      do
+        {
+          cache->next = scew_atomic_load_ (&pool->caches);
+        }
+      while (!scew_atomic_cas_ (&pool->caches, cache->next, cache));
+    }
+
+#if defined(SCEW_SINGLE_THREADED_)
+  pool->cache = cache;
+#elif defined(_MSC_VER)
+  FlsSetValue (pool->cache_key, cache);
+#else
+  pthread_setspecific (pool->cache_key, cache);
+#endif
+
+  return cache;
+}
+
+#if !defined(SCEW_SINGLE_THREADED_)
+#if defined(_MSC_VER)
+VOID WINAPI
+cache_release_ (PVOID data)
+#else
+void
+cache_release_ (void *data)
+#endif /* _MSC_VER */
+{
+  parser_cache *cache = data;
+
+  /* The thread is finishing, move its parsers to the shared list. */
+  while (cache->count > 0)
+    {
+      scew_parser *parser = cache->parsers[--cache->count];
+      shared_push_ (cache->pool, parser, parser);
+    }
+
+  scew_atomic_cas_ (&cache->owned, cache->pool, NULL);
+}
+#endif /* SCEW_SINGLE_THREADED_ */
+
+void
+shared_push_ (scew_parser_pool *pool, scew_parser *first, scew_parser *last)
+{
+  void *head = NULL;
+
+  do
+    {
+      head = scew_atomic_load_ (&pool->shared);
+      last->pool_next = head;
+    }
+  while (!scew_atomic_cas_ (&pool->shared, head, first));
+}
+
+scew_parser*
+shared_pop_ (scew_parser_pool *pool, parser_cache *cache)
+{
+  unsigned int i = 0;
+  scew_parser *last = NULL;
+  scew_parser *added = NULL;
+  scew_parser *parser = NULL;
+
+  /**
+   * Popping a single node from a lock-free list suffers from the ABA
+   * problem, so we take the whole list instead, keep what fits in the
+   * thread cache and give the rest back. Meanwhile, other threads
+   * find the list empty, so they check it again for a while before
+   * creating a new parser.
+   */
+  scew_parser *list = scew_atomic_take_ (&pool->shared);
+  for (i = 0; (NULL == list) && (i < SHARED_SPINS_); ++i)
+    {
+      if (scew_atomic_load_ (&pool->shared) != NULL)
+        {
+          list = scew_atomic_take_ (&pool->shared);
+        }
+    }
+
+  if (NULL == list)
+    {
+      return NULL;
+    }
+
+  parser = list;
+  list = list->pool_next;
+  parser->pool_next = NULL;
+
+  while ((list != NULL) && (cache != NULL) && (cache->count < CACHE_SIZE_))
+    {
+      cache->parsers[cache->count++] = list;
+      list = list->pool_next;
+    }
+
+  /**
+   * The shared list is usually still empty, so the rest is given back
+   * at once. Otherwise, only the parsers released meanwhile (usually
+   * a few) are walked to append the rest to them.
+   */
+  while ((list != NULL) && !scew_atomic_cas_ (&pool->shared, NULL, list))
+    {
+      added = scew_atomic_take_ (&pool->shared);
+      if (added != NULL)
+        {
+          for (last = added; last->pool_next != NULL; last = last->pool_next)
+            {
+            }
+          last->pool_next = list;
+          list = added;
+        }
+    }
+
+  return parser;
+}
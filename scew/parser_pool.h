@@ -0,0 +1,215 @@
+/**
+ * @file     parser_pool.h
+ * @brief    SCEW parser pools
+ * @author   Aleix Conchillo Flaque <aconchillo@gmail.com>
+ * @date     Sun Oct 18, 2026 10:12
+ * @ingroup  SCEWParserPool
+ *
+ * @if copyright
+ *
+ * Copyright (C) 2026 Aleix Conchillo Flaque
+ *
+ * SCEW is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * SCEW is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ *
+ * @endif
+ */
+
+/**
+ * @defgroup SCEWParserPool Parser pools
+ *
+ * A parser pool hands out ready to use parsers, all of them with the
+ * same configuration, and takes them back once they are not needed
+ * anymore. This avoids creating and freeing a parser for each XML
+ * document, for example in servers that load many small documents
+ * from different threads.
+ *
+ * Released parsers are first kept in a small per-thread cache, so a
+ * thread usually gets back the parser it just released without any
+ * synchronization. Surplus parsers go to a lock-free list shared by
+ * all threads, and so do the cached parsers of finished threads.
+ */
+
+#ifndef PARSER_POOL_H_2610181012
+#define PARSER_POOL_H_2610181012
+
+#include "export.h"
+
+#include "bool.h"
+#include "parser.h"
+
+#include <expat.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * This is the type declaration of SCEW parser pools.
+ *
+ * @ingroup SCEWParserPool
+ */
+typedef struct scew_parser_pool scew_parser_pool;
+
+
+/**
+ * @defgroup SCEWParserPoolAlloc Allocation
+ * Allocate and free parser pools.
+ * @ingroup SCEWParserPool
+ */
+
+/**
+ * Creates a new parser pool. Parsers of this pool are created with
+ * #scew_parser_create.
+ *
+ * @return a new parser pool, or NULL if the pool could not be
+ * created.
+ *
+ * @ingroup SCEWParserPoolAlloc
+ */
+extern SCEW_API scew_parser_pool* scew_parser_pool_create (void);
+
+/**
+ * Creates a new parser pool with namespaces support. Parsers of this
+ * pool are created with #scew_parser_namespace_create and the given
+ * @a separator.
+ *
+ * @return a new parser pool, or NULL if the pool could not be
+ * created.
+ *
+ * @ingroup SCEWParserPoolAlloc
+ */
+extern SCEW_API scew_parser_pool*
+scew_parser_pool_namespace_create (XML_Char separator);
+
+/**
+ * Frees a parser @a pool and all the parsers it holds. All the parsers
+ * acquired from the pool must have been released before, and no
+ * other thread might be using the pool. If a NULL @a pool is given,
+ * this function takes no action.
+ *
+ * @ingroup SCEWParserPoolAlloc
+ */
+extern SCEW_API void scew_parser_pool_free (scew_parser_pool *pool);
+
+
+/**
+ * @defgroup SCEWParserPoolConfig Configuration
+ * Configure the parsers handed out by a pool. These functions are
+ * not thread-safe and must be called before any parser is acquired.
+ * @ingroup SCEWParserPool
+ */
+
+/**
+ * Sets the element @a hook of the pool parsers (see
+ * #scew_parser_set_element_hook).
+ *
+ * @pre pool != NULL
+ *
+ * @ingroup SCEWParserPoolConfig
+ */
+extern SCEW_API void
+scew_parser_pool_set_element_hook (scew_parser_pool *pool,
+                                   scew_parser_load_hook hook,
+                                   void *user_data);
+
+/**
+ * Sets the tree @a hook of the pool parsers (see
+ * #scew_parser_set_tree_hook).
+ *
+ * @pre pool != NULL
+ *
+ * @ingroup SCEWParserPoolConfig
+ */
+extern SCEW_API void
+scew_parser_pool_set_tree_hook (scew_parser_pool *pool,
+                                scew_parser_load_hook hook,
+                                void *user_data);
+
+/**
+ * Tells the pool parsers how to treat white spaces (see
+ * #scew_parser_ignore_whitespaces).
+ *
+ * @pre pool != NULL
+ *
+ * @ingroup SCEWParserPoolConfig
+ */
+extern SCEW_API void
+scew_parser_pool_ignore_whitespaces (scew_parser_pool *pool, scew_bool ignore);
+
+/**
+ * Sets the number of characters the pool parsers read at once (see
+ * #scew_parser_set_buffer_size).
+ *
+ * @pre pool != NULL
+ * @pre size > 0
+ *
+ * @ingroup SCEWParserPoolConfig
+ */
+extern SCEW_API void scew_parser_pool_set_buffer_size (scew_parser_pool *pool,
+                                                       size_t size);
+
+/**
+ * Tells the pool parsers whether to allocate loaded trees in an arena
+ * (see #scew_parser_set_arena).
+ *
+ * @pre pool != NULL
+ *
+ * @ingroup SCEWParserPoolConfig
+ */
+extern SCEW_API void scew_parser_pool_set_arena (scew_parser_pool *pool,
+                                                 scew_bool use_arena);
+
+
+/**
+ * @defgroup SCEWParserPoolUse Usage
+ * Acquire and release parsers. These functions might be called from
+ * different threads at the same time.
+ * @ingroup SCEWParserPool
+ */
+
+/**
+ * Acquires a parser from the given @a pool. The parser is reset and
+ * configured as specified by the pool. A new parser is only created
+ * if the pool has no parsers left.
+ *
+ * @pre pool != NULL
+ *
+ * @return a ready to use parser, or NULL if a new parser could not be
+ * created.
+ *
+ * @ingroup SCEWParserPoolUse
+ */
+extern SCEW_API scew_parser* scew_parser_pool_acquire (scew_parser_pool *pool);
+
+/**
+ * Gives a @a parser, previously acquired from the same @a pool, back
+ * to the @a pool. The parser is reset (see #scew_parser_reset) and
+ * its configuration restored, so any change made to the parser (e.g.
+ * hooks) is lost. The parser must not be used after this call.
+ *
+ * @pre pool != NULL
+ * @pre parser != NULL
+ *
+ * @ingroup SCEWParserPoolUse
+ */
+extern SCEW_API void scew_parser_pool_release (scew_parser_pool *pool,
+                                               scew_parser *parser);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* PARSER_POOL_H_2610181012 */
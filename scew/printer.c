@@ -29,10 +29,14 @@
 #include "printer.h"
 
 #include "xerror.h"
+#include "xthread.h"
 
 #include "str.h"
+#include "writer_growable.h"
+#include "xstr.h"
 
 #include <assert.h>
+#include <string.h>
 
 
 /* Private */
@@ -46,18 +50,127 @@
 
 enum
   {
-    DEFAULT_INDENT_SPACES_ = 3  /**< Default number of indent spaces */
+    DEFAULT_INDENT_SPACES_ = 3, /**< Default number of indent spaces */
+    OUTPUT_BUFFER_SIZE_ = 8192, /**< Characters buffered before writing */
+    PARALLEL_PIECES_ = 16,      /**< Pieces children are split in, per
+                                   thread */
+    PARALLEL_RANGE_SIZE_ = 256, /**< Maximum siblings in a piece */
+    PARALLEL_BATCH_SIZE_ = 4    /**< Pieces printed at once, per thread */
   };
 
+/* Length of a string literal (or array), without the terminating
+   null character. */
+#define LITERAL_LENGTH_(s) (sizeof (s) / sizeof (XML_Char) - 1)
+
+/* Appends a string literal (or array) without computing its length. */
+#define print_literal_(printer, s) \
+  print_span_ ((printer), (s), LITERAL_LENGTH_ (s))
+
+/* Spaces used to write indentation in a few big spans. */
+static XML_Char const SPACES_[] =
+  _XT("                                                                ");
+
 struct scew_printer
 {
   scew_bool indented;
   unsigned int indent;
   unsigned int spaces;
+  unsigned int threads;
   scew_writer *writer;
+  size_t used;
+  XML_Char buffer[OUTPUT_BUFFER_SIZE_];
 };
 
+/**
+ * An element printed by the calling thread around the pieces its
+ * children are split in. The pieces of an element are contiguous and
+ * in document order.
+ */
+typedef struct
+{
+  scew_element const *element;  /**< Element to print */
+  unsigned int depth;           /**< Depth below the first top element */
+  unsigned int first_piece;     /**< First piece of its children */
+  unsigned int n_pieces;        /**< Number of pieces of its children */
+} print_top_;
+
+/**
+ * A piece of the children of a top element: either a range of
+ * siblings printed by a worker, or a single child which is a top
+ * element itself.
+ */
+typedef struct
+{
+  unsigned int parent;          /**< Top element of the siblings' parent */
+  unsigned int first;           /**< First sibling of the range */
+  unsigned int count;           /**< Number of siblings (0 if a top) */
+  unsigned int top;             /**< Top element (only if count is 0) */
+  unsigned int owner;           /**< Worker that printed the range */
+  size_t start;                 /**< Output start of the range */
+  size_t length;                /**< Output length of the range */
+} print_piece_;
+
+/**
+ * Children of an element printed in parallel. Children are split in
+ * pieces as in a parallel copy (see element_copy.c), expanding
+ * elements with few children, so big subtrees are split too. Each
+ * worker prints whole ranges into its own growable writer, and the
+ * output is then copied in document order.
+ */
+typedef struct
+{
+  print_top_ *tops;             /**< Elements printed around pieces */
+  unsigned int n_tops;          /**< Number of top elements */
+  unsigned int tops_size;       /**< Allocated top elements */
+  print_piece_ *pieces;         /**< Pieces of the top elements */
+  unsigned int n_pieces;        /**< Number of pieces */
+  unsigned int pieces_size;     /**< Allocated pieces */
+  unsigned int *ranges;         /**< Range pieces in document order */
+  unsigned int n_ranges;        /**< Number of range pieces */
+  unsigned int first;           /**< First range of the current batch */
+  unsigned int count;           /**< Number of ranges in the batch */
+  unsigned int n_threads;       /**< Number of workers */
+  unsigned int indent;          /**< Indentation of the first top */
+  size_t volatile next;         /**< Next range (in the batch) to print */
+  size_t volatile next_worker;  /**< Next worker identifier */
+  scew_printer **printers;      /**< Printer of each worker */
+  scew_writer **writers;        /**< Growable writer of each worker */
+  scew_bool volatile failed;    /**< Whether any worker failed */
+} parallel_print_;
+
 static scew_bool print_write_ (scew_printer *printer, XML_Char const *data);
+static scew_bool print_span_ (scew_printer *printer,
+                              XML_Char const *data,
+                              size_t length);
+static scew_bool print_flush_ (scew_printer *printer);
+static scew_bool print_element_ (scew_printer *printer,
+                                 scew_element const *element);
+static scew_bool print_element_head_ (scew_printer *printer,
+                                      scew_element const *element,
+                                      scew_bool *closed);
+static scew_bool print_children_ (scew_printer *printer,
+                                  scew_element const *element);
+static scew_bool print_attributes_ (scew_printer *printer,
+                                    scew_element const *element);
+static scew_bool print_children_parallel_ (scew_printer *printer,
+                                           scew_element const *element);
+static scew_bool split_print_ (parallel_print_ *job,
+                               scew_element const *element,
+                               unsigned int n_pieces);
+static scew_bool add_print_top_ (parallel_print_ *job,
+                                 scew_element const *element,
+                                 unsigned int depth);
+static scew_bool add_print_piece_ (parallel_print_ *job,
+                                   unsigned int parent,
+                                   unsigned int first,
+                                   unsigned int count);
+static void order_ranges_ (parallel_print_ *job, unsigned int top);
+static scew_bool print_top_pieces_ (scew_printer *printer,
+                                    parallel_print_ *job,
+                                    unsigned int top,
+                                    unsigned int *next_range);
+static scew_bool print_batch_ (parallel_print_ *job);
+static void print_children_worker_ (void *data);
 static scew_bool print_pi_start_ (scew_printer *printer, XML_Char const *pi);
 static scew_bool print_pi_end_ (scew_printer *printer);
 static scew_bool print_attribute_ (scew_printer *printer,
@@ -93,6 +206,7 @@ scew_printer_create (scew_writer *writer)
 
       scew_printer_set_indented (printer, SCEW_TRUE);
       scew_printer_set_indentation (printer, DEFAULT_INDENT_SPACES_);
+      scew_printer_set_threads (printer, 1);
     }
 
   return printer;
@@ -137,6 +251,14 @@ scew_printer_set_indentation (scew_printer *printer, unsigned int spaces)
   printer->spaces = spaces;
 }
 
+void
+scew_printer_set_threads (scew_printer *printer, unsigned int n_threads)
+{
+  assert (printer != NULL);
+
+  printer->threads = (0 == n_threads) ? scew_thread_count_ () : n_threads;
+}
+
 scew_bool
 scew_printer_print_tree (scew_printer *printer, scew_tree const *tree)
 {
@@ -190,8 +312,11 @@ scew_printer_print_tree (scew_printer *printer, scew_tree const *tree)
     }
 
   /* Print XML document. */
-  result = result && scew_printer_print_element (printer,
-                                                 scew_tree_root (tree));
+  result = result && print_element_ (printer, scew_tree_root (tree));
+
+  /* The whole document is written, send any buffered data. */
+  result = result && print_flush_ (printer);
+  result = result && scew_writer_flush (printer->writer);
 
   if (!result)
     {
@@ -203,6 +328,135 @@ scew_printer_print_tree (scew_printer *printer, scew_tree const *tree)
 
 scew_bool
 scew_printer_print_element (scew_printer *printer, scew_element const *element)
+{
+  scew_bool result = SCEW_TRUE;
+
+  assert (printer != NULL);
+  assert (element != NULL);
+
+  result = print_element_ (printer, element) && print_flush_ (printer);
+  result = result && scew_writer_flush (printer->writer);
+
+  if (!result)
+    {
+      scew_error_set_last_error_ (scew_error_io);
+    }
+
+  return result;
+}
+
+scew_bool
+scew_printer_print_element_children (scew_printer *printer,
+                                     scew_element const  *element)
+{
+  scew_bool result = SCEW_TRUE;
+
+  assert (printer != NULL);
+  assert (element != NULL);
+
+  result = print_children_ (printer, element) && print_flush_ (printer);
+  result = result && scew_writer_flush (printer->writer);
+
+  if (!result)
+    {
+      scew_error_set_last_error_ (scew_error_io);
+    }
+
+  return result;
+}
+
+
+scew_bool
+scew_printer_print_element_attributes (scew_printer *printer,
+                                      scew_element const *element)
+{
+  scew_bool result = SCEW_TRUE;
+
+  assert (printer != NULL);
+  assert (element != NULL);
+
+  result = print_attributes_ (printer, element) && print_flush_ (printer);
+  result = result && scew_writer_flush (printer->writer);
+
+  if (!result)
+    {
+      scew_error_set_last_error_ (scew_error_io);
+    }
+
+  return result;
+}
+
+scew_bool
+scew_printer_print_attribute (scew_printer *printer,
+                             scew_attribute const *attribute)
+{
+  scew_bool result = SCEW_TRUE;
+
+  assert (printer != NULL);
+  assert (attribute != NULL);
+
+  result = print_attribute_ (printer,
+                             scew_attribute_name (attribute),
+                             scew_attribute_value (attribute));
+  result = result && print_flush_ (printer);
+  result = result && scew_writer_flush (printer->writer);
+
+  if (!result)
+    {
+      scew_error_set_last_error_ (scew_error_io);
+    }
+
+  return result;
+}
+
+
+
+/* Private */
+
+scew_bool
+print_write_ (scew_printer *printer, XML_Char const *data)
+{
+  return print_span_ (printer, data, scew_strlen (data));
+}
+
+scew_bool
+print_span_ (scew_printer *printer, XML_Char const *data, size_t length)
+{
+  scew_bool result = SCEW_TRUE;
+
+  if (printer->used + length > OUTPUT_BUFFER_SIZE_)
+    {
+      result = print_flush_ (printer);
+    }
+
+  if (result && (length >= OUTPUT_BUFFER_SIZE_))
+    {
+      /* Too big to be buffered, write it directly. */
+      result = (scew_writer_write (printer->writer, data, length) == length);
+    }
+  else if (result)
+    {
+      memcpy (printer->buffer + printer->used, data,
+              length * sizeof (XML_Char));
+      printer->used += length;
+    }
+
+  return result;
+}
+
+scew_bool
+print_flush_ (scew_printer *printer)
+{
+  size_t used = printer->used;
+
+  printer->used = 0;
+
+  return (0 == used)
+    || (scew_writer_write (printer->writer, printer->buffer, used) == used);
+}
+
+scew_bool
+print_element_ (scew_printer *printer, scew_element const *element)
 {
   scew_bool result = SCEW_TRUE;
   scew_bool closed = SCEW_TRUE;
@@ -210,9 +464,31 @@ scew_printer_print_element (scew_printer *printer, scew_element const *element)
   assert (printer != NULL);
   assert (element != NULL);
 
-  result = print_element_start_ (printer, element, &closed);
+  result = print_element_head_ (printer, element, &closed);
 
   if (!closed)
+    {
+      result = result && print_children_ (printer, element);
+      result = result && print_element_end_ (printer, element);
+      result = result && print_eol_ (printer);
+    }
+
+  return result;
+}
+
+scew_bool
+print_element_head_ (scew_printer *printer,
+                     scew_element const *element,
+                     scew_bool *closed)
+{
+  scew_bool result = SCEW_TRUE;
+
+  assert (printer != NULL);
+  assert (element != NULL);
+
+  result = print_element_start_ (printer, element, closed);
+
+  if (!*closed)
     {
       XML_Char const *contents = scew_element_contents (element);
 
@@ -237,131 +513,401 @@ scew_printer_print_element (scew_printer *printer, scew_element const *element)
               result = result && print_eol_ (printer);
             }
         }
-
-      result = result && scew_printer_print_element_children (printer,
-                                                              element);
-      result = result && print_element_end_ (printer, element);
-      result = result && print_eol_ (printer);
-    }
-
-  if (!result)
-    {
-      scew_error_set_last_error_ (scew_error_io);
     }
 
   return result;
 }
 
 scew_bool
-scew_printer_print_element_children (scew_printer *printer,
-                                     scew_element const  *element)
+print_children_ (scew_printer *printer, scew_element const *element)
 {
+  unsigned int i = 0;
+  unsigned int count = 0;
   unsigned int indent = 0;
-  scew_list *list = NULL;
   scew_bool result = SCEW_TRUE;
 
   assert (printer != NULL);
   assert (element != NULL);
 
+  count = scew_element_count (element);
+  if ((printer->threads > 1) && (count > 1))
+    {
+      return print_children_parallel_ (printer, element);
+    }
+
   indent = printer->indent;
 
-  list = scew_element_children (element);
-  while (result && (list != NULL))
+  for (i = 0; result && (i < count); ++i)
     {
-      scew_element *child = scew_list_data (list);
+      scew_element *child = scew_element_by_index (element, i);
 
       printer->indent = indent + 1;
 
-      result = scew_printer_print_element (printer, child);
-      list = scew_list_next (list);
+      result = print_element_ (printer, child);
     }
 
   printer->indent = indent;
 
-  if (!result)
+  return result;
+}
+
+scew_bool
+print_children_parallel_ (scew_printer *printer, scew_element const *element)
+{
+  unsigned int i = 0;
+  unsigned int next_range = 0;
+  unsigned int indent = printer->indent;
+  scew_bool result = SCEW_TRUE;
+  parallel_print_ job;
+
+  memset (&job, 0, sizeof (job));
+  job.indent = indent;
+
+  result = split_print_ (&job, element, PARALLEL_PIECES_ * printer->threads);
+
+  if (result)
     {
-      scew_error_set_last_error_ (scew_error_io);
+      job.n_threads = (printer->threads < job.n_ranges)
+        ? printer->threads : job.n_ranges;
+      job.ranges = calloc (job.n_ranges, sizeof (unsigned int));
+      job.printers = calloc (job.n_threads, sizeof (scew_printer *));
+      job.writers = calloc (job.n_threads, sizeof (scew_writer *));
+      result = (job.ranges != NULL) && (job.printers != NULL)
+        && (job.writers != NULL);
+    }
+
+  for (i = 0; result && (i < job.n_threads); ++i)
+    {
+      job.writers[i] = scew_writer_growable_create (0);
+      job.printers[i] = (job.writers[i] != NULL)
+        ? scew_printer_create (job.writers[i])
+        : NULL;
+      result = (job.printers[i] != NULL);
+      if (result)
+        {
+          job.printers[i]->indented = printer->indented;
+          job.printers[i]->spaces = printer->spaces;
+        }
     }
 
+  if (result)
+    {
+      job.n_ranges = 0;
+      order_ranges_ (&job, 0);
+      result = print_top_pieces_ (printer, &job, 0, &next_range);
+    }
+
+  printer->indent = indent;
+
+  for (i = 0; (job.printers != NULL) && (i < job.n_threads); ++i)
+    {
+      scew_printer_free (job.printers[i]);
+      if (job.writers[i] != NULL)
+        {
+          scew_writer_free (job.writers[i]);
+        }
+    }
+  free (job.printers);
+  free (job.writers);
+  free (job.ranges);
+  free (job.pieces);
+  free (job.tops);
+
   return result;
 }
 
+scew_bool
+split_print_ (parallel_print_ *job, scew_element const *element,
+              unsigned int n_pieces)
+{
+  unsigned int i = 0;
+
+  if (!add_print_top_ (job, element, 0))
+    {
+      return SCEW_FALSE;
+    }
+
+  /**
+   * Expand top elements breadth-first, until there are enough pieces
+   * to keep all threads busy. Elements with many children have their
+   * children split in ranges instead, which are kept short so only a
+   * few children per thread are printed in memory at once.
+   */
+  for (i = 0; i < job->n_tops; ++i)
+    {
+      scew_element const *top = job->tops[i].element;
+      unsigned int n_children = scew_element_count (top);
+      unsigned int step = (n_children + n_pieces - 1) / n_pieces;
+      unsigned int first = 0;
+
+      step = (step < PARALLEL_RANGE_SIZE_) ? step : PARALLEL_RANGE_SIZE_;
+
+      job->tops[i].first_piece = job->n_pieces;
+      for (first = 0; first < n_children; first += step)
+        {
+          unsigned int count = n_children - first;
+          scew_element const *child = scew_element_by_index (top, first);
+          scew_bool added = SCEW_FALSE;
+
+          count = (count < step) ? count : step;
+          if ((1 == count) && (scew_element_count (child) > 0)
+              && (job->n_ranges + job->n_tops - i < n_pieces))
+            {
+              added = add_print_top_ (job, child, job->tops[i].depth + 1)
+                && add_print_piece_ (job, i, first, 0);
+            }
+          else
+            {
+              added = add_print_piece_ (job, i, first, count);
+            }
+
+          if (!added)
+            {
+              return SCEW_FALSE;
+            }
+        }
+      job->tops[i].n_pieces = job->n_pieces - job->tops[i].first_piece;
+    }
+
+  return SCEW_TRUE;
+}
 
 scew_bool
-scew_printer_print_element_attributes (scew_printer *printer,
-                                      scew_element const *element)
+add_print_top_ (parallel_print_ *job, scew_element const *element,
+                unsigned int depth)
 {
-  scew_bool result = SCEW_TRUE;
-  scew_list *list = NULL;
+  if (job->n_tops == job->tops_size)
+    {
+      unsigned int size = (0 == job->tops_size) ? 16 : 2 * job->tops_size;
+      print_top_ *tops = realloc (job->tops, size * sizeof (print_top_));
+      if (NULL == tops)
+        {
+          return SCEW_FALSE;
+        }
+      job->tops = tops;
+      job->tops_size = size;
+    }
 
-  assert (printer != NULL);
-  assert (element != NULL);
+  job->tops[job->n_tops].element = element;
+  job->tops[job->n_tops].depth = depth;
+  job->tops[job->n_tops].first_piece = 0;
+  job->tops[job->n_tops].n_pieces = 0;
+  job->n_tops += 1;
 
-  list = scew_element_attributes (element);
-  while (result && (list != NULL))
+  return SCEW_TRUE;
+}
+
+scew_bool
+add_print_piece_ (parallel_print_ *job, unsigned int parent,
+                  unsigned int first, unsigned int count)
+{
+  print_piece_ *piece = NULL;
+
+  if (job->n_pieces == job->pieces_size)
     {
-      scew_attribute *attribute = scew_list_data (list);
-      result = scew_printer_print_attribute (printer, attribute);
-      list = scew_list_next (list);
+      unsigned int size =
+        (0 == job->pieces_size) ? 16 : 2 * job->pieces_size;
+      print_piece_ *pieces =
+        realloc (job->pieces, size * sizeof (print_piece_));
+      if (NULL == pieces)
+        {
+          return SCEW_FALSE;
+        }
+      job->pieces = pieces;
+      job->pieces_size = size;
     }
 
-  if (!result)
+  /* A piece with no siblings is the last top element added. */
+  piece = &job->pieces[job->n_pieces];
+  piece->parent = parent;
+  piece->first = first;
+  piece->count = count;
+  piece->top = (0 == count) ? job->n_tops - 1 : 0;
+  piece->owner = 0;
+  piece->start = 0;
+  piece->length = 0;
+  job->n_pieces += 1;
+
+  if (count > 0)
     {
-      scew_error_set_last_error_ (scew_error_io);
+      job->n_ranges += 1;
     }
 
-  return result;
+  return SCEW_TRUE;
+}
+
+void
+order_ranges_ (parallel_print_ *job, unsigned int top)
+{
+  print_top_ const *element = &job->tops[top];
+  unsigned int i = 0;
+
+  /* Top elements are only a few, so recursion is bounded. */
+  for (i = element->first_piece;
+       i < element->first_piece + element->n_pieces;
+       ++i)
+    {
+      if (0 == job->pieces[i].count)
+        {
+          order_ranges_ (job, job->pieces[i].top);
+        }
+      else
+        {
+          job->ranges[job->n_ranges++] = i;
+        }
+    }
 }
 
 scew_bool
-scew_printer_print_attribute (scew_printer *printer,
-                             scew_attribute const *attribute)
+print_top_pieces_ (scew_printer *printer, parallel_print_ *job,
+                   unsigned int top, unsigned int *next_range)
 {
+  print_top_ const *element = &job->tops[top];
   scew_bool result = SCEW_TRUE;
+  unsigned int i = 0;
 
-  assert (printer != NULL);
-  assert (attribute != NULL);
+  for (i = element->first_piece;
+       result && (i < element->first_piece + element->n_pieces);
+       ++i)
+    {
+      print_piece_ const *piece = &job->pieces[i];
 
-  result = print_attribute_ (printer,
-                             scew_attribute_name (attribute),
-                             scew_attribute_value (attribute));
+      if (0 == piece->count)
+        {
+          /* Top elements have children, so they are never closed. */
+          scew_element const *child = job->tops[piece->top].element;
+          scew_bool closed = SCEW_FALSE;
 
-  if (!result)
-    {
-      scew_error_set_last_error_ (scew_error_io);
+          printer->indent = job->indent + job->tops[piece->top].depth;
+          result = print_element_head_ (printer, child, &closed);
+          result = result && print_top_pieces_ (printer, job, piece->top,
+                                                next_range);
+
+          printer->indent = job->indent + job->tops[piece->top].depth;
+          result = result && print_element_end_ (printer, child);
+          result = result && print_eol_ (printer);
+        }
+      else
+        {
+          XML_Char const *output = NULL;
+
+          if ((*next_range == job->first + job->count)
+              && !print_batch_ (job))
+            {
+              return SCEW_FALSE;
+            }
+
+          output = scew_writer_growable_buffer (job->writers[piece->owner]);
+          result = print_span_ (printer, output + piece->start,
+                                piece->length);
+          *next_range += 1;
+        }
     }
 
   return result;
 }
 
+scew_bool
+print_batch_ (parallel_print_ *job)
+{
+  /* Ranges are printed in batches to bound memory usage. */
+  unsigned int i = 0;
+  unsigned int batch = PARALLEL_BATCH_SIZE_ * job->n_threads;
+
+  job->first += job->count;
+  job->count = ((job->n_ranges - job->first) < batch)
+    ? (job->n_ranges - job->first)
+    : batch;
+  job->next = 0;
+  job->next_worker = 0;
+  job->failed = SCEW_FALSE;
+
+  for (i = 0; i < job->n_threads; ++i)
+    {
+      scew_writer_growable_reset (job->writers[i]);
+    }
 
-
-/* Private */
+  scew_thread_run_ (job->n_threads, print_children_worker_, job);
+
+  return !job->failed;
+}
+
+void
+print_children_worker_ (void *data)
+{
+  parallel_print_ *job = data;
+  size_t index = 0;
+  size_t worker = scew_atomic_next_ (&job->next_worker);
+  scew_printer *printer = job->printers[worker];
+  scew_writer *writer = job->writers[worker];
+
+  while ((index = scew_atomic_next_ (&job->next)) < job->count)
+    {
+      print_piece_ *piece = &job->pieces[job->ranges[job->first + index]];
+      print_top_ const *parent = &job->tops[piece->parent];
+      unsigned int i = 0;
+
+      /* Worker printers continue at the children indentation level. */
+      printer->indent = job->indent + parent->depth + 1;
+
+      piece->owner = worker;
+      piece->start = scew_writer_growable_length (writer);
+
+      for (i = piece->first; i < piece->first + piece->count; ++i)
+        {
+          scew_element const *child =
+            scew_element_by_index (parent->element, i);
+
+          if (!print_element_ (printer, child))
+            {
+              job->failed = SCEW_TRUE;
+            }
+        }
+      if (!print_flush_ (printer))
+        {
+          job->failed = SCEW_TRUE;
+        }
+
+      piece->length = scew_writer_growable_length (writer) - piece->start;
+    }
+}
 
 scew_bool
-print_write_ (scew_printer *printer, XML_Char const *data)
+print_attributes_ (scew_printer *printer, scew_element const *element)
 {
-  scew_writer *writer = printer->writer;
+  scew_bool result = SCEW_TRUE;
+  scew_list *list = NULL;
 
-  size_t len = scew_strlen (data);
+  assert (printer != NULL);
+  assert (element != NULL);
 
-  return (scew_writer_write (writer, data, len) == len);
+  list = scew_element_attributes (element);
+  while (result && (list != NULL))
+    {
+      scew_attribute *attribute = scew_list_data (list);
+      result = print_attribute_ (printer,
+                                 scew_attribute_name (attribute),
+                                 scew_attribute_value (attribute));
+      list = scew_list_next (list);
+    }
+
+  return result;
 }
 
 scew_bool
 print_pi_start_ (scew_printer *printer, XML_Char const *pi)
 {
-  static XML_Char const *PI_START = _XT("<?");
+  static XML_Char const PI_START[] = _XT("<?");
 
-  return print_write_ (printer, PI_START) && print_write_ (printer, pi);
+  return print_literal_ (printer, PI_START) && print_write_ (printer, pi);
 }
 
 scew_bool
 print_pi_end_ (scew_printer *printer)
 {
-  static XML_Char const *PI_END = _XT("?>");
+  static XML_Char const PI_END[] = _XT("?>");
 
-  return print_write_ (printer, PI_END) && print_eol_ (printer);
+  return print_literal_ (printer, PI_END) && print_eol_ (printer);
 }
 
 scew_bool
@@ -371,9 +917,9 @@ print_attribute_ (scew_printer *printer,
 {
   scew_bool result = SCEW_FALSE;
 
-  result = print_write_ (printer, _XT(" "));
+  result = print_literal_ (printer, _XT(" "));
   result = result && print_write_ (printer, name);
-  result = result && print_write_ (printer, _XT("=\""));
+  result = result && print_literal_ (printer, _XT("=\""));
 
   /* It is possible that an attribute's value is empty. */
   if (scew_strlen (value) > 0)
@@ -381,7 +927,7 @@ print_attribute_ (scew_printer *printer,
       result = result && print_escaped_ (printer, value);
     }
 
-  result = result && print_write_ (printer, _XT("\""));
+  result = result && print_literal_ (printer, _XT("\""));
 
   return result;
 }
@@ -395,7 +941,7 @@ print_eol_ (scew_printer *printer)
 
   if (printer->indented)
     {
-      result = print_write_ (printer, _XT("\n"));
+      result = print_literal_ (printer, _XT("\n"));
     }
 
   return result;
@@ -422,11 +968,13 @@ print_indent_ (scew_printer *printer, unsigned int indent)
 
   if (printer->indented)
     {
-      unsigned int i = 0;
-      unsigned int spaces = indent * printer->spaces;
-      for (i = 0; result && (i < spaces); ++i)
+      size_t spaces = indent * printer->spaces;
+      while (result && (spaces > 0))
         {
-          result = print_write_ (printer, _XT(" "));
+          size_t length = (spaces < LITERAL_LENGTH_ (SPACES_))
+            ? spaces : LITERAL_LENGTH_ (SPACES_);
+          result = print_span_ (printer, SPACES_, length);
+          spaces -= length;
         }
     }
 
@@ -438,11 +986,11 @@ print_element_start_ (scew_printer *printer,
                       scew_element const *element,
                       scew_bool *closed)
 {
-  static XML_Char const *START = _XT("<");
-  static XML_Char const *END_1 = _XT(">");
-  static XML_Char const *END_2 = _XT("/>");
+  static XML_Char const START[] = _XT("<");
+  static XML_Char const END_1[] = _XT(">");
+  static XML_Char const END_2[] = _XT("/>");
 
-  scew_list *list = NULL;
+  unsigned int count = 0;
   XML_Char const *name = NULL;
   XML_Char const *contents = NULL;
   scew_bool result = SCEW_TRUE;
@@ -453,24 +1001,24 @@ print_element_start_ (scew_printer *printer,
   name = scew_element_name (element);
 
   result = print_current_indent_ (printer);
-  result = result && print_write_ (printer, START);
+  result = result && print_literal_ (printer, START);
   result = result && print_write_ (printer, name);
-  result = result && scew_printer_print_element_attributes (printer, element);
+  result = result && print_attributes_ (printer, element);
 
   contents = scew_element_contents (element);
 
   *closed = SCEW_FALSE;
-  list = scew_element_children (element);
-  if (((NULL == contents) || (scew_strlen (contents) == 0)) && (NULL == list))
+  count = scew_element_count (element);
+  if (((NULL == contents) || (scew_strlen (contents) == 0)) && (0 == count))
     {
-      result = result && print_write_ (printer, END_2);
+      result = result && print_literal_ (printer, END_2);
       result = result && print_eol_ (printer);
       *closed = SCEW_TRUE;
     }
   else
     {
-      result = result && print_write_ (printer, END_1);
-      if (list != NULL)
+      result = result && print_literal_ (printer, END_1);
+      if (count > 0)
         {
           result = result && print_eol_ (printer);
         }
@@ -482,8 +1030,8 @@ print_element_start_ (scew_printer *printer,
 scew_bool
 print_element_end_ (scew_printer *printer, scew_element const *element)
 {
-  static XML_Char const *START = _XT("</");
-  static XML_Char const *END = _XT(">");
+  static XML_Char const START[] = _XT("</");
+  static XML_Char const END[] = _XT(">");
 
   scew_bool result = SCEW_TRUE;
 
@@ -495,9 +1043,9 @@ print_element_end_ (scew_printer *printer, scew_element const *element)
     {
       result = print_current_indent_ (printer);
     }
-  result = result && print_write_ (printer, START);
+  result = result && print_literal_ (printer, START);
   result = result && print_write_ (printer, name);
-  result = result && print_write_ (printer, END);
+  result = result && print_literal_ (printer, END);
 
   return result;
 }
@@ -507,13 +1055,26 @@ print_escaped_ (scew_printer *printer, XML_Char const *string)
 {
   scew_bool result = SCEW_TRUE;
 
-  /* Get escaped string. */
-  XML_Char *escaped = scew_strescape (string);
+  size_t length = scew_strlen (string);
 
-  result = print_write_ (printer, escaped);
+  /* Escape straight into the output buffer, flushing it when full. */
+  while (result && (length > 0))
+    {
+      size_t written = 0;
+      size_t escaped =
+        scew_strescape_copy_ (printer->buffer + printer->used,
+                              OUTPUT_BUFFER_SIZE_ - printer->used,
+                              string, length, &written);
 
-  /* Free escaped string. */
-  free (escaped);
+      printer->used += written;
+      string += escaped;
+      length -= escaped;
+
+      if (length > 0)
+        {
+          result = print_flush_ (printer);
+        }
+    }
 
   return result;
 }
@@ -85,6 +85,10 @@ typedef struct scew_printer scew_printer;
  * calls. It is possible to re-use a SCEW printer by setting a new
  * writer via #scew_printer_set_writer.
  *
+ * The printer collects its output in an internal buffer and sends it
+ * to the writer in big blocks. All the buffered output is sent before
+ * any of the @ref SCEWPrinterOutput functions returns.
+ *
  * @pre writer != NULL
  *
  * @param writer the SCEW writer to be used by the putput functions.
@@ -142,6 +146,33 @@ extern SCEW_API void scew_printer_set_indented (scew_printer *printer,
 extern SCEW_API void scew_printer_set_indentation (scew_printer *printer,
                                                    unsigned int spaces);
 
+/**
+ * Sets the number of threads the given SCEW @a printer uses. By
+ * default, a printer uses only the calling thread.
+ *
+ * With more than one thread, the children of the first element with
+ * several children (usually the root element) are split across
+ * threads. Children with few children of their own are split
+ * further, so big subtrees are also shared among threads. Each thread
+ * prints ranges of siblings into its own memory buffer, and buffers
+ * are written to the printer writer in document order, so the output
+ * is the same as with a single thread. Ranges are printed in batches,
+ * so only the output of a bounded number of children per thread is
+ * kept in memory at once.
+ *
+ * Note that the printed elements must not be modified while printing.
+ *
+ * @pre printer != NULL
+ *
+ * @param printer the SCEW printer to set the threads for.
+ * @param n_threads the number of threads to use. If 0, the number of
+ * available processors is used.
+ *
+ * @ingroup SCEWPrinterProp
+ */
+extern SCEW_API void scew_printer_set_threads (scew_printer *printer,
+                                               unsigned int n_threads);
+
 
 /**
  * @defgroup SCEWPrinterOutput Output
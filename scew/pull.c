@@ -0,0 +1,521 @@
+/**
+ * @file     pull.c
+ * @brief    SCEW pull parser
+ * @author   Aleix Conchillo Flaque <aconchillo@gmail.com>
+ * @date     Sun Oct 18, 2026 10:12
+ *
+ * @if copyright
+ *
+ * Copyright (C) 2026 Aleix Conchillo Flaque
+ *
+ * SCEW is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * SCEW is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ *
+ * @endif
+ */
+
+#include "pull.h"
+
+#include "xparser.h"
+#include "xerror.h"
+
+#include "str.h"
+
+#include <assert.h>
+#include <stdlib.h>
+
+
+
+/* Private */
+
+enum
+  {
+    MIN_TAG_SIZE_ = 256,        /**< Initial characters of a tag */
+    MIN_TAG_STRINGS_ = 16       /**< Initial strings of a tag */
+  };
+
+struct scew_pull
+{
+  scew_parser *parser;          /**< Parser (and Expat parser) used */
+  scew_reader *reader;          /**< Reader of the document */
+  scew_pull_event event;        /**< Current event */
+  scew_pull_event pending;      /**< Tag found right after some text */
+  scew_bool has_pending;        /**< Whether there is a pending tag */
+  scew_bool empty_end;          /**< Whether the end tag of an empty
+                                   element is pending */
+  scew_bool found;              /**< Whether Expat found a new event */
+  unsigned int depth;           /**< Number of open elements */
+  XML_Char *tag;                /**< Name and attributes of the last tag */
+  size_t tag_size;              /**< Allocated characters for tag */
+  XML_Char const **strings;     /**< Name and attributes of the last tag
+                                   (NULL-terminated) */
+  unsigned int strings_size;    /**< Allocated strings */
+  unsigned int n_attributes;    /**< Attributes of the last tag */
+  scew_bool suspended;          /**< Whether Expat is suspended */
+  scew_bool final;              /**< Whether all data was given to Expat */
+};
+
+/**
+ * Expat callback for starting elements.
+ */
+static void start_handler_ (void *data,
+                            XML_Char const *name,
+                            XML_Char const **attrs);
+
+/**
+ * Expat callback for ending elements.
+ */
+static void end_handler_ (void *data, XML_Char const *name);
+
+/**
+ * Expat callback for character data.
+ */
+static void char_handler_ (void *data, XML_Char const *str, int len);
+
+/**
+ * Copies the given tag @a name and @a attrs, as they are only valid
+ * during Expat callbacks.
+ */
+static scew_bool store_tag_ (scew_pull *pull,
+                             XML_Char const *name,
+                             XML_Char const **attrs);
+
+/**
+ * Sets a new tag @a event (preceded by the text found before the tag,
+ * if any) and suspends Expat.
+ */
+static void found_tag_ (scew_pull *pull, scew_pull_event event);
+
+/**
+ * Gives data to Expat (or resumes it) until a new event is found.
+ */
+static scew_pull_event parse_ (scew_pull *pull);
+
+/**
+ * Reads more data from the reader and gives it to Expat.
+ */
+static enum XML_Status read_ (scew_pull *pull);
+
+
+
+/* Public */
+
+
+/* Allocation */
+
+scew_pull*
+scew_pull_create (scew_parser *parser, scew_reader *reader)
+{
+  scew_pull *pull = NULL;
+
+  assert (parser != NULL);
+  assert (reader != NULL);
+
+  pull = calloc (1, sizeof (scew_pull));
+  if (NULL == pull)
+    {
+      scew_error_set_last_error_ (scew_error_no_memory);
+      return NULL;
+    }
+
+  pull->parser = parser;
+  pull->reader = reader;
+  pull->event = scew_pull_start_element;
+
+  scew_parser_reset (parser);
+
+  /* Only tags and text are needed (no XML declaration or preamble). */
+  XML_SetXmlDeclHandler (parser->parser, NULL);
+  XML_SetDefaultHandlerExpand (parser->parser, NULL);
+  XML_SetElementHandler (parser->parser, start_handler_, end_handler_);
+  XML_SetCharacterDataHandler (parser->parser, char_handler_);
+  XML_SetUserData (parser->parser, pull);
+
+  return pull;
+}
+
+void
+scew_pull_free (scew_pull *pull)
+{
+  if (pull != NULL)
+    {
+      /* The parser can load trees again. */
+      scew_parser_reset (pull->parser);
+
+      free (pull->tag);
+      free (pull->strings);
+      free (pull);
+    }
+}
+
+
+/* Events */
+
+scew_pull_event
+scew_pull_next (scew_pull *pull)
+{
+  assert (pull != NULL);
+
+  if ((scew_pull_end_document == pull->event)
+      || (scew_pull_error == pull->event))
+    {
+      return pull->event;
+    }
+
+  /* The element of the last end tag is closed now. */
+  if (scew_pull_end_element == pull->event)
+    {
+      pull->depth -= 1;
+    }
+
+  /* Text of the last event is not needed anymore. */
+  pull->parser->text_length = 0;
+
+  if (pull->has_pending)
+    {
+      pull->event = pull->pending;
+      pull->has_pending = SCEW_FALSE;
+    }
+  else if (pull->empty_end)
+    {
+      pull->event = scew_pull_end_element;
+      pull->empty_end = SCEW_FALSE;
+    }
+  else
+    {
+      pull->event = parse_ (pull);
+    }
+
+  if (scew_pull_start_element == pull->event)
+    {
+      pull->depth += 1;
+    }
+
+  return pull->event;
+}
+
+
+/* Accessors */
+
+XML_Char const*
+scew_pull_name (scew_pull const *pull)
+{
+  assert (pull != NULL);
+
+  return (((scew_pull_start_element == pull->event)
+           || (scew_pull_end_element == pull->event))
+          && (pull->strings != NULL))
+    ? pull->strings[0]
+    : NULL;
+}
+
+XML_Char const*
+scew_pull_contents (scew_pull const *pull)
+{
+  assert (pull != NULL);
+
+  return (scew_pull_text == pull->event) ? pull->parser->text : NULL;
+}
+
+unsigned int
+scew_pull_depth (scew_pull const *pull)
+{
+  assert (pull != NULL);
+
+  return pull->depth;
+}
+
+unsigned int
+scew_pull_attribute_count (scew_pull const *pull)
+{
+  assert (pull != NULL);
+
+  return (scew_pull_start_element == pull->event) ? pull->n_attributes : 0;
+}
+
+XML_Char const*
+scew_pull_attribute_name (scew_pull const *pull, unsigned int index)
+{
+  assert (pull != NULL);
+  assert (index < scew_pull_attribute_count (pull));
+
+  return pull->strings[1 + 2 * index];
+}
+
+XML_Char const*
+scew_pull_attribute_value (scew_pull const *pull, unsigned int index)
+{
+  assert (pull != NULL);
+  assert (index < scew_pull_attribute_count (pull));
+
+  return pull->strings[2 + 2 * index];
+}
+
+XML_Char const*
+scew_pull_attribute_by_name (scew_pull const *pull, XML_Char const *name)
+{
+  unsigned int i = 0;
+  unsigned int n_attributes = 0;
+
+  assert (pull != NULL);
+  assert (name != NULL);
+
+  n_attributes = scew_pull_attribute_count (pull);
+  for (i = 0; i < n_attributes; ++i)
+    {
+      if (scew_strcmp (pull->strings[1 + 2 * i], name) == 0)
+        {
+          return pull->strings[2 + 2 * i];
+        }
+    }
+
+  return NULL;
+}
+
+
+
+/* Private (handlers) */
+
+void
+start_handler_ (void *data, XML_Char const *name, XML_Char const **attrs)
+{
+  scew_pull *pull = (scew_pull *) data;
+
+  if (!store_tag_ (pull, name, attrs))
+    {
+      XML_StopParser (pull->parser->parser, XML_FALSE);
+      scew_error_set_last_error_ (scew_error_no_memory);
+      return;
+    }
+
+  found_tag_ (pull, scew_pull_start_element);
+}
+
+void
+end_handler_ (void *data, XML_Char const *name)
+{
+  static XML_Char const *NO_ATTRIBUTES[] = { NULL };
+
+  scew_pull *pull = (scew_pull *) data;
+
+  /*
+   * Expat reports the end of empty elements right after their start,
+   * even if suspended. The element name is already stored.
+   */
+  if (pull->found)
+    {
+      pull->empty_end = SCEW_TRUE;
+      return;
+    }
+
+  if (!store_tag_ (pull, name, NO_ATTRIBUTES))
+    {
+      XML_StopParser (pull->parser->parser, XML_FALSE);
+      scew_error_set_last_error_ (scew_error_no_memory);
+      return;
+    }
+
+  found_tag_ (pull, scew_pull_end_element);
+}
+
+void
+char_handler_ (void *data, XML_Char const *str, int len)
+{
+  scew_pull *pull = (scew_pull *) data;
+
+  /* Text is returned at once when the next tag is found. */
+  if (!scew_parser_text_append_ (pull->parser, str, len))
+    {
+      XML_StopParser (pull->parser->parser, XML_FALSE);
+      scew_error_set_last_error_ (scew_error_no_memory);
+    }
+}
+
+
+
+/* Private (miscellaneous) */
+
+scew_bool
+store_tag_ (scew_pull *pull, XML_Char const *name, XML_Char const **attrs)
+{
+  unsigned int i = 0;
+  unsigned int n_strings = 1;
+  size_t length = scew_strlen (name) + 1;
+  XML_Char *tag = NULL;
+
+  for (i = 0; attrs[i] != NULL; ++i)
+    {
+      length += scew_strlen (attrs[i]) + 1;
+      n_strings += 1;
+    }
+
+  /* Buffers only grow, so there are no allocations once big enough. */
+  if (length > pull->tag_size)
+    {
+      size_t size = (0 == pull->tag_size) ? MIN_TAG_SIZE_ : pull->tag_size;
+
+      while (size < length)
+        {
+          size *= 2;
+        }
+
+      tag = realloc (pull->tag, size * sizeof (XML_Char));
+      if (NULL == tag)
+        {
+          return SCEW_FALSE;
+        }
+      pull->tag = tag;
+      pull->tag_size = size;
+    }
+
+  if (n_strings + 1 > pull->strings_size)
+    {
+      unsigned int size = (0 == pull->strings_size)
+        ? MIN_TAG_STRINGS_
+        : pull->strings_size;
+      XML_Char const **strings = NULL;
+
+      while (size < n_strings + 1)
+        {
+          size *= 2;
+        }
+
+      strings = realloc (pull->strings, size * sizeof (XML_Char const *));
+      if (NULL == strings)
+        {
+          return SCEW_FALSE;
+        }
+      pull->strings = strings;
+      pull->strings_size = size;
+    }
+
+  tag = pull->tag;
+  for (i = 0; i < n_strings; ++i)
+    {
+      XML_Char const *str = (0 == i) ? name : attrs[i - 1];
+      size_t str_length = scew_strlen (str) + 1;
+
+      scew_memcpy (tag, str, str_length);
+      pull->strings[i] = tag;
+      tag += str_length;
+    }
+  pull->strings[n_strings] = NULL;
+  pull->n_attributes = (n_strings - 1) / 2;
+
+  return SCEW_TRUE;
+}
+
+void
+found_tag_ (scew_pull *pull, scew_pull_event event)
+{
+  scew_parser *parser = pull->parser;
+
+  pull->event = event;
+
+  /* Text found before the tag is returned first. */
+  if (parser->text_length > 0)
+    {
+      parser->text[parser->text_length] = _XT('\0');
+      if (!parser->ignore_whitespaces || !scew_isempty (parser->text))
+        {
+          pull->event = scew_pull_text;
+          pull->pending = event;
+          pull->has_pending = SCEW_TRUE;
+        }
+      else
+        {
+          parser->text_length = 0;
+        }
+    }
+
+  pull->found = SCEW_TRUE;
+
+  XML_StopParser (parser->parser, XML_TRUE);
+}
+
+scew_pull_event
+parse_ (scew_pull *pull)
+{
+  XML_Parser expat = pull->parser->parser;
+
+  pull->found = SCEW_FALSE;
+
+  while (!pull->found)
+    {
+      enum XML_Status status = XML_STATUS_OK;
+
+      if (pull->suspended)
+        {
+          status = XML_ResumeParser (expat);
+        }
+      else if (pull->final)
+        {
+          return scew_pull_end_document;
+        }
+      else
+        {
+          status = read_ (pull);
+        }
+
+      if (XML_STATUS_ERROR == status)
+        {
+          /* Errors found by SCEW itself are already set. */
+          enum XML_Error code = XML_GetErrorCode (expat);
+          if ((code != XML_ERROR_NONE) && (code != XML_ERROR_ABORTED))
+            {
+              scew_error_set_last_error_ (scew_error_expat);
+            }
+          return scew_pull_error;
+        }
+
+      pull->suspended = (XML_STATUS_SUSPENDED == status);
+    }
+
+  return pull->event;
+}
+
+enum XML_Status
+read_ (scew_pull *pull)
+{
+  scew_parser *parser = pull->parser;
+  size_t length = 0;
+
+  /**
+   * Read directly into Expat's buffer to avoid an extra copy (one
+   * more character as readers might null-terminate the data).
+   */
+  XML_Char *buffer =
+    XML_GetBuffer (parser->parser,
+                   (parser->buffer_size + 1) * sizeof (XML_Char));
+  if (NULL == buffer)
+    {
+      scew_error_set_last_error_ (scew_error_no_memory);
+      return XML_STATUS_ERROR;
+    }
+
+  length = scew_reader_read (pull->reader, buffer, parser->buffer_size);
+  if (scew_reader_error (pull->reader))
+    {
+      scew_error_set_last_error_ (scew_error_io);
+      return XML_STATUS_ERROR;
+    }
+
+  pull->final = scew_reader_end (pull->reader);
+
+  return ((length > 0) || pull->final)
+    ? XML_ParseBuffer (parser->parser, length * sizeof (XML_Char),
+                       pull->final)
+    : XML_STATUS_OK;
+}
@@ -0,0 +1,258 @@
+/**
+ * @file     pull.h
+ * @brief    SCEW pull parser
+ * @author   Aleix Conchillo Flaque <aconchillo@gmail.com>
+ * @date     Sun Oct 18, 2026 10:12
+ * @ingroup  SCEWPull, SCEWPullAlloc, SCEWPullEvent, SCEWPullAcc
+ *
+ * @if copyright
+ *
+ * Copyright (C) 2026 Aleix Conchillo Flaque
+ *
+ * SCEW is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * SCEW is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ *
+ * @endif
+ */
+
+/**
+ * @defgroup SCEWPull Pull parser
+ *
+ * A pull parser reads an XML document as a sequence of events (start
+ * tags, end tags and text) without building a tree. Events are
+ * obtained one by one with #scew_pull_next, and the names, attributes
+ * and text of the current event stay valid until the next call.
+ *
+ * Memory does not depend on the size of the document, only on the
+ * size of the biggest tag or text. Buffers are reused from one event
+ * to the next, so no memory is allocated per event once they are big
+ * enough.
+ *
+ * Example:
+ *
+ * @code
+ * scew_pull *pull = scew_pull_create (parser, reader);
+ * scew_pull_event event = scew_pull_next (pull);
+ *
+ * while ((event != scew_pull_end_document) && (event != scew_pull_error))
+ *   {
+ *     if (scew_pull_start_element == event)
+ *       {
+ *         printf ("%s\n", scew_pull_name (pull));
+ *       }
+ *     event = scew_pull_next (pull);
+ *   }
+ *
+ * scew_pull_free (pull);
+ * @endcode
+ */
+
+#ifndef PULL_H_2610181012
+#define PULL_H_2610181012
+
+#include "export.h"
+
+#include "bool.h"
+#include "parser.h"
+#include "reader.h"
+
+#include <expat.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * This is the type declaration of SCEW pull parsers.
+ *
+ * @ingroup SCEWPull
+ */
+typedef struct scew_pull scew_pull;
+
+/**
+ * Events returned by #scew_pull_next.
+ *
+ * @ingroup SCEWPullEvent
+ */
+typedef enum
+  {
+    scew_pull_start_element,    /**< Start tag (name and attributes) */
+    scew_pull_end_element,      /**< End tag (name) */
+    scew_pull_text,             /**< Text between tags */
+    scew_pull_end_document,     /**< The whole document has been read */
+    scew_pull_error             /**< An error was found */
+  } scew_pull_event;
+
+
+/**
+ * @defgroup SCEWPullAlloc Allocation
+ * Allocate and free pull parsers.
+ * @ingroup SCEWPull
+ */
+
+/**
+ * Creates a new pull parser that reads an XML document from the given
+ * @a reader using the given @a parser. The @a parser options (white
+ * spaces handling and buffer size) are used, and Expat errors can be
+ * obtained through the @a parser (see #scew_error_expat_code).
+ *
+ * The @a parser and the @a reader are not owned by the pull parser,
+ * but they can not be used until it is freed. The @a parser is reset
+ * (see #scew_parser_reset) when the pull parser is created and when
+ * it is freed.
+ *
+ * @pre parser != NULL
+ * @pre reader != NULL
+ *
+ * @return a new pull parser, or NULL if it could not be created.
+ *
+ * @ingroup SCEWPullAlloc
+ */
+extern SCEW_API scew_pull* scew_pull_create (scew_parser *parser,
+                                             scew_reader *reader);
+
+/**
+ * Frees the given @a pull parser, giving its parser back. If a NULL
+ * @a pull parser is given, this function takes no action.
+ *
+ * @ingroup SCEWPullAlloc
+ */
+extern SCEW_API void scew_pull_free (scew_pull *pull);
+
+
+/**
+ * @defgroup SCEWPullEvent Events
+ * Read XML events.
+ * @ingroup SCEWPull
+ */
+
+/**
+ * Reads the next event of the document. Text between two tags is
+ * returned as a single event. If the parser ignores white spaces (see
+ * #scew_parser_ignore_whitespaces), text formed only by white spaces
+ * is skipped.
+ *
+ * Once the end of the document or an error is found, the same event
+ * is returned by subsequent calls.
+ *
+ * @pre pull != NULL
+ *
+ * @return the next event, #scew_pull_end_document at the end of the
+ * document, or #scew_pull_error if an error is found (see
+ * #scew_error_code).
+ *
+ * @ingroup SCEWPullEvent
+ */
+extern SCEW_API scew_pull_event scew_pull_next (scew_pull *pull);
+
+
+/**
+ * @defgroup SCEWPullAcc Accessors
+ * Obtain information of the current event.
+ * @ingroup SCEWPull
+ */
+
+/**
+ * Returns the name of the element of the current start or end tag
+ * event.
+ *
+ * @pre pull != NULL
+ *
+ * @return the element name, or NULL if the current event is not a
+ * start or end tag.
+ *
+ * @ingroup SCEWPullAcc
+ */
+extern SCEW_API XML_Char const* scew_pull_name (scew_pull const *pull);
+
+/**
+ * Returns the contents of the current text event.
+ *
+ * @pre pull != NULL
+ *
+ * @return the text, or NULL if the current event is not text.
+ *
+ * @ingroup SCEWPullAcc
+ */
+extern SCEW_API XML_Char const*
+scew_pull_contents (scew_pull const *pull);
+
+/**
+ * Returns the nesting level of the current event. Start and end tags
+ * of the root element are at depth 1, and text is at the depth of the
+ * element that contains it.
+ *
+ * @pre pull != NULL
+ *
+ * @ingroup SCEWPullAcc
+ */
+extern SCEW_API unsigned int scew_pull_depth (scew_pull const *pull);
+
+/**
+ * Returns the number of attributes of the current start tag event.
+ *
+ * @pre pull != NULL
+ *
+ * @return the number of attributes (0 if the current event is not a
+ * start tag).
+ *
+ * @ingroup SCEWPullAcc
+ */
+extern SCEW_API unsigned int scew_pull_attribute_count (scew_pull const *pull);
+
+/**
+ * Returns the name of the attribute at the given @a index of the
+ * current start tag event.
+ *
+ * @pre pull != NULL
+ * @pre index < #scew_pull_attribute_count
+ *
+ * @ingroup SCEWPullAcc
+ */
+extern SCEW_API XML_Char const* scew_pull_attribute_name (scew_pull const *pull,
+                                                         unsigned int index);
+
+/**
+ * Returns the value of the attribute at the given @a index of the
+ * current start tag event.
+ *
+ * @pre pull != NULL
+ * @pre index < #scew_pull_attribute_count
+ *
+ * @ingroup SCEWPullAcc
+ */
+extern SCEW_API XML_Char const*
+scew_pull_attribute_value (scew_pull const *pull, unsigned int index);
+
+/**
+ * Returns the value of the attribute named @a name of the current
+ * start tag event.
+ *
+ * @pre pull != NULL
+ * @pre name != NULL
+ *
+ * @return the attribute value, or NULL if the current start tag does
+ * not have such attribute (or the current event is not a start tag).
+ *
+ * @ingroup SCEWPullAcc
+ */
+extern SCEW_API XML_Char const*
+scew_pull_attribute_by_name (scew_pull const *pull, XML_Char const *name);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* PULL_H_2610181012 */
@@ -0,0 +1,649 @@
+/**
+ * @file     query.c
+ * @brief    query.h implementation
+ * @author   Aleix Conchillo Flaque <aconchillo@gmail.com>
+ * @date     Sun Oct 18, 2026 10:12
+ *
+ * @if copyright
+ *
+ * Copyright (C) 2026 Aleix Conchillo Flaque
+ *
+ * SCEW is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * SCEW is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ *
+ * @endif
+ */
+
+#include "query.h"
+
+#include "xattribute.h"
+#include "xelement.h"
+#include "xerror.h"
+#include "xlist.h"
+#include "xtree.h"
+
+#include "str.h"
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+/* Private */
+
+enum
+  {
+    MAX_STEPS_ = 32,            /**< Steps (bits of an active set) */
+    MAX_PREDICATES_ = 64,       /**< Predicates of all steps */
+    MAX_POSITIONS_ = 8          /**< Positional predicates of all steps */
+  };
+
+/**
+ * Set of steps that might match the children of an element, one bit
+ * per step.
+ */
+typedef unsigned long step_set_;
+
+typedef enum
+  {
+    predicate_attribute_,       /**< Attribute exists */
+    predicate_value_,           /**< Attribute has a value */
+    predicate_position_         /**< Position among matching siblings */
+  } predicate_type_;
+
+typedef struct
+{
+  predicate_type_ type;         /**< Predicate type */
+  XML_Char const *name;         /**< Attribute name */
+  XML_Char const *value;        /**< Attribute value */
+  unsigned int position;        /**< Position (starting at 1) */
+  unsigned int counter;         /**< Counter of the position */
+} query_predicate_;
+
+typedef struct
+{
+  scew_bool descendant;         /**< Descendant (instead of child) axis */
+  XML_Char const *name;         /**< Name test (NULL for any name) */
+  unsigned int first;           /**< First predicate of the step */
+  unsigned int n_predicates;    /**< Number of predicates of the step */
+} query_step_;
+
+struct scew_query
+{
+  scew_bool absolute;           /**< Whether it starts at the document */
+  unsigned int n_steps;
+  query_step_ steps[MAX_STEPS_];
+  unsigned int n_predicates;
+  query_predicate_ predicates[MAX_PREDICATES_];
+  unsigned int n_positions;     /**< Counters needed by positions */
+  XML_Char *strings;            /**< Names and values of the query */
+};
+
+typedef struct
+{
+  scew_query const *query;
+  scew_query_hook hook;
+  void *user_data;
+  unsigned int n_matches;
+  scew_bool stop;
+} query_run_;
+
+#define STEP_BIT_(step) ((step_set_) 1 << (step))
+
+static scew_bool compile_ (scew_query *query, XML_Char const *expression);
+static XML_Char const* compile_step_ (scew_query *query,
+                                      XML_Char const *expression,
+                                      XML_Char **strings);
+static XML_Char const* compile_predicate_ (scew_query *query,
+                                           XML_Char const *expression,
+                                           XML_Char **strings);
+static XML_Char const* read_name_ (XML_Char const *expression,
+                                   XML_Char **strings);
+static XML_Char const* skip_spaces_ (XML_Char const *expression);
+static scew_bool is_name_char_ (XML_Char c);
+
+static scew_bool visit_index_ (query_run_ *run, scew_element const *root);
+static scew_bool visit_children_ (query_run_ *run,
+                                  scew_element const *parent,
+                                  scew_element * const *children,
+                                  unsigned int n_children,
+                                  step_set_ active);
+static scew_bool match_step_ (scew_query const *query,
+                              query_step_ const *step,
+                              scew_element const *element,
+                              unsigned int *counters);
+static scew_bool first_hook_ (scew_element *element, void *user_data);
+
+
+/* Public */
+
+
+/* Allocation */
+
+scew_query*
+scew_query_create (XML_Char const *expression)
+{
+  scew_query *query = NULL;
+
+  assert (expression != NULL);
+
+  query = calloc (1, sizeof (scew_query));
+
+  /* Names and values, with their terminators, are never longer. */
+  if (query != NULL)
+    {
+      query->strings =
+        calloc (scew_strlen (expression) + 1, sizeof (XML_Char));
+    }
+
+  if ((NULL == query) || (NULL == query->strings))
+    {
+      scew_error_set_last_error_ (scew_error_no_memory);
+      scew_query_free (query);
+      return NULL;
+    }
+
+  if (!compile_ (query, expression))
+    {
+      scew_error_set_last_error_ (scew_error_query);
+      scew_query_free (query);
+      query = NULL;
+    }
+
+  return query;
+}
+
+void
+scew_query_free (scew_query *query)
+{
+  if (query != NULL)
+    {
+      free (query->strings);
+      free (query);
+    }
+}
+
+
+/* Execution */
+
+unsigned int
+scew_query_run (scew_query const *query,
+                scew_element const *element,
+                scew_query_hook hook,
+                void *user_data)
+{
+  query_run_ run;
+
+  assert (query != NULL);
+  assert (element != NULL);
+  assert (hook != NULL);
+
+  run.query = query;
+  run.hook = hook;
+  run.user_data = user_data;
+  run.n_matches = 0;
+  run.stop = SCEW_FALSE;
+
+  if (query->absolute)
+    {
+      /* The root element is the only child of the document. */
+      scew_element *root = (scew_element *) element;
+      while (root->parent != NULL)
+        {
+          root = root->parent;
+        }
+      if (!visit_index_ (&run, root))
+        {
+          visit_children_ (&run, NULL, &root, 1, STEP_BIT_ (0));
+        }
+    }
+  else
+    {
+      visit_children_ (&run, element, element->children,
+                       element->n_children, STEP_BIT_ (0));
+    }
+
+  return run.n_matches;
+}
+
+scew_element*
+scew_query_first (scew_query const *query, scew_element const *element)
+{
+  scew_element *first = NULL;
+
+  assert (query != NULL);
+  assert (element != NULL);
+
+  scew_query_run (query, element, first_hook_, &first);
+
+  return first;
+}
+
+
+/* Private */
+
+scew_bool
+compile_ (scew_query *query, XML_Char const *expression)
+{
+  XML_Char *strings = query->strings;
+
+  query->absolute = (_XT('/') == *expression);
+
+  while (*expression != _XT('\0'))
+    {
+      expression = compile_step_ (query, expression, &strings);
+      if (NULL == expression)
+        {
+          return SCEW_FALSE;
+        }
+    }
+
+  return (query->n_steps > 0);
+}
+
+XML_Char const*
+compile_step_ (scew_query *query, XML_Char const *expression,
+               XML_Char **strings)
+{
+  query_step_ *step = NULL;
+
+  if (MAX_STEPS_ == query->n_steps)
+    {
+      return NULL;
+    }
+
+  step = &query->steps[query->n_steps];
+
+  /* Only the first step of relative expressions has no separator. */
+  if (_XT('/') == *expression)
+    {
+      ++expression;
+      if (_XT('/') == *expression)
+        {
+          step->descendant = SCEW_TRUE;
+          ++expression;
+        }
+    }
+  else if ((query->n_steps > 0) || query->absolute)
+    {
+      return NULL;
+    }
+
+  if (_XT('*') == *expression)
+    {
+      step->name = NULL;
+      ++expression;
+    }
+  else
+    {
+      step->name = *strings;
+      expression = read_name_ (expression, strings);
+      if (NULL == expression)
+        {
+          return NULL;
+        }
+    }
+
+  step->first = query->n_predicates;
+  while ((expression != NULL) && (_XT('[') == *expression))
+    {
+      expression = compile_predicate_ (query, expression + 1, strings);
+    }
+  step->n_predicates = query->n_predicates - step->first;
+
+  query->n_steps += 1;
+
+  return expression;
+}
+
+XML_Char const*
+compile_predicate_ (scew_query *query, XML_Char const *expression,
+                    XML_Char **strings)
+{
+  query_predicate_ *predicate = NULL;
+
+  if (MAX_PREDICATES_ == query->n_predicates)
+    {
+      return NULL;
+    }
+
+  predicate = &query->predicates[query->n_predicates];
+  expression = skip_spaces_ (expression);
+
+  if (_XT('@') == *expression)
+    {
+      predicate->type = predicate_attribute_;
+      predicate->name = *strings;
+      expression = read_name_ (expression + 1, strings);
+      if (NULL == expression)
+        {
+          return NULL;
+        }
+
+      expression = skip_spaces_ (expression);
+      if (_XT('=') == *expression)
+        {
+          XML_Char quote = 0;
+
+          expression = skip_spaces_ (expression + 1);
+          quote = *expression;
+          if ((quote != _XT('\'')) && (quote != _XT('"')))
+            {
+              return NULL;
+            }
+
+          /* Values might contain any character but the quote. */
+          predicate->type = predicate_value_;
+          predicate->value = *strings;
+          ++expression;
+          while ((*expression != quote) && (*expression != _XT('\0')))
+            {
+              *(*strings)++ = *expression++;
+            }
+          if (*expression != quote)
+            {
+              return NULL;
+            }
+          *(*strings)++ = _XT('\0');
+          ++expression;
+        }
+    }
+  else if ((*expression >= _XT('1')) && (*expression <= _XT('9')))
+    {
+      if (MAX_POSITIONS_ == query->n_positions)
+        {
+          return NULL;
+        }
+
+      predicate->type = predicate_position_;
+      predicate->position = 0;
+      predicate->counter = query->n_positions;
+      while ((*expression >= _XT('0')) && (*expression <= _XT('9')))
+        {
+          predicate->position =
+            10 * predicate->position + (*expression - _XT('0'));
+          ++expression;
+        }
+      query->n_positions += 1;
+    }
+  else
+    {
+      return NULL;
+    }
+
+  expression = skip_spaces_ (expression);
+  if (*expression != _XT(']'))
+    {
+      return NULL;
+    }
+
+  query->n_predicates += 1;
+
+  return expression + 1;
+}
+
+XML_Char const*
+read_name_ (XML_Char const *expression, XML_Char **strings)
+{
+  XML_Char const *start = expression;
+
+  while (is_name_char_ (*expression))
+    {
+      *(*strings)++ = *expression++;
+    }
+  *(*strings)++ = _XT('\0');
+
+  return (expression == start) ? NULL : expression;
+}
+
+XML_Char const*
+skip_spaces_ (XML_Char const *expression)
+{
+  while (scew_isspace (*expression))
+    {
+      ++expression;
+    }
+
+  return expression;
+}
+
+scew_bool
+is_name_char_ (XML_Char c)
+{
+  switch (c)
+    {
+    case _XT('\0'):
+    case _XT('/'):
+    case _XT('['):
+    case _XT(']'):
+    case _XT('='):
+    case _XT('@'):
+    case _XT('*'):
+    case _XT('\''):
+    case _XT('"'):
+      return SCEW_FALSE;
+    default:
+      return !scew_isspace (c);
+    }
+}
+
+scew_bool
+visit_index_ (query_run_ *run, scew_element const *root)
+{
+  scew_query const *query = run->query;
+  query_step_ const *step = &query->steps[0];
+  scew_element * const *elements = NULL;
+  unsigned int n_elements = 0;
+  unsigned int i = 0;
+
+  /**
+   * Queries like //name[@attr] can be answered from the tree index
+   * (if the tree is indexed), as it keeps elements in document order.
+   */
+  if ((query->n_steps != 1) || !step->descendant || (NULL == step->name)
+      || (NULL == root->tree_index))
+    {
+      return SCEW_FALSE;
+    }
+
+  /* Positions are relative to siblings, which the index does not know. */
+  for (i = step->first; i < step->first + step->n_predicates; ++i)
+    {
+      if (predicate_position_ == query->predicates[i].type)
+        {
+          return SCEW_FALSE;
+        }
+    }
+
+  if (!scew_tree_index_lookup_ (root->tree_index, SCEW_FALSE, step->name,
+                                &elements, &n_elements))
+    {
+      return SCEW_FALSE;
+    }
+
+  for (i = 0; (i < n_elements) && !run->stop; ++i)
+    {
+      if (match_step_ (query, step, elements[i], NULL))
+        {
+          run->n_matches += 1;
+          run->stop = !run->hook (elements[i], run->user_data);
+        }
+    }
+
+  return SCEW_TRUE;
+}
+
+scew_bool
+visit_children_ (query_run_ *run,
+                 scew_element const *parent,
+                 scew_element * const *children,
+                 unsigned int n_children,
+                 step_set_ active)
+{
+  scew_query const *query = run->query;
+  unsigned int counters[MAX_POSITIONS_];
+  unsigned int last = query->n_steps - 1;
+  unsigned int low = 0;
+  unsigned int high = last;
+  unsigned int i = 0;
+  unsigned int k = 0;
+
+  memset (counters, 0, query->n_positions * sizeof (counters[0]));
+
+  /* Only steps between the lowest and highest active ones are tried. */
+  while ((active & STEP_BIT_ (low)) == 0)
+    {
+      ++low;
+    }
+  while ((active & STEP_BIT_ (high)) == 0)
+    {
+      --high;
+    }
+
+  /**
+   * If only a named child step can match, only children with that
+   * name need to be visited. The children index is only used if it
+   * already exists, so queries never modify the tree.
+   */
+  if ((parent != NULL) && (parent->children_index != NULL)
+      && ((active & (active - 1)) == 0))
+    {
+      query_step_ const *step = &query->steps[low];
+
+      if (!step->descendant && (step->name != NULL))
+        {
+          scew_element_index_lookup_ (parent, step->name,
+                                      &children, &n_children);
+        }
+    }
+
+  for (i = 0; i < n_children; ++i)
+    {
+      scew_element *child = children[i];
+      scew_bool matched = SCEW_FALSE;
+      step_set_ next = 0;
+
+      for (k = low; k <= high; ++k)
+        {
+          query_step_ const *step = &query->steps[k];
+
+          if ((active & STEP_BIT_ (k)) == 0)
+            {
+              continue;
+            }
+
+          /* Descendant steps might also match deeper elements. */
+          if (step->descendant)
+            {
+              next |= STEP_BIT_ (k);
+            }
+
+          if (match_step_ (query, step, child, counters))
+            {
+              if (k == last)
+                {
+                  matched = SCEW_TRUE;
+                }
+              else
+                {
+                  next |= STEP_BIT_ (k + 1);
+                }
+            }
+        }
+
+      if (matched)
+        {
+          run->n_matches += 1;
+          run->stop = !run->hook (child, run->user_data);
+        }
+
+      if (!run->stop && (next != 0) && (child->n_children > 0))
+        {
+          visit_children_ (run, child, child->children, child->n_children,
+                           next);
+        }
+
+      if (run->stop)
+        {
+          return SCEW_FALSE;
+        }
+    }
+
+  return SCEW_TRUE;
+}
+
+scew_bool
+match_step_ (scew_query const *query,
+             query_step_ const *step,
+             scew_element const *element,
+             unsigned int *counters)
+{
+  unsigned int i = 0;
+
+  /* Names interned in the same arena can be compared by pointer. */
+  if ((step->name != NULL)
+      && (element->name != step->name)
+      && (scew_strcmp (element->name, step->name) != 0))
+    {
+      return SCEW_FALSE;
+    }
+
+  for (i = step->first; i < step->first + step->n_predicates; ++i)
+    {
+      query_predicate_ const *predicate = &query->predicates[i];
+
+      if (predicate_position_ == predicate->type)
+        {
+          counters[predicate->counter] += 1;
+          if (counters[predicate->counter] != predicate->position)
+            {
+              return SCEW_FALSE;
+            }
+        }
+      else
+        {
+          scew_list const *list = element->attributes;
+          scew_attribute const *attribute = NULL;
+
+          while ((list != NULL) && (NULL == attribute))
+            {
+              attribute = list->data;
+              if (scew_strcmp (attribute->name, predicate->name) != 0)
+                {
+                  attribute = NULL;
+                }
+              list = list->next;
+            }
+
+          if ((NULL == attribute)
+              || ((predicate_value_ == predicate->type)
+                  && (scew_strcmp (attribute->value, predicate->value) != 0)))
+            {
+              return SCEW_FALSE;
+            }
+        }
+    }
+
+  return SCEW_TRUE;
+}
+
+scew_bool
+first_hook_ (scew_element *element, void *user_data)
+{
+  *((scew_element **) user_data) = element;
+
+  /* Stop at the first match. */
+  return SCEW_FALSE;
+}
@@ -0,0 +1,187 @@
+/**
+ * @file     query.h
+ * @brief    SCEW path queries
+ * @author   Aleix Conchillo Flaque <aconchillo@gmail.com>
+ * @date     Sun Oct 18, 2026 10:12
+ * @ingroup  SCEWQuery
+ *
+ * @if copyright
+ *
+ * Copyright (C) 2026 Aleix Conchillo Flaque
+ *
+ * SCEW is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * SCEW is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ *
+ * @endif
+ */
+
+/**
+ * @defgroup SCEWQuery Queries
+ *
+ * Queries find the elements of a tree matching a path expression. An
+ * expression is compiled once into a query, which might then be run
+ * any number of times on different elements. Running a query does not
+ * allocate memory: matching elements are handed, in document order
+ * and without duplicates, to a user hook.
+ *
+ * Expressions are a subset of XPath location paths:
+ *
+ * - @b a/b: children named @a b of children named @a a of the
+ *   context element.
+ * - @b /a/b: the same, starting from the document. That is, @a a must
+ *   be the root element of the context element's tree.
+ * - @b a//b: descendants named @a b of children named @a a.
+ * - @b //b: all the elements named @a b of the document.
+ * - @b *: elements with any name.
+ * - @b a[@id]: elements named @a a with an @a id attribute.
+ * - @b a[@id='x']: elements named @a a whose @a id attribute is @a x
+ *   (double quotes are also allowed).
+ * - @b a[2]: second element named @a a of each parent (positions
+ *   start at 1).
+ *
+ * Predicates might be combined, and are applied in order. For example,
+ * @b server[@role='primary'][1] selects the first primary server,
+ * while @b server[1][@role='primary'] selects the first server, only
+ * if it is primary.
+ */
+
+#ifndef QUERY_H_2610181012
+#define QUERY_H_2610181012
+
+#include "export.h"
+
+#include "bool.h"
+#include "element.h"
+
+#include <expat.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * This is the type declaration of SCEW queries.
+ *
+ * @ingroup SCEWQuery
+ */
+typedef struct scew_query scew_query;
+
+/**
+ * Query hooks receive the elements matched by a query (see
+ * #scew_query_run).
+ *
+ * @param element the matched element.
+ * @param user_data an optional user data pointer to be used by the
+ * hook (might be NULL).
+ *
+ * @return true to continue with the next match, false to stop the
+ * query.
+ *
+ * @ingroup SCEWQuery
+ */
+typedef scew_bool (*scew_query_hook) (scew_element *, void *);
+
+
+/**
+ * @defgroup SCEWQueryAlloc Allocation
+ * Compile and free queries.
+ * @ingroup SCEWQuery
+ */
+
+/**
+ * Compiles the given path @a expression into a new query. See
+ * #SCEWQuery for the supported expressions. Expressions might have up
+ * to 32 steps and up to 8 positional predicates.
+ *
+ * @pre expression != NULL
+ *
+ * @param expression the path expression to compile.
+ *
+ * @return a new query, or NULL if the expression is not valid
+ * (#scew_error_query) or no memory is available.
+ *
+ * @ingroup SCEWQueryAlloc
+ */
+extern SCEW_API scew_query* scew_query_create (XML_Char const *expression);
+
+/**
+ * Frees the given @a query. If a NULL @a query is given, this function
+ * takes no action.
+ *
+ * @ingroup SCEWQueryAlloc
+ */
+extern SCEW_API void scew_query_free (scew_query *query);
+
+
+/**
+ * @defgroup SCEWQueryRun Execution
+ * Find the elements matching a query.
+ * @ingroup SCEWQuery
+ */
+
+/**
+ * Runs the given @a query from the given context @a element, calling
+ * @a hook for each matching element in document order. Only the
+ * elements under @a element (or under the document, for absolute
+ * expressions) are visited, and subtrees that can not match are
+ * skipped. Absolute queries with a single descendant step and no
+ * positions (such as //server[@role='primary']) use the tree index
+ * instead, if the tree is indexed (see #scew_tree_build_index) and
+ * the index is up to date (see #scew_tree_update_index).
+ *
+ * Neither queries nor the tree (or its index) are modified when run,
+ * so the same query might be run from different threads at the same
+ * time. The tree must not be modified while the query runs, not even
+ * from the @a hook.
+ *
+ * @pre query != NULL
+ * @pre element != NULL
+ * @pre hook != NULL
+ *
+ * @param query the query to run.
+ * @param element the context element.
+ * @param hook the hook to be called for each matching element.
+ * @param user_data an optional user data pointer to be passed to the
+ * hook (might be NULL).
+ *
+ * @return the number of elements passed to @a hook.
+ *
+ * @ingroup SCEWQueryRun
+ */
+extern SCEW_API unsigned int scew_query_run (scew_query const *query,
+                                             scew_element const *element,
+                                             scew_query_hook hook,
+                                             void *user_data);
+
+/**
+ * Runs the given @a query from the given context @a element, and
+ * returns the first matching element in document order. The query
+ * stops as soon as an element is found.
+ *
+ * @pre query != NULL
+ * @pre element != NULL
+ *
+ * @return the first matching element, or NULL if no element matches.
+ *
+ * @ingroup SCEWQueryRun
+ */
+extern SCEW_API scew_element* scew_query_first (scew_query const *query,
+                                                scew_element const *element);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* QUERY_H_2610181012 */
@@ -80,6 +80,20 @@ scew_reader_read (scew_reader *reader, XML_Char *buffer, size_t char_no)
   return reader->hooks->read (reader, buffer, char_no);
 }
 
+size_t
+scew_reader_span (scew_reader *reader, XML_Char const **data)
+{
+  assert (reader != NULL);
+  assert (reader->hooks != NULL);
+  assert (data != NULL);
+
+  *data = NULL;
+
+  /* Readers created with hooks older than span have no span hook. */
+  return (NULL == reader->hooks->span) ? 0
+    : reader->hooks->span (reader, data);
+}
+
 scew_bool
 scew_reader_end (scew_reader *reader)
 {
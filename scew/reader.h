@@ -98,6 +98,14 @@ typedef struct
    * @see scew_reader_free
    */
   void (*free) (scew_reader *);
+
+  /**
+   * @see scew_reader_span
+   *
+   * This hook is optional and might be NULL for readers that do not
+   * keep their data in contiguous memory.
+   */
+  size_t (*span) (scew_reader *, XML_Char const **);
 } scew_reader_hooks;
 
 /**
@@ -164,6 +172,34 @@ extern SCEW_API size_t scew_reader_read (scew_reader *reader,
                                          XML_Char *buffer,
                                          size_t char_no);
 
+/**
+ * Gets the next block of contiguous data available in the given @a
+ * reader without copying it. The returned data is consumed, as if it
+ * had been read with #scew_reader_read, and it remains valid until
+ * the reader is closed. The data is not null-terminated.
+ *
+ * Only readers with data in memory (e.g. memory buffers or mapped
+ * files) support this function. For other readers @a data is set to
+ * NULL and #scew_reader_read needs to be used instead. Readers that
+ * support it always set @a data to a valid pointer, even if no more
+ * data is available.
+ *
+ * This function will call the actual @a span function provided by the
+ * SCEW reader hooks (#scew_reader_hooks), if any.
+ *
+ * @pre reader != NULL
+ * @pre data != NULL
+ *
+ * @param reader the reader from where to get data from.
+ * @param data where to store the pointer to the data.
+ *
+ * @return the number of characters available at @a data.
+ *
+ * @ingroup SCEWReader
+ */
+extern SCEW_API size_t scew_reader_span (scew_reader *reader,
+                                         XML_Char const **data);
+
 /**
  * Tells whether the given @a reader has reached its end. That is, no
  * more data is available for reading.
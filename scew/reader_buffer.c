@@ -52,6 +52,7 @@ static scew_bool buffer_end_ (scew_reader *reader);
 static scew_bool buffer_error_ (scew_reader *reader);
 static scew_bool buffer_close_ (scew_reader *reader);
 static void buffer_free_ (scew_reader *reader);
+static size_t buffer_span_ (scew_reader *reader, XML_Char const **data);
 
 static scew_reader_hooks const buffer_hooks_ =
   {
@@ -59,7 +60,8 @@ static scew_reader_hooks const buffer_hooks_ =
     buffer_end_,
     buffer_error_,
     buffer_close_,
-    buffer_free_
+    buffer_free_,
+    buffer_span_
   };
 
 
@@ -163,3 +165,23 @@ buffer_free_ (scew_reader *reader)
   buf_reader = scew_reader_data (reader);
   free (buf_reader);
 }
+
+size_t
+buffer_span_ (scew_reader *reader, XML_Char const **data)
+{
+  size_t span_no = 0;
+  scew_reader_buffer *buf_reader = NULL;
+
+  assert (reader != NULL);
+  assert (data != NULL);
+
+  buf_reader = scew_reader_data (reader);
+
+  /* The whole buffer is already in memory, hand out the rest of it. */
+  span_no = buf_reader->size - buf_reader->current;
+
+  *data = buf_reader->buffer + buf_reader->current;
+  buf_reader->current += span_no;
+
+  return span_no;
+}
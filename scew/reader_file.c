@@ -57,7 +57,8 @@ static scew_reader_hooks const file_hooks_ =
     file_end_,
     file_error_,
     file_close_,
-    file_free_
+    file_free_,
+    NULL
   };
 
 
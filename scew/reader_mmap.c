@@ -0,0 +1,297 @@
+/**
+ * @file     reader_mmap.c
+ * @brief    reader_mmap.h implementation
+ * @author   Aleix Conchillo Flaque <aconchillo@gmail.com>
+ * @date     Sun Oct 18, 2026 10:12
+ *
+ * @if copyright
+ *
+ * Copyright (C) 2026 Aleix Conchillo Flaque
+ *
+ * SCEW is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * SCEW is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ *
+ * @endif
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "reader_mmap.h"
+
+#include "reader_file.h"
+
+#if defined(HAVE_MMAP) && defined(HAVE_SYS_MMAN_H)
+
+#include "str.h"
+
+#include <assert.h>
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+/* Private */
+
+enum
+  {
+    MAX_SPAN_SIZE_ = 8 * 1024 * 1024 /**< Characters per span */
+  };
+
+typedef struct
+{
+  XML_Char const *data;         /**< Mapped file (NULL if empty) */
+  size_t length;                /**< Mapped bytes */
+  size_t size;                  /**< Mapped characters */
+  size_t current;               /**< Characters already read */
+  scew_bool closed;
+} scew_reader_mmap;
+
+static size_t mmap_read_ (scew_reader *reader,
+                          XML_Char *buffer,
+                          size_t char_no);
+static scew_bool mmap_end_ (scew_reader *reader);
+static scew_bool mmap_error_ (scew_reader *reader);
+static scew_bool mmap_close_ (scew_reader *reader);
+static void mmap_free_ (scew_reader *reader);
+static size_t mmap_span_ (scew_reader *reader, XML_Char const **data);
+
+static void unmap_ (scew_reader_mmap *mmap_reader);
+
+static scew_reader_hooks const mmap_hooks_ =
+  {
+    mmap_read_,
+    mmap_end_,
+    mmap_error_,
+    mmap_close_,
+    mmap_free_,
+    mmap_span_
+  };
+
+
+/* Public */
+
+scew_reader*
+scew_reader_mmap_create (char const *file_name)
+{
+  int fd = -1;
+  struct stat info;
+  void *data = NULL;
+  scew_reader *reader = NULL;
+  scew_reader_mmap *mmap_reader = NULL;
+
+  assert (file_name != NULL);
+
+  fd = open (file_name, O_RDONLY);
+  if (-1 == fd)
+    {
+      return NULL;
+    }
+
+  /* Empty files can not be mapped, but they are still valid. */
+  if (fstat (fd, &info) != 0)
+    {
+      data = MAP_FAILED;
+    }
+  else if (info.st_size > 0)
+    {
+      data = mmap (NULL, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+
+  /* The mapping is kept after closing the file descriptor. */
+  close (fd);
+
+  /* Not all files can be mapped (e.g. pipes or devices). */
+  if (MAP_FAILED == data)
+    {
+      return scew_reader_file_create (file_name);
+    }
+
+#ifdef HAVE_MADVISE
+  /* Files are parsed from beginning to end. */
+  if (data != NULL)
+    {
+      madvise (data, info.st_size, MADV_SEQUENTIAL);
+    }
+#endif /* HAVE_MADVISE */
+
+  mmap_reader = calloc (1, sizeof (scew_reader_mmap));
+  if (mmap_reader != NULL)
+    {
+      mmap_reader->data = data;
+      mmap_reader->length = (NULL == data) ? 0 : info.st_size;
+      mmap_reader->size = mmap_reader->length / sizeof (XML_Char);
+      mmap_reader->current = 0;
+      mmap_reader->closed = SCEW_FALSE;
+
+      /* Create reader */
+      reader = scew_reader_create (&mmap_hooks_, mmap_reader);
+    }
+
+  if (NULL == reader)
+    {
+      if (data != NULL)
+        {
+          munmap (data, info.st_size);
+        }
+      free (mmap_reader);
+    }
+
+  return reader;
+}
+
+
+/* Private */
+
+size_t
+mmap_read_ (scew_reader *reader, XML_Char *buffer, size_t char_no)
+{
+  size_t read_no = 0;
+  XML_Char const *data = NULL;
+
+  assert (reader != NULL);
+  assert (buffer != NULL);
+
+  /* Reading is just copying the next span. */
+  read_no = mmap_span_ (reader, &data);
+  if (read_no > char_no)
+    {
+      scew_reader_mmap *mmap_reader = scew_reader_data (reader);
+      mmap_reader->current -= read_no - char_no;
+      read_no = char_no;
+    }
+
+  scew_memcpy (buffer, data, read_no);
+
+  buffer[read_no] = _XT('\0');
+
+  return read_no;
+}
+
+scew_bool
+mmap_end_ (scew_reader *reader)
+{
+  scew_reader_mmap *mmap_reader = NULL;
+
+  assert (reader != NULL);
+
+  mmap_reader = scew_reader_data (reader);
+
+  return mmap_reader->closed || (mmap_reader->current >= mmap_reader->size);
+}
+
+scew_bool
+mmap_error_ (scew_reader *reader)
+{
+  return SCEW_FALSE;
+}
+
+scew_bool
+mmap_close_ (scew_reader *reader)
+{
+  scew_reader_mmap *mmap_reader = NULL;
+
+  assert (reader != NULL);
+
+  mmap_reader = scew_reader_data (reader);
+
+  unmap_ (mmap_reader);
+
+  return SCEW_TRUE;
+}
+
+void
+mmap_free_ (scew_reader *reader)
+{
+  scew_reader_mmap *mmap_reader = NULL;
+
+  assert (reader != NULL);
+
+  /* Unmap the file before freeing the reader. */
+  mmap_close_ (reader);
+
+  mmap_reader = scew_reader_data (reader);
+  free (mmap_reader);
+}
+
+size_t
+mmap_span_ (scew_reader *reader, XML_Char const **data)
+{
+  size_t span_no = 0;
+  scew_reader_mmap *mmap_reader = NULL;
+
+  assert (reader != NULL);
+  assert (data != NULL);
+
+  mmap_reader = scew_reader_data (reader);
+
+  if (mmap_reader->closed)
+    {
+      /* Still a valid pointer, but no data. */
+      *data = _XT("");
+      return 0;
+    }
+
+  /**
+   * Hand out big windows of the mapping, so the parser makes progress
+   * while the rest of the file is paged in.
+   */
+  span_no = mmap_reader->size - mmap_reader->current;
+  if (span_no > MAX_SPAN_SIZE_)
+    {
+      span_no = MAX_SPAN_SIZE_;
+    }
+
+  *data = (NULL == mmap_reader->data)
+    ? _XT("")
+    : mmap_reader->data + mmap_reader->current;
+  mmap_reader->current += span_no;
+
+  return span_no;
+}
+
+void
+unmap_ (scew_reader_mmap *mmap_reader)
+{
+  if (!mmap_reader->closed)
+    {
+      if (mmap_reader->data != NULL)
+        {
+          munmap ((void *) mmap_reader->data, mmap_reader->length);
+        }
+      mmap_reader->data = NULL;
+      mmap_reader->size = 0;
+      mmap_reader->current = 0;
+      mmap_reader->closed = SCEW_TRUE;
+    }
+}
+
+#else /* HAVE_MMAP && HAVE_SYS_MMAN_H */
+
+
+/* Public */
+
+scew_reader*
+scew_reader_mmap_create (char const *file_name)
+{
+  /* No memory-mapped files support, use a regular file reader. */
+  return scew_reader_file_create (file_name);
+}
+
+#endif /* HAVE_MMAP && HAVE_SYS_MMAN_H */
@@ -0,0 +1,68 @@
+/**
+ * @file     reader_mmap.h
+ * @brief    SCEW reader functions for memory-mapped files
+ * @author   Aleix Conchillo Flaque <aconchillo@gmail.com>
+ * @date     Sun Oct 18, 2026 10:12
+ * @ingroup  SCEWReaderFile
+ *
+ * @if copyright
+ *
+ * Copyright (C) 2026 Aleix Conchillo Flaque
+ *
+ * SCEW is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * SCEW is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ *
+ * @endif
+ */
+
+#ifndef READER_MMAP_H_2610181012
+#define READER_MMAP_H_2610181012
+
+#include "export.h"
+
+#include "reader.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * Creates a new SCEW reader for the given file name. The file is
+ * mapped read-only into memory, so data can be handed to the parser
+ * in big blocks without copying it (see #scew_reader_span). This is
+ * the preferred reader for big files. Once the reader is created, the
+ * @ref SCEWReader routines must be called in order to read data from
+ * the file or to know the file status.
+ *
+ * In platforms without memory-mapped files support this function
+ * returns a regular file reader (see #scew_reader_file_create).
+ *
+ * @pre file_name != NULL
+ *
+ * @param file_name the file name to map for the new SCEW reader.
+ *
+ * @return a new SCEW reader for the given file name or NULL if the
+ * reader could not be created (e.g. memory allocation, the file does
+ * not exist, etc.).
+ *
+ * @ingroup SCEWReaderFile
+ */
+extern SCEW_API scew_reader* scew_reader_mmap_create (char const *file_name);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* READER_MMAP_H_2610181012 */
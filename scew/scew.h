@@ -35,17 +35,24 @@
 #include "bool.h"
 #include "element.h"
 #include "error.h"
+#include "hash.h"
 #include "list.h"
 #include "parser.h"
+#include "parser_batch.h"
+#include "parser_pool.h"
 #include "printer.h"
+#include "pull.h"
+#include "query.h"
 #include "reader.h"
 #include "reader_buffer.h"
 #include "reader_file.h"
+#include "reader_mmap.h"
 #include "str.h"
 #include "tree.h"
 #include "writer.h"
 #include "writer_buffer.h"
 #include "writer_file.h"
+#include "writer_growable.h"
 
 /* Automatically include the correct library on Windows. */
 #if defined (_MSC_VER) && defined(XML_STATIC)
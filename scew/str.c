@@ -29,10 +29,22 @@
 #include "str.h"
 
 #include "xerror.h"
-#include "str.h"
+#include "xstr.h"
 
 #include <assert.h>
 
+/* Vectorized scans are only used with single byte characters. */
+#ifndef XML_UNICODE_WCHAR_T
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define SCEW_STR_AVX2_
+#endif /* __AVX2__ */
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define SCEW_STR_SSE2_
+#endif /* __SSE2__ */
+#endif /* XML_UNICODE_WCHAR_T */
+
 
 /* Private */
 
@@ -54,9 +66,16 @@ enum
     GT_SIZE_ = 4,               /**< Size of &gt; */
     AMP_SIZE_ = 5,              /**< Size of &amp; */
     APOS_SIZE_ = 6,             /**< Size of &apos; */
-    QUOT_SIZE_ = 6              /**< Size of &quot; */
+    QUOT_SIZE_ = 6,             /**< Size of &quot; */
+    SCAN_RUN_ = 16              /**< Clean characters before scanning */
   };
 
+static size_t scan_escape_ (XML_Char const *src, size_t length);
+static XML_Char const* escape_entity_ (XML_Char c, size_t *size);
+#if defined(SCEW_STR_AVX2_) || defined(SCEW_STR_SSE2_)
+static unsigned int first_bit_ (unsigned int mask);
+#endif
+
 
 /* Public */
 
@@ -227,3 +246,200 @@ scew_strescape (XML_Char const *src)
 
   return escaped;
 }
+
+
+/* Protected */
+
+size_t
+scew_strescape_copy_ (XML_Char *dst, size_t dst_size,
+                      XML_Char const *src, size_t length, size_t *written)
+{
+  size_t i = 0;
+  size_t n = 0;
+  size_t clean = SCAN_RUN_;
+
+  assert (dst != NULL);
+  assert (src != NULL);
+  assert (written != NULL);
+
+  /**
+   * Calling the scan for every delimiter is slow with dense markup,
+   * so characters are escaped one by one until a long enough clean
+   * run is found. Text usually has no delimiters, so scan first.
+   */
+  while ((i < length) && (n < dst_size))
+    {
+      XML_Char const *entity = NULL;
+      size_t size = 0;
+
+      if (clean >= SCAN_RUN_)
+        {
+          size_t room = dst_size - n;
+          size_t span = scan_escape_ (src + i,
+                                      (length - i < room) ? length - i : room);
+
+          scew_memcpy (dst + n, src + i, span);
+          i += span;
+          n += span;
+          clean = 0;
+          continue;
+        }
+
+      entity = escape_entity_ (src[i], &size);
+      if (NULL == entity)
+        {
+          dst[n++] = src[i++];
+          clean += 1;
+        }
+      else if (n + size <= dst_size)
+        {
+          scew_memcpy (dst + n, entity, size);
+          n += size;
+          i += 1;
+          clean = 0;
+        }
+      else
+        {
+          break;
+        }
+    }
+
+  *written = n;
+
+  return i;
+}
+
+
+
+/* Private */
+
+size_t
+scan_escape_ (XML_Char const *src, size_t length)
+{
+  size_t i = 0;
+
+#ifdef SCEW_STR_AVX2_
+  __m256i const lt_32 = _mm256_set1_epi8 (CHR_LT_);
+  __m256i const gt_32 = _mm256_set1_epi8 (CHR_GT_);
+  __m256i const amp_32 = _mm256_set1_epi8 (CHR_AMP_);
+  __m256i const apos_32 = _mm256_set1_epi8 (CHR_APOS_);
+  __m256i const quot_32 = _mm256_set1_epi8 (CHR_QUOT_);
+#endif /* SCEW_STR_AVX2_ */
+#ifdef SCEW_STR_SSE2_
+  __m128i const lt_16 = _mm_set1_epi8 (CHR_LT_);
+  __m128i const gt_16 = _mm_set1_epi8 (CHR_GT_);
+  __m128i const amp_16 = _mm_set1_epi8 (CHR_AMP_);
+  __m128i const apos_16 = _mm_set1_epi8 (CHR_APOS_);
+  __m128i const quot_16 = _mm_set1_epi8 (CHR_QUOT_);
+#endif /* SCEW_STR_SSE2_ */
+
+#ifdef SCEW_STR_AVX2_
+  for (; i + 32 <= length; i += 32)
+    {
+      __m256i chars = _mm256_loadu_si256 ((__m256i const *) (src + i));
+      __m256i special =
+        _mm256_or_si256 (_mm256_or_si256 (_mm256_cmpeq_epi8 (chars, lt_32),
+                                          _mm256_cmpeq_epi8 (chars, gt_32)),
+                         _mm256_or_si256 (_mm256_cmpeq_epi8 (chars, amp_32),
+                                          _mm256_cmpeq_epi8 (chars, apos_32)));
+      unsigned int mask = (unsigned int)
+        _mm256_movemask_epi8 (_mm256_or_si256 (special,
+                                               _mm256_cmpeq_epi8 (chars,
+                                                                  quot_32)));
+      if (mask != 0)
+        {
+          return i + first_bit_ (mask);
+        }
+    }
+#endif /* SCEW_STR_AVX2_ */
+
+#ifdef SCEW_STR_SSE2_
+  for (; i + 16 <= length; i += 16)
+    {
+      __m128i chars = _mm_loadu_si128 ((__m128i const *) (src + i));
+      __m128i special =
+        _mm_or_si128 (_mm_or_si128 (_mm_cmpeq_epi8 (chars, lt_16),
+                                    _mm_cmpeq_epi8 (chars, gt_16)),
+                      _mm_or_si128 (_mm_cmpeq_epi8 (chars, amp_16),
+                                    _mm_cmpeq_epi8 (chars, apos_16)));
+      unsigned int mask = (unsigned int)
+        _mm_movemask_epi8 (_mm_or_si128 (special,
+                                         _mm_cmpeq_epi8 (chars, quot_16)));
+      if (mask != 0)
+        {
+          return i + first_bit_ (mask);
+        }
+    }
+#endif /* SCEW_STR_SSE2_ */
+
+  /* Scalar scan for the remaining characters. */
+  for (; i < length; ++i)
+    {
+      switch (src[i])
+        {
+        case CHR_LT_:
+        case CHR_GT_:
+        case CHR_AMP_:
+        case CHR_APOS_:
+        case CHR_QUOT_:
+          return i;
+        default:
+          break;
+        }
+    }
+
+  return length;
+}
+
+XML_Char const*
+escape_entity_ (XML_Char c, size_t *size)
+{
+  XML_Char const *entity = NULL;
+
+  switch (c)
+    {
+    case CHR_LT_:
+      entity = XML_LT_;
+      *size = LT_SIZE_;
+      break;
+    case CHR_GT_:
+      entity = XML_GT_;
+      *size = GT_SIZE_;
+      break;
+    case CHR_AMP_:
+      entity = XML_AMP_;
+      *size = AMP_SIZE_;
+      break;
+    case CHR_APOS_:
+      entity = XML_APOS_;
+      *size = APOS_SIZE_;
+      break;
+    case CHR_QUOT_:
+      entity = XML_QUOT_;
+      *size = QUOT_SIZE_;
+      break;
+    default:
+      *size = 0;
+      break;
+    }
+
+  return entity;
+}
+
+#if defined(SCEW_STR_AVX2_) || defined(SCEW_STR_SSE2_)
+unsigned int
+first_bit_ (unsigned int mask)
+{
+#ifdef __GNUC__
+  return __builtin_ctz (mask);
+#else
+  unsigned int bit = 0;
+  while (0 == (mask & 1))
+    {
+      mask >>= 1;
+      bit += 1;
+    }
+  return bit;
+#endif /* __GNUC__ */
+}
+#endif
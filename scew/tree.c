@@ -26,9 +26,11 @@
  * @endif
  */
 
-#include "tree.h"
+#include "xtree.h"
 
+#include "xelement.h"
 #include "xerror.h"
+#include "xthread.h"
 
 #include "element.h"
 #include "str.h"
@@ -45,9 +47,19 @@ struct scew_tree
   XML_Char *preamble;
   scew_tree_standalone standalone;
   scew_element *root;
+  scew_arena *arena;
+  scew_tree_index *index;
 };
 
+static scew_tree* copy_tree_ (scew_tree const *tree,
+                              scew_arena *arena,
+                              unsigned int n_threads);
 static scew_bool compare_tree_ (scew_tree const *a, scew_tree const *b);
+static scew_bool lookup_index_ (scew_tree const *tree,
+                                scew_bool by_value,
+                                XML_Char const *key,
+                                scew_element * const **elements,
+                                unsigned int *n_elements);
 
 static XML_Char const *DEFAULT_XML_VERSION_ = (XML_Char *) _XT("1.0");
 static XML_Char const *DEFAULT_ENCODING_ = (XML_Char *) _XT("UTF-8");
@@ -77,36 +89,31 @@ scew_tree_create (void)
 scew_tree*
 scew_tree_copy (scew_tree const *tree)
 {
-  scew_tree *new_tree = NULL;
-
   assert (tree != NULL);
 
-  new_tree = calloc (1, sizeof (scew_tree));
+  return copy_tree_ (tree, NULL, 1);
+}
 
-  if (new_tree != NULL)
-    {
-      scew_bool copied = SCEW_FALSE;
+scew_tree*
+scew_tree_copy_parallel (scew_tree const *tree, unsigned int n_threads)
+{
+  scew_arena *arena = NULL;
 
-      new_tree->version = scew_strdup (tree->version);
-      new_tree->encoding = scew_strdup (tree->encoding);
-      new_tree->preamble = scew_strdup (tree->preamble);
-      new_tree->standalone = tree->standalone;
-      new_tree->root = scew_element_copy (tree->root);
+  assert (tree != NULL);
 
-      copied =
-        ((tree->version == NULL) || (new_tree->version != NULL))
-        && ((tree->encoding == NULL) || (new_tree->encoding != NULL))
-        && ((tree->preamble == NULL) || (new_tree->preamble != NULL))
-        && ((tree->root == NULL) || (new_tree->root != NULL));
+  arena = scew_arena_create_ ();
+  if (NULL == arena)
+    {
+      scew_error_set_last_error_ (scew_error_no_memory);
+      return NULL;
+    }
 
-      if (!copied)
-        {
-          scew_tree_free (new_tree);
-          new_tree = NULL;
-        }
+  if (0 == n_threads)
+    {
+      n_threads = scew_thread_count_ ();
     }
 
-  return new_tree;
+  return copy_tree_ (tree, arena, n_threads);
 }
 
 void
@@ -117,7 +124,26 @@ scew_tree_free (scew_tree *tree)
       free (tree->version);
       free (tree->encoding);
       free (tree->preamble);
-      scew_element_free (tree->root);
+
+      /**
+       * If the whole tree lives in the arena there is no need to free
+       * the elements one by one.
+       */
+      if ((NULL == tree->arena)
+          || (tree->root == NULL)
+          || (tree->root->arena != tree->arena)
+          || scew_arena_foreign_ (tree->arena))
+        {
+          /* Elements freed one by one must not update the index. */
+          scew_tree_index_free_ (tree->index, SCEW_TRUE);
+          scew_element_free (tree->root);
+        }
+      else
+        {
+          scew_tree_index_free_ (tree->index, SCEW_FALSE);
+        }
+      scew_arena_free_ (tree->arena);
+
       free (tree);
     }
 }
@@ -239,6 +265,12 @@ scew_tree_set_root_element (scew_tree *tree, scew_element *root)
 
   tree->root = root;
 
+  /* If the index can not be built, it will be built again later. */
+  if (tree->index != NULL)
+    {
+      scew_tree_index_build_ (tree->index, root);
+    }
+
   return root;
 }
 
@@ -261,9 +293,141 @@ scew_tree_set_xml_preamble (scew_tree *tree, XML_Char const *preamble)
   tree->preamble = scew_strdup (preamble);
 }
 
+
+/* Index */
+
+scew_bool
+scew_tree_build_index (scew_tree *tree, XML_Char const *attribute)
+{
+  scew_tree_index *index = NULL;
+
+  assert (tree != NULL);
+
+  scew_tree_free_index (tree);
+
+  index = scew_tree_index_create_ (attribute);
+  if ((NULL == index) || !scew_tree_index_build_ (index, tree->root))
+    {
+      scew_tree_index_free_ (index, SCEW_TRUE);
+      scew_error_set_last_error_ (scew_error_no_memory);
+      return SCEW_FALSE;
+    }
+
+  tree->index = index;
+
+  return SCEW_TRUE;
+}
+
+void
+scew_tree_free_index (scew_tree *tree)
+{
+  assert (tree != NULL);
+
+  scew_tree_index_free_ (tree->index, SCEW_TRUE);
+
+  tree->index = NULL;
+}
+
+scew_bool
+scew_tree_update_index (scew_tree *tree)
+{
+  assert (tree != NULL);
+  assert (tree->index != NULL);
+
+  if (!scew_tree_index_update_ (tree->index))
+    {
+      scew_error_set_last_error_ (scew_error_no_memory);
+      return SCEW_FALSE;
+    }
+
+  return SCEW_TRUE;
+}
+
+unsigned int
+scew_tree_elements_by_name (scew_tree const *tree,
+                            XML_Char const *name,
+                            scew_element * const **elements)
+{
+  unsigned int n_elements = 0;
+
+  assert (tree != NULL);
+  assert (name != NULL);
+  assert (elements != NULL);
+  assert (tree->index != NULL);
+
+  *elements = NULL;
+
+  if (!lookup_index_ (tree, SCEW_FALSE, name, elements, &n_elements))
+    {
+      scew_error_set_last_error_ (scew_error_no_memory);
+    }
+
+  return n_elements;
+}
+
+scew_element*
+scew_tree_element_by_attribute (scew_tree const *tree, XML_Char const *value)
+{
+  unsigned int n_elements = 0;
+  scew_element * const *elements = NULL;
+
+  assert (tree != NULL);
+  assert (value != NULL);
+  assert (tree->index != NULL);
+
+  if (!lookup_index_ (tree, SCEW_TRUE, value, &elements, &n_elements))
+    {
+      scew_error_set_last_error_ (scew_error_no_memory);
+    }
+
+  return (n_elements > 0) ? elements[0] : NULL;
+}
+
 
 /* Private*/
 
+scew_tree*
+copy_tree_ (scew_tree const *tree, scew_arena *arena, unsigned int n_threads)
+{
+  scew_tree *new_tree = calloc (1, sizeof (scew_tree));
+
+  if (new_tree != NULL)
+    {
+      scew_bool copied = SCEW_FALSE;
+
+      /* The arena (if any) is freed with the tree. */
+      new_tree->arena = arena;
+      new_tree->version = scew_strdup (tree->version);
+      new_tree->encoding = scew_strdup (tree->encoding);
+      new_tree->preamble = scew_strdup (tree->preamble);
+      new_tree->standalone = tree->standalone;
+      if (tree->root != NULL)
+        {
+          new_tree->root = (NULL == arena)
+            ? scew_element_copy (tree->root)
+            : scew_element_arena_copy_ (arena, tree->root, n_threads);
+        }
+
+      copied =
+        ((tree->version == NULL) || (new_tree->version != NULL))
+        && ((tree->encoding == NULL) || (new_tree->encoding != NULL))
+        && ((tree->preamble == NULL) || (new_tree->preamble != NULL))
+        && ((tree->root == NULL) || (new_tree->root != NULL));
+
+      if (!copied)
+        {
+          scew_tree_free (new_tree);
+          new_tree = NULL;
+        }
+    }
+  else
+    {
+      scew_arena_free_ (arena);
+    }
+
+  return new_tree;
+}
+
 scew_bool
 compare_tree_ (scew_tree const *a, scew_tree const *b)
 {
@@ -280,3 +444,30 @@ compare_tree_ (scew_tree const *a, scew_tree const *b)
 
   return equal;
 }
+
+scew_bool
+lookup_index_ (scew_tree const *tree,
+               scew_bool by_value,
+               XML_Char const *key,
+               scew_element * const **elements,
+               unsigned int *n_elements)
+{
+  /* The index is a cache, so it might be updated here. */
+  return (scew_tree_index_lookup_ (tree->index, by_value, key,
+                                   elements, n_elements)
+          || (scew_tree_index_update_ (tree->index)
+              && scew_tree_index_lookup_ (tree->index, by_value, key,
+                                          elements, n_elements)));
+}
+
+
+
+/* Protected */
+
+void
+scew_tree_set_arena_ (scew_tree *tree, scew_arena *arena)
+{
+  assert (tree != NULL);
+
+  tree->arena = arena;
+}
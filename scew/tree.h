@@ -4,6 +4,7 @@
  * @author   Aleix Conchillo Flaque <aconchillo@gmail.com>
  * @date     Thu Feb 20, 2003 23:32
  * @ingroup  SCEWTree, SCEWTreeAlloc, SCEWTreeProp, SCEWTreeContent
+ * @ingroup  SCEWTreeIndex
  *
  * @if copyright
  *
@@ -114,6 +115,32 @@ extern SCEW_API scew_tree* scew_tree_create (void);
  */
 extern SCEW_API scew_tree* scew_tree_copy (scew_tree const *tree);
 
+/**
+ * Makes a deep copy of the given @a tree using up to @a n_threads
+ * threads. The result is the same as with #scew_tree_copy, but the
+ * whole copy is allocated in an arena owned by the new tree (see
+ * #scew_parser_set_arena), so the same restrictions apply.
+ *
+ * The memory needed by the copy is computed first, so all the
+ * elements, attributes and strings are allocated in a single memory
+ * block. Subtrees are then copied in parallel into separate parts of
+ * that block. Freeing the copy only releases the block.
+ *
+ * Note that the given @a tree must not be modified while copying.
+ *
+ * @pre tree != NULL
+ *
+ * @param tree the tree to be duplicated.
+ * @param n_threads the number of threads to use. If 0, the number of
+ * available processors is used.
+ *
+ * @return a new tree, or NULL if the copy failed.
+ *
+ * @ingroup SCEWTreeAlloc
+ */
+extern SCEW_API scew_tree* scew_tree_copy_parallel (scew_tree const *tree,
+                                                    unsigned int n_threads);
+
 /**
  * Frees a tree memory structure. Call this function when you are done
  * with your XML document. This will also free the root element
@@ -377,6 +404,117 @@ extern SCEW_API XML_Char const* scew_tree_xml_preamble (scew_tree const *tree);
 extern SCEW_API void scew_tree_set_xml_preamble (scew_tree *tree,
                                                  XML_Char const *preamble);
 
+
+/**
+ * @defgroup SCEWTreeIndex Index
+ * Find elements anywhere in a tree without walking it.
+ * @ingroup SCEWTree
+ */
+
+/**
+ * Builds an index of all the elements of the given @a tree by name,
+ * so all the elements with a given name can be obtained without
+ * walking the tree (see #scew_tree_elements_by_name). If an @a
+ * attribute name (for example "id") is given, elements are also
+ * indexed by the value of that attribute (see
+ * #scew_tree_element_by_attribute). If the tree was already indexed,
+ * the previous index is replaced.
+ *
+ * Once built, the index is kept up to date whenever elements are
+ * added, detached or freed, renamed, and whenever attributes are
+ * added, deleted or changed. Note that this makes these operations
+ * slower, so it is better to build the index once the tree is loaded.
+ * Elements added out of document order are only merged into place by
+ * the next lookup (or #scew_tree_update_index).
+ *
+ * @pre tree != NULL
+ *
+ * @param tree the XML tree to index.
+ * @param attribute the name of the attribute to index elements by, or
+ * NULL to only index elements by name.
+ *
+ * @return true if the index is built, false otherwise.
+ *
+ * @ingroup SCEWTreeIndex
+ */
+extern SCEW_API scew_bool scew_tree_build_index (scew_tree *tree,
+                                                 XML_Char const *attribute);
+
+/**
+ * Frees the index of the given @a tree (if any). Modifying the tree
+ * will be as fast as before the index was built.
+ *
+ * @pre tree != NULL
+ *
+ * @ingroup SCEWTreeIndex
+ */
+extern SCEW_API void scew_tree_free_index (scew_tree *tree);
+
+/**
+ * Merges into place the elements added to the index of the given @a
+ * tree out of document order, or builds the index again if it could
+ * not be kept up to date. Indexed lookups do this themselves, so this
+ * is only needed before looking up from different threads (see
+ * #scew_tree_elements_by_name).
+ *
+ * @pre tree != NULL
+ * @pre the tree is indexed (#scew_tree_build_index)
+ *
+ * @return true if the index is up to date, false otherwise.
+ *
+ * @ingroup SCEWTreeIndex
+ */
+extern SCEW_API scew_bool scew_tree_update_index (scew_tree *tree);
+
+/**
+ * Obtains all the elements of the given @a tree named @a name, in
+ * document order. The returned array belongs to the index and is only
+ * valid until the tree is modified.
+ *
+ * Note that this function might update the index (see
+ * #scew_tree_update_index), so it must not be called from different
+ * threads on the same tree at the same time, unless the index has
+ * been updated since the tree was last modified.
+ *
+ * @pre tree != NULL
+ * @pre name != NULL
+ * @pre elements != NULL
+ * @pre the tree is indexed (#scew_tree_build_index)
+ *
+ * @param tree the XML tree to search.
+ * @param name the name of the elements to find.
+ * @param elements where the array of found elements is stored.
+ *
+ * @return the number of elements found.
+ *
+ * @ingroup SCEWTreeIndex
+ */
+extern SCEW_API unsigned int
+scew_tree_elements_by_name (scew_tree const *tree,
+                            XML_Char const *name,
+                            scew_element * const **elements);
+
+/**
+ * Finds the first element (in document order) of the given @a tree
+ * whose indexed attribute has the given @a value (see
+ * #scew_tree_build_index). As with #scew_tree_elements_by_name, this
+ * might update the index.
+ *
+ * @pre tree != NULL
+ * @pre value != NULL
+ * @pre the tree is indexed (#scew_tree_build_index)
+ *
+ * @param tree the XML tree to search.
+ * @param value the attribute value of the element to find.
+ *
+ * @return the element found, or NULL if no element has an indexed
+ * attribute with the given @a value (or no attribute is indexed).
+ *
+ * @ingroup SCEWTreeIndex
+ */
+extern SCEW_API scew_element*
+scew_tree_element_by_attribute (scew_tree const *tree, XML_Char const *value);
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
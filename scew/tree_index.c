@@ -0,0 +1,848 @@
+/**
+ * @file     tree_index.c
+ * @brief    xtree.h implementation (tree index by name)
+ * @author   Aleix Conchillo Flaque <aconchillo@gmail.com>
+ * @date     Sun Oct 18, 2026 10:12
+ *
+ * @if copyright
+ *
+ * Copyright (C) 2026 Aleix Conchillo Flaque
+ *
+ * SCEW is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * SCEW is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ *
+ * @endif
+ */
+
+#include "xtree.h"
+
+#include "xattribute.h"
+#include "xelement.h"
+#include "xlist.h"
+
+#include "str.h"
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+
+/* Private */
+
+enum
+  {
+    MIN_TABLE_SIZE_ = 16,       /**< Initial entries of a table */
+    MIN_ENTRY_SIZE_ = 2         /**< Initial elements of an entry */
+  };
+
+typedef struct index_entry index_entry;
+
+/**
+ * All the elements of a tree with the same key (name or attribute
+ * value). Added elements are appended, and if they do not follow the
+ * existing ones in document order they are merged into place when the
+ * entry is next needed. Elements of a subtree are a contiguous range of a
+ * sorted entry (as subtrees are contiguous in document order), so
+ * removed elements are recorded as a range and dropped at once when
+ * the whole subtree is done.
+ */
+struct index_entry
+{
+  size_t hash;                  /**< Hash of the key */
+  XML_Char *key;                /**< The key (NULL if unused) */
+  scew_element **elements;      /**< Elements with this key */
+  unsigned int n_elements;      /**< Number of elements */
+  unsigned int size;            /**< Allocated elements */
+  unsigned int first_change;    /**< First added or removed element */
+  unsigned int n_changes;       /**< Added or removed elements */
+  index_entry *next_changed;    /**< Next entry with changes */
+  unsigned int n_sorted;        /**< Elements in document order (the
+                                   rest need to be merged) */
+  scew_bool unsorted;           /**< Whether elements need sorting */
+};
+
+typedef struct
+{
+  index_entry *entries;         /**< Open addressing table of entries */
+  unsigned int size;            /**< Number of entries (power of 2) */
+  unsigned int n_used;          /**< Used entries (even if empty) */
+  index_entry *changed;         /**< Entries with changes */
+  unsigned int n_unsorted;      /**< Entries that need sorting */
+} index_table;
+
+struct scew_tree_index
+{
+  XML_Char *attribute;          /**< Indexed attribute name (if any) */
+  scew_element *root;           /**< Root element of the tree */
+  index_table names;            /**< Elements by name */
+  index_table values;           /**< Elements by attribute value */
+  scew_bool valid;              /**< Whether the tables are up to date */
+};
+
+static size_t hash_key_ (XML_Char const *key);
+
+static index_entry* find_entry_ (index_table const *table,
+                                 XML_Char const *key,
+                                 size_t hash);
+
+static index_entry* insert_entry_ (index_table *table, XML_Char const *key);
+
+static scew_bool rehash_ (index_table *table);
+
+static void free_table_ (index_table *table);
+
+static int compare_order_ (scew_element const *a, scew_element const *b);
+
+static int sort_order_ (void const *a, void const *b);
+
+static void sort_entry_ (index_table *table, index_entry *entry);
+
+static void sort_table_ (index_table *table);
+
+static unsigned int lower_bound_ (scew_element * const *elements,
+                                  unsigned int n_elements,
+                                  scew_element const *element);
+
+static scew_bool entry_add_ (index_table *table,
+                             index_entry *entry,
+                             scew_element *element);
+
+static void entry_remove_ (index_table *table,
+                           index_entry *entry,
+                           scew_element const *element);
+
+static void finish_add_ (index_table *table);
+
+static void finish_remove_ (index_table *table);
+
+static scew_bool add_value_ (scew_tree_index *index,
+                             scew_attribute const *attribute);
+
+static void remove_value_ (scew_tree_index *index,
+                           scew_attribute const *attribute);
+
+static void add_subtree_ (scew_tree_index *index,
+                          scew_element *element,
+                          scew_bool self,
+                          scew_bool descendants);
+
+static void remove_subtree_ (scew_tree_index *index,
+                             scew_element *element,
+                             scew_bool self,
+                             scew_bool descendants);
+
+
+
+/* Protected */
+
+scew_tree_index*
+scew_tree_index_create_ (XML_Char const *attribute)
+{
+  scew_tree_index *index = calloc (1, sizeof (scew_tree_index));
+
+  if ((index != NULL) && (attribute != NULL))
+    {
+      index->attribute = scew_strdup (attribute);
+      if (NULL == index->attribute)
+        {
+          free (index);
+          index = NULL;
+        }
+    }
+
+  return index;
+}
+
+void
+scew_tree_index_free_ (scew_tree_index *index, scew_bool detach)
+{
+  if (index != NULL)
+    {
+      if (detach && (index->root != NULL))
+        {
+          index->valid = SCEW_FALSE;
+          remove_subtree_ (index, index->root, SCEW_TRUE, SCEW_TRUE);
+        }
+
+      free_table_ (&index->names);
+      free_table_ (&index->values);
+      free (index->attribute);
+      free (index);
+    }
+}
+
+scew_bool
+scew_tree_index_build_ (scew_tree_index *index, scew_element *root)
+{
+  assert (index != NULL);
+
+  /* A replaced root element no longer belongs to the tree. */
+  if ((index->root != NULL) && (index->root != root))
+    {
+      index->valid = SCEW_FALSE;
+      remove_subtree_ (index, index->root, SCEW_TRUE, SCEW_TRUE);
+    }
+
+  free_table_ (&index->names);
+  free_table_ (&index->values);
+
+  index->root = root;
+  index->valid = SCEW_TRUE;
+
+  if (root != NULL)
+    {
+      scew_tree_index_add_ (index, root, SCEW_TRUE, SCEW_TRUE);
+    }
+
+  return index->valid;
+}
+
+scew_bool
+scew_tree_index_lookup_ (scew_tree_index const *index,
+                         scew_bool by_value,
+                         XML_Char const *key,
+                         scew_element * const **elements,
+                         unsigned int *n_elements)
+{
+  index_table const *table = NULL;
+  index_entry const *entry = NULL;
+
+  assert (index != NULL);
+  assert (key != NULL);
+  assert (elements != NULL);
+  assert (n_elements != NULL);
+
+  if (!index->valid)
+    {
+      return SCEW_FALSE;
+    }
+
+  table = by_value ? &index->values : &index->names;
+
+  *elements = NULL;
+  *n_elements = 0;
+
+  if (table->size > 0)
+    {
+      entry = find_entry_ (table, key, hash_key_ (key));
+      if (entry->unsorted)
+        {
+          return SCEW_FALSE;
+        }
+      if (entry->key != NULL)
+        {
+          *elements = entry->elements;
+          *n_elements = entry->n_elements;
+        }
+    }
+
+  return SCEW_TRUE;
+}
+
+scew_bool
+scew_tree_index_update_ (scew_tree_index *index)
+{
+  assert (index != NULL);
+
+  if (!index->valid)
+    {
+      return scew_tree_index_build_ (index, index->root);
+    }
+
+  sort_table_ (&index->names);
+  sort_table_ (&index->values);
+
+  return SCEW_TRUE;
+}
+
+void
+scew_tree_index_add_ (scew_tree_index *index,
+                      scew_element *element,
+                      scew_bool self,
+                      scew_bool descendants)
+{
+  assert (element != NULL);
+
+  if (index != NULL)
+    {
+      add_subtree_ (index, element, self, descendants);
+      if (index->valid)
+        {
+          finish_add_ (&index->names);
+          finish_add_ (&index->values);
+        }
+    }
+}
+
+void
+scew_tree_index_remove_ (scew_tree_index *index,
+                         scew_element *element,
+                         scew_bool self,
+                         scew_bool descendants)
+{
+  assert (element != NULL);
+
+  if (index != NULL)
+    {
+      if (self && (element == index->root))
+        {
+          index->root = NULL;
+        }
+
+      remove_subtree_ (index, element, self, descendants);
+      if (index->valid)
+        {
+          finish_remove_ (&index->names);
+          finish_remove_ (&index->values);
+        }
+    }
+}
+
+void
+scew_tree_index_add_attribute_ (scew_attribute const *attribute)
+{
+  scew_tree_index *index = NULL;
+
+  assert (attribute != NULL);
+
+  index = (attribute->parent != NULL) ? attribute->parent->tree_index : NULL;
+  if ((index != NULL) && index->valid)
+    {
+      index->valid = add_value_ (index, attribute);
+      if (index->valid)
+        {
+          finish_add_ (&index->values);
+        }
+    }
+}
+
+void
+scew_tree_index_remove_attribute_ (scew_attribute const *attribute)
+{
+  scew_tree_index *index = NULL;
+
+  assert (attribute != NULL);
+
+  index = (attribute->parent != NULL) ? attribute->parent->tree_index : NULL;
+  if ((index != NULL) && index->valid)
+    {
+      remove_value_ (index, attribute);
+      finish_remove_ (&index->values);
+    }
+}
+
+
+
+/* Private */
+
+size_t
+hash_key_ (XML_Char const *key)
+{
+  /* FNV-1a */
+  size_t hash = 2166136261U;
+
+  while (*key != _XT('\0'))
+    {
+      hash = (hash ^ (size_t) *key) * 16777619U;
+      ++key;
+    }
+
+  return hash;
+}
+
+index_entry*
+find_entry_ (index_table const *table, XML_Char const *key, size_t hash)
+{
+  unsigned int mask = table->size - 1;
+  unsigned int slot = hash & mask;
+
+  while (table->entries[slot].key != NULL)
+    {
+      index_entry *entry = &table->entries[slot];
+
+      if ((entry->hash == hash) && (scew_strcmp (entry->key, key) == 0))
+        {
+          return entry;
+        }
+
+      slot = (slot + 1) & mask;
+    }
+
+  /* Not found, this is where the key should be inserted. */
+  return &table->entries[slot];
+}
+
+index_entry*
+insert_entry_ (index_table *table, XML_Char const *key)
+{
+  size_t hash = hash_key_ (key);
+  index_entry *entry = NULL;
+
+  if ((table->size > 0)
+      && ((entry = find_entry_ (table, key, hash))->key != NULL))
+    {
+      return entry;
+    }
+
+  if ((4 * (table->n_used + 1) > 3 * table->size) && !rehash_ (table))
+    {
+      return NULL;
+    }
+
+  entry = find_entry_ (table, key, hash);
+  entry->key = scew_strdup (key);
+  if (NULL == entry->key)
+    {
+      return NULL;
+    }
+  entry->hash = hash;
+  table->n_used += 1;
+
+  return entry;
+}
+
+scew_bool
+rehash_ (index_table *table)
+{
+  unsigned int i = 0;
+  unsigned int n_live = 0;
+  unsigned int size = MIN_TABLE_SIZE_;
+  index_entry *entries = NULL;
+
+  /* Entries without elements are dropped, so the table might shrink. */
+  for (i = 0; i < table->size; ++i)
+    {
+      index_entry const *entry = &table->entries[i];
+      n_live += ((entry->n_elements > 0) || (entry->n_changes > 0));
+    }
+  while (4 * (n_live + 1) > 2 * size)
+    {
+      size *= 2;
+    }
+
+  entries = calloc (size, sizeof (index_entry));
+  if (NULL == entries)
+    {
+      return SCEW_FALSE;
+    }
+
+  table->n_used = 0;
+  table->changed = NULL;
+  for (i = 0; i < table->size; ++i)
+    {
+      index_entry *entry = &table->entries[i];
+
+      if ((entry->n_elements > 0) || (entry->n_changes > 0))
+        {
+          unsigned int slot = entry->hash & (size - 1);
+          while (entries[slot].key != NULL)
+            {
+              slot = (slot + 1) & (size - 1);
+            }
+          entries[slot] = *entry;
+          table->n_used += 1;
+
+          /* Entries have moved, so the changed list is rebuilt. */
+          if (entry->n_changes > 0)
+            {
+              entries[slot].next_changed = table->changed;
+              table->changed = &entries[slot];
+            }
+        }
+      else
+        {
+          free (entry->key);
+          free (entry->elements);
+        }
+    }
+
+  free (table->entries);
+
+  table->entries = entries;
+  table->size = size;
+
+  return SCEW_TRUE;
+}
+
+void
+free_table_ (index_table *table)
+{
+  unsigned int i = 0;
+
+  for (i = 0; i < table->size; ++i)
+    {
+      free (table->entries[i].key);
+      free (table->entries[i].elements);
+    }
+  free (table->entries);
+
+  memset (table, 0, sizeof (index_table));
+}
+
+int
+compare_order_ (scew_element const *a, scew_element const *b)
+{
+  unsigned int depth_a = 0;
+  unsigned int depth_b = 0;
+  scew_element const *parent = NULL;
+
+  for (parent = a->parent; parent != NULL; parent = parent->parent)
+    {
+      ++depth_a;
+    }
+  for (parent = b->parent; parent != NULL; parent = parent->parent)
+    {
+      ++depth_b;
+    }
+
+  /* Ancestors come before their descendants. */
+  for (; depth_a > depth_b; --depth_a)
+    {
+      a = a->parent;
+      if (a == b)
+        {
+          return 1;
+        }
+    }
+  for (; depth_b > depth_a; --depth_b)
+    {
+      b = b->parent;
+      if (a == b)
+        {
+          return -1;
+        }
+    }
+
+  if (a == b)
+    {
+      return 0;
+    }
+
+  while (a->parent != b->parent)
+    {
+      a = a->parent;
+      b = b->parent;
+    }
+
+  return (a->index < b->index) ? -1 : 1;
+}
+
+unsigned int
+lower_bound_ (scew_element * const *elements,
+              unsigned int n_elements,
+              scew_element const *element)
+{
+  unsigned int low = 0;
+  unsigned int high = n_elements;
+
+  while (low < high)
+    {
+      unsigned int middle = low + (high - low) / 2;
+
+      if (compare_order_ (elements[middle], element) < 0)
+        {
+          low = middle + 1;
+        }
+      else
+        {
+          high = middle;
+        }
+    }
+
+  return low;
+}
+
+int
+sort_order_ (void const *a, void const *b)
+{
+  return compare_order_ (*(scew_element * const *) a,
+                         *(scew_element * const *) b);
+}
+
+void
+sort_entry_ (index_table *table, index_entry *entry)
+{
+  if (entry->unsorted)
+    {
+      scew_element **elements = entry->elements;
+      unsigned int i = entry->n_sorted;
+      unsigned int j = entry->n_elements - entry->n_sorted;
+      unsigned int k = entry->n_elements;
+      scew_element **added = malloc (j * sizeof (scew_element *));
+
+      /**
+       * Sort the added elements and merge them (from the end) with the
+       * ones already in document order. If there is no memory for
+       * that, just sort everything.
+       */
+      if (added != NULL)
+        {
+          memcpy (added, elements + i, j * sizeof (scew_element *));
+          qsort (added, j, sizeof (scew_element *), sort_order_);
+          while (j > 0)
+            {
+              if ((i > 0) && (compare_order_ (elements[i - 1],
+                                              added[j - 1]) > 0))
+                {
+                  elements[--k] = elements[--i];
+                }
+              else
+                {
+                  elements[--k] = added[--j];
+                }
+            }
+          free (added);
+        }
+      else
+        {
+          qsort (elements, entry->n_elements, sizeof (scew_element *),
+                 sort_order_);
+        }
+
+      entry->unsorted = SCEW_FALSE;
+      table->n_unsorted -= 1;
+    }
+}
+
+void
+sort_table_ (index_table *table)
+{
+  unsigned int i = 0;
+
+  for (i = 0; (i < table->size) && (table->n_unsorted > 0); ++i)
+    {
+      sort_entry_ (table, &table->entries[i]);
+    }
+}
+
+scew_bool
+entry_add_ (index_table *table, index_entry *entry, scew_element *element)
+{
+  if (entry->n_elements == entry->size)
+    {
+      unsigned int size = (0 == entry->size)
+        ? MIN_ENTRY_SIZE_
+        : 2 * entry->size;
+      scew_element **elements =
+        realloc (entry->elements, size * sizeof (scew_element *));
+
+      if (NULL == elements)
+        {
+          return SCEW_FALSE;
+        }
+      entry->elements = elements;
+      entry->size = size;
+    }
+
+  /* New elements are appended and moved into place at the end. */
+  if (0 == entry->n_changes)
+    {
+      entry->first_change = entry->n_elements;
+      entry->next_changed = table->changed;
+      table->changed = entry;
+    }
+
+  entry->elements[entry->n_elements] = element;
+  entry->n_elements += 1;
+  entry->n_changes += 1;
+
+  return SCEW_TRUE;
+}
+
+void
+entry_remove_ (index_table *table,
+               index_entry *entry,
+               scew_element const *element)
+{
+  unsigned int position = 0;
+
+  /* Removed elements follow the first one found. */
+  if (0 == entry->n_changes)
+    {
+      sort_entry_ (table, entry);
+      position = lower_bound_ (entry->elements, entry->n_elements, element);
+      entry->first_change = position;
+      entry->next_changed = table->changed;
+      table->changed = entry;
+    }
+  else
+    {
+      position = entry->first_change + entry->n_changes;
+    }
+
+  assert (position < entry->n_elements);
+  assert (entry->elements[position] == element);
+
+  entry->n_changes += 1;
+}
+
+void
+finish_add_ (index_table *table)
+{
+  index_entry *entry = NULL;
+
+  for (entry = table->changed; entry != NULL; entry = entry->next_changed)
+    {
+      unsigned int first = entry->first_change;
+
+      /**
+       * Added elements are in document order, so the entry is still
+       * sorted if they follow the existing ones.
+       */
+      if (!entry->unsorted && (first > 0)
+          && (compare_order_ (entry->elements[first - 1],
+                              entry->elements[first]) > 0))
+        {
+          entry->n_sorted = first;
+          entry->unsorted = SCEW_TRUE;
+          table->n_unsorted += 1;
+        }
+
+      entry->n_changes = 0;
+    }
+
+  table->changed = NULL;
+}
+
+void
+finish_remove_ (index_table *table)
+{
+  index_entry *entry = NULL;
+
+  for (entry = table->changed; entry != NULL; entry = entry->next_changed)
+    {
+      unsigned int last = entry->first_change + entry->n_changes;
+
+      memmove (entry->elements + entry->first_change,
+               entry->elements + last,
+               (entry->n_elements - last) * sizeof (scew_element *));
+
+      entry->n_elements -= entry->n_changes;
+      entry->n_changes = 0;
+    }
+
+  table->changed = NULL;
+}
+
+scew_bool
+add_value_ (scew_tree_index *index, scew_attribute const *attribute)
+{
+  index_entry *entry = NULL;
+
+  if ((NULL == index->attribute)
+      || (scew_strcmp (attribute->name, index->attribute) != 0))
+    {
+      return SCEW_TRUE;
+    }
+
+  entry = insert_entry_ (&index->values, attribute->value);
+
+  return ((entry != NULL)
+          && entry_add_ (&index->values, entry, attribute->parent));
+}
+
+void
+remove_value_ (scew_tree_index *index, scew_attribute const *attribute)
+{
+  if ((index->attribute != NULL)
+      && (scew_strcmp (attribute->name, index->attribute) == 0))
+    {
+      index_entry *entry =
+        find_entry_ (&index->values, attribute->value,
+                     hash_key_ (attribute->value));
+
+      assert (entry->key != NULL);
+
+      entry_remove_ (&index->values, entry, attribute->parent);
+    }
+}
+
+void
+add_subtree_ (scew_tree_index *index,
+              scew_element *element,
+              scew_bool self,
+              scew_bool descendants)
+{
+  unsigned int i = 0;
+
+  if (self)
+    {
+      element->tree_index = index;
+
+      /* If the index can not be updated, it will be built again later. */
+      if (index->valid)
+        {
+          index_entry *entry = insert_entry_ (&index->names, element->name);
+          scew_list *list = element->attributes;
+
+          index->valid = ((entry != NULL)
+                          && entry_add_ (&index->names, entry, element));
+
+          for (; index->valid && (list != NULL); list = list->next)
+            {
+              index->valid = add_value_ (index, list->data);
+            }
+        }
+    }
+
+  if (descendants)
+    {
+      for (i = 0; i < element->n_children; ++i)
+        {
+          add_subtree_ (index, element->children[i], SCEW_TRUE, SCEW_TRUE);
+        }
+    }
+}
+
+void
+remove_subtree_ (scew_tree_index *index,
+                 scew_element *element,
+                 scew_bool self,
+                 scew_bool descendants)
+{
+  unsigned int i = 0;
+
+  if (self)
+    {
+      element->tree_index = NULL;
+
+      if (index->valid)
+        {
+          index_entry *entry =
+            find_entry_ (&index->names, element->name,
+                         hash_key_ (element->name));
+          scew_list *list = element->attributes;
+
+          assert (entry->key != NULL);
+
+          entry_remove_ (&index->names, entry, element);
+
+          for (; list != NULL; list = list->next)
+            {
+              remove_value_ (index, list->data);
+            }
+        }
+    }
+
+  if (descendants)
+    {
+      for (i = 0; i < element->n_children; ++i)
+        {
+          remove_subtree_ (index, element->children[i],
+                           SCEW_TRUE, SCEW_TRUE);
+        }
+    }
+}
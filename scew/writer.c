@@ -98,6 +98,17 @@ scew_writer_error (scew_writer *writer)
   return writer->hooks->error (writer);
 }
 
+scew_bool
+scew_writer_flush (scew_writer *writer)
+{
+  assert (writer != NULL);
+  assert (writer->hooks != NULL);
+
+  /* Writers created with hooks older than flush have no flush hook. */
+  return (NULL == writer->hooks->flush) ? SCEW_TRUE
+    : writer->hooks->flush (writer);
+}
+
 scew_bool
 scew_writer_close (scew_writer *writer)
 {
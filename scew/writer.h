@@ -101,6 +101,14 @@ typedef struct
    * @see scew_writer_free
    */
   void (*free) (scew_writer *);
+
+  /**
+   * @see scew_writer_flush
+   *
+   * This hook is optional and might be NULL for writers that do not
+   * buffer any data.
+   */
+  scew_bool (*flush) (scew_writer *);
 } scew_writer_hooks;
 
 
@@ -203,6 +211,25 @@ extern SCEW_API scew_bool scew_writer_end (scew_writer *writer);
  */
 extern SCEW_API scew_bool scew_writer_error (scew_writer *writer);
 
+/**
+ * Sends any data buffered by the given @a writer to its final
+ * destination (e.g. the file for file streams). Writers without a @a
+ * flush hook do not buffer any data, so nothing is done for them.
+ *
+ * This function will call the actual @a flush function provided by
+ * the SCEW writer hooks (#scew_writer_hooks), if any.
+ *
+ * @pre writer != NULL
+ *
+ * @param writer the writer to flush.
+ *
+ * @return true if all the buffered data was successfully flushed,
+ * false otherwise.
+ *
+ * @ingroup SCEWWriter
+ */
+extern SCEW_API scew_bool scew_writer_flush (scew_writer *writer);
+
 /**
  * Closes the given @a writer. This function will have different
  * effects depending on the SCEW writer type (e.g. it will close the
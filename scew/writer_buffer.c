@@ -57,7 +57,8 @@ static scew_writer_hooks const buffer_hooks_ =
     buffer_end_,
     buffer_error_,
     buffer_close_,
-    buffer_free_
+    buffer_free_,
+    NULL
   };
 
 
@@ -31,6 +31,7 @@
 #include "str.h"
 
 #include <assert.h>
+#include <string.h>
 
 
 /* Private */
@@ -41,19 +42,32 @@
 #define SCEW_EOF (XML_Char) EOF
 #endif /* XML_UNICODE_WCHAR_T */
 
+enum
+  {
+    DEFAULT_BUFFER_SIZE_ = 16 * 1024  /**< Default buffer size (chars) */
+  };
+
 typedef struct
 {
   FILE *file;
   scew_bool closed;
+  XML_Char *buffer;             /**< Pending data (NULL if unbuffered) */
+  size_t size;                  /**< Buffer size (in characters) */
+  size_t length;                /**< Pending characters in the buffer */
 } scew_writer_fp;
 
 static size_t file_write_ (scew_writer *writer,
                            XML_Char const *buffer,
                            size_t byte_no);
+static size_t file_write_span_ (scew_writer_fp *fp_writer,
+                                XML_Char const *buffer,
+                                size_t char_no);
+static scew_bool file_flush_buffer_ (scew_writer_fp *fp_writer);
 static scew_bool file_end_ (scew_writer *reader);
 static scew_bool file_error_ (scew_writer *reader);
 static scew_bool file_close_ (scew_writer *writer);
 static void file_free_ (scew_writer *writer);
+static scew_bool file_flush_ (scew_writer *writer);
 
 static scew_writer_hooks const file_hooks_ =
   {
@@ -61,7 +75,8 @@ static scew_writer_hooks const file_hooks_ =
     file_end_,
     file_error_,
     file_close_,
-    file_free_
+    file_free_,
+    file_flush_
   };
 
 
@@ -91,6 +106,12 @@ scew_writer_file_create (char const *file_name)
 
 scew_writer*
 scew_writer_fp_create (FILE *file)
+{
+  return scew_writer_fp_buffered_create (file, DEFAULT_BUFFER_SIZE_);
+}
+
+scew_writer*
+scew_writer_fp_buffered_create (FILE *file, size_t size)
 {
   scew_writer *writer = NULL;
   scew_writer_fp *fp_writer = NULL;
@@ -104,10 +125,21 @@ scew_writer_fp_create (FILE *file)
       fp_writer->file = file;
       fp_writer->closed = SCEW_FALSE;
 
+      if (size > 0)
+        {
+          fp_writer->buffer = malloc (size * sizeof (XML_Char));
+          fp_writer->size = size;
+        }
+
       /* Create writer */
-      writer = scew_writer_create (&file_hooks_, fp_writer);
+      if ((0 == size) || (fp_writer->buffer != NULL))
+        {
+          writer = scew_writer_create (&file_hooks_, fp_writer);
+        }
+
       if (NULL == writer)
         {
+          free (fp_writer->buffer);
           free (fp_writer);
         }
     }
@@ -121,8 +153,6 @@ scew_writer_fp_create (FILE *file)
 size_t
 file_write_ (scew_writer *writer, XML_Char const *buffer, size_t char_no)
 {
-  XML_Char c = 0;
-  size_t written_no = 0;
   scew_writer_fp *fp_writer = NULL;
 
   assert (writer != NULL);
@@ -130,6 +160,35 @@ file_write_ (scew_writer *writer, XML_Char const *buffer, size_t char_no)
 
   fp_writer = scew_writer_data (writer);
 
+  /* Make room for the new data. */
+  if ((fp_writer->length + char_no > fp_writer->size)
+      && !file_flush_buffer_ (fp_writer))
+    {
+      return 0;
+    }
+
+  /* Big spans (or unbuffered writers) go straight to the file. */
+  if (char_no >= fp_writer->size)
+    {
+      return file_write_span_ (fp_writer, buffer, char_no);
+    }
+
+  scew_memcpy (fp_writer->buffer + fp_writer->length, buffer, char_no);
+  fp_writer->length += char_no;
+
+  return char_no;
+}
+
+size_t
+file_write_span_ (scew_writer_fp *fp_writer,
+                  XML_Char const *buffer,
+                  size_t char_no)
+{
+#ifdef XML_UNICODE_WCHAR_T
+  /* Wide characters need to be converted by the stream. */
+  XML_Char c = 0;
+  size_t written_no = 0;
+
   while ((c != SCEW_EOF) && (written_no < char_no))
     {
       c = scew_fputc (buffer[written_no], fp_writer->file);
@@ -140,6 +199,20 @@ file_write_ (scew_writer *writer, XML_Char const *buffer, size_t char_no)
     }
 
   return written_no;
+#else
+  return fwrite (buffer, sizeof (XML_Char), char_no, fp_writer->file);
+#endif /* XML_UNICODE_WCHAR_T */
+}
+
+scew_bool
+file_flush_buffer_ (scew_writer_fp *fp_writer)
+{
+  size_t length = fp_writer->length;
+
+  fp_writer->length = 0;
+
+  return (0 == length)
+    || (file_write_span_ (fp_writer, fp_writer->buffer, length) == length);
 }
 
 scew_bool
@@ -186,6 +259,12 @@ file_close_ (scew_writer *writer)
 
   fp_writer = scew_writer_data (writer);
 
+  /* Pending data needs to be written before closing. */
+  if (!fp_writer->closed)
+    {
+      file_flush_ (writer);
+    }
+
   /**
    * Do not close already closed file or standard output and standard
    * error streams.
@@ -217,5 +296,26 @@ file_free_ (scew_writer *writer)
   file_close_ (writer);
 
   fp_writer = scew_writer_data (writer);
+  free (fp_writer->buffer);
   free (fp_writer);
 }
+
+scew_bool
+file_flush_ (scew_writer *writer)
+{
+  scew_bool result = SCEW_TRUE;
+  scew_writer_fp *fp_writer = NULL;
+
+  assert (writer != NULL);
+
+  fp_writer = scew_writer_data (writer);
+
+  /* Nothing left to flush once the file is closed. */
+  if (!fp_writer->closed)
+    {
+      result = file_flush_buffer_ (fp_writer);
+      result = (0 == fflush (fp_writer->file)) && result;
+    }
+
+  return result;
+}
@@ -73,7 +73,8 @@ extern SCEW_API scew_writer* scew_writer_file_create (char const *file_name);
  * Creates a new SCEW writer for the given @a file stream. The file
  * stream is created in text mode. Once the writer is created, any of
  * the @ref SCEWWriter routines must be called in order to store data
- * to the file or to know the file status.
+ * to the file or to know the file status. Written data is buffered
+ * internally (see #scew_writer_fp_buffered_create).
  *
  * For UTF-16 encoding (only in Windows paltforms) the BOM (Byte Order
  * Mask) is automatically handled by the Windows API.
@@ -90,6 +91,31 @@ extern SCEW_API scew_writer* scew_writer_file_create (char const *file_name);
  */
 extern SCEW_API scew_writer* scew_writer_fp_create (FILE *file);
 
+/**
+ * Creates a new SCEW writer for the given @a file stream, as
+ * #scew_writer_fp_create, but with an internal buffer of the given @a
+ * size (in characters).
+ *
+ * File writers collect small writes in their internal buffer and send
+ * them to the file stream in big blocks. Writes bigger than the
+ * buffer go directly to the file stream. Buffered data is written
+ * when the buffer is full, when #scew_writer_flush is called and when
+ * the writer is closed or freed. A @a size of 0 disables the internal
+ * buffer, so data is sent to the file stream on every write.
+ *
+ * @pre file != NULL
+ *
+ * @param file the file where the new SCEW writer will write to.
+ * @param size the size of the internal buffer (in characters).
+ *
+ * @return a new SCEW writer for the given file stream or NULL if the
+ * writer could not be created (e.g. memory allocation).
+ *
+ * @ingroup SCEWWriterFile
+ */
+extern SCEW_API scew_writer* scew_writer_fp_buffered_create (FILE *file,
+                                                             size_t size);
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
@@ -0,0 +1,287 @@
+/**
+ * @file     writer_growable.c
+ * @brief    writer_growable.h implementation
+ * @author   Aleix Conchillo Flaque <aconchillo@gmail.com>
+ * @date     Sun Oct 18, 2026 10:12
+ *
+ * @if copyright
+ *
+ * Copyright (C) 2026 Aleix Conchillo Flaque
+ *
+ * SCEW is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * SCEW is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ *
+ * @endif
+ */
+
+#include "writer_growable.h"
+
+#include "str.h"
+
+#include <assert.h>
+#include <stdio.h>
+
+
+/* Private */
+
+enum
+  {
+    DEFAULT_BUFFER_SIZE_ = 4096 /**< Default initial size (chars) */
+  };
+
+typedef struct
+{
+  XML_Char *buffer;
+  size_t size;
+  size_t current;
+  size_t initial_size;
+  scew_bool closed;
+  scew_bool error;
+} scew_writer_growable;
+
+static size_t growable_write_ (scew_writer *writer,
+                               XML_Char const *buffer,
+                               size_t char_no);
+static scew_bool growable_end_ (scew_writer *writer);
+static scew_bool growable_error_ (scew_writer *writer);
+static scew_bool growable_close_ (scew_writer *writer);
+static void growable_free_ (scew_writer *writer);
+
+static scew_bool growable_reserve_ (scew_writer_growable *grow_writer,
+                                    size_t char_no);
+
+static scew_writer_hooks const growable_hooks_ =
+  {
+    growable_write_,
+    growable_end_,
+    growable_error_,
+    growable_close_,
+    growable_free_,
+    NULL
+  };
+
+
+/* Public */
+
+scew_writer*
+scew_writer_growable_create (size_t size)
+{
+  scew_writer *writer = NULL;
+  scew_writer_growable *grow_writer = NULL;
+
+  grow_writer = calloc (1, sizeof (scew_writer_growable));
+
+  if (grow_writer != NULL)
+    {
+      grow_writer->initial_size = (0 == size) ? DEFAULT_BUFFER_SIZE_ : size;
+
+      /* Create writer */
+      writer = scew_writer_create (&growable_hooks_, grow_writer);
+      if (NULL == writer)
+        {
+          free (grow_writer);
+        }
+    }
+
+  return writer;
+}
+
+XML_Char const*
+scew_writer_growable_buffer (scew_writer *writer)
+{
+  scew_writer_growable *grow_writer = NULL;
+
+  assert (writer != NULL);
+
+  grow_writer = scew_writer_data (writer);
+
+  return (NULL == grow_writer->buffer) ? _XT("") : grow_writer->buffer;
+}
+
+size_t
+scew_writer_growable_length (scew_writer *writer)
+{
+  scew_writer_growable *grow_writer = NULL;
+
+  assert (writer != NULL);
+
+  grow_writer = scew_writer_data (writer);
+
+  return grow_writer->current;
+}
+
+XML_Char*
+scew_writer_growable_detach (scew_writer *writer, size_t *length)
+{
+  XML_Char *buffer = NULL;
+  scew_writer_growable *grow_writer = NULL;
+
+  assert (writer != NULL);
+
+  grow_writer = scew_writer_data (writer);
+
+  /* Nothing written yet, the caller still gets an empty string. */
+  if (growable_reserve_ (grow_writer, 0))
+    {
+      buffer = grow_writer->buffer;
+      if (length != NULL)
+        {
+          *length = grow_writer->current;
+        }
+
+      grow_writer->buffer = NULL;
+      grow_writer->size = 0;
+      grow_writer->current = 0;
+    }
+
+  return buffer;
+}
+
+void
+scew_writer_growable_reset (scew_writer *writer)
+{
+  scew_writer_growable *grow_writer = NULL;
+
+  assert (writer != NULL);
+
+  grow_writer = scew_writer_data (writer);
+
+  grow_writer->current = 0;
+  grow_writer->closed = SCEW_FALSE;
+  grow_writer->error = SCEW_FALSE;
+  if (grow_writer->buffer != NULL)
+    {
+      grow_writer->buffer[0] = _XT('\0');
+    }
+}
+
+
+/* Private */
+
+size_t
+growable_write_ (scew_writer *writer, XML_Char const *buffer, size_t char_no)
+{
+  scew_writer_growable *grow_writer = NULL;
+
+  assert (writer != NULL);
+  assert (buffer != NULL);
+
+  grow_writer = scew_writer_data (writer);
+
+  if (grow_writer->closed)
+    {
+      return 0;
+    }
+
+  if (!growable_reserve_ (grow_writer, char_no))
+    {
+      grow_writer->error = SCEW_TRUE;
+      return 0;
+    }
+
+  scew_memcpy (grow_writer->buffer + grow_writer->current, buffer, char_no);
+  grow_writer->current += char_no;
+
+  /* Set null-character to end of buffer. */
+  grow_writer->buffer[grow_writer->current] = _XT('\0');
+
+  return char_no;
+}
+
+scew_bool
+growable_end_ (scew_writer *writer)
+{
+  scew_writer_growable *grow_writer = NULL;
+
+  assert (writer != NULL);
+
+  grow_writer = scew_writer_data (writer);
+
+  return grow_writer->closed;
+}
+
+scew_bool
+growable_error_ (scew_writer *writer)
+{
+  scew_writer_growable *grow_writer = NULL;
+
+  assert (writer != NULL);
+
+  grow_writer = scew_writer_data (writer);
+
+  return grow_writer->error;
+}
+
+scew_bool
+growable_close_ (scew_writer *writer)
+{
+  scew_writer_growable *grow_writer = NULL;
+
+  assert (writer != NULL);
+
+  grow_writer = scew_writer_data (writer);
+
+  /* Written data is still available after closing. */
+  grow_writer->closed = SCEW_TRUE;
+
+  return SCEW_TRUE;
+}
+
+void
+growable_free_ (scew_writer *writer)
+{
+  scew_writer_growable *grow_writer = NULL;
+
+  assert (writer != NULL);
+
+  grow_writer = scew_writer_data (writer);
+
+  free (grow_writer->buffer);
+  free (grow_writer);
+}
+
+scew_bool
+growable_reserve_ (scew_writer_growable *grow_writer, size_t char_no)
+{
+  /* Always leave one space for null-terminated buffer. */
+  size_t needed = grow_writer->current + char_no + 1;
+
+  if (needed > grow_writer->size)
+    {
+      XML_Char *buffer = NULL;
+      size_t size = (0 == grow_writer->size)
+        ? grow_writer->initial_size
+        : grow_writer->size;
+
+      while (size < needed)
+        {
+          size *= 2;
+        }
+
+      buffer = realloc (grow_writer->buffer, size * sizeof (XML_Char));
+      if (NULL == buffer)
+        {
+          return SCEW_FALSE;
+        }
+
+      /* Keep the buffer null-terminated from the start. */
+      buffer[grow_writer->current] = _XT('\0');
+
+      grow_writer->buffer = buffer;
+      grow_writer->size = size;
+    }
+
+  return SCEW_TRUE;
+}
@@ -0,0 +1,119 @@
+/**
+ * @file     writer_growable.h
+ * @brief    SCEW writer functions for growable memory buffers
+ * @author   Aleix Conchillo Flaque <aconchillo@gmail.com>
+ * @date     Sun Oct 18, 2026 10:12
+ * @ingroup  SCEWWriterMemory
+ *
+ * @if copyright
+ *
+ * Copyright (C) 2026 Aleix Conchillo Flaque
+ *
+ * SCEW is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * SCEW is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ *
+ * @endif
+ */
+
+#ifndef WRITER_GROWABLE_H_2610181012
+#define WRITER_GROWABLE_H_2610181012
+
+#include "export.h"
+
+#include "writer.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * Creates a new SCEW writer that writes to a memory buffer owned by
+ * the writer. The buffer grows as needed, so, unlike
+ * #scew_writer_buffer_create, data is never truncated. The written
+ * data can be accessed with #scew_writer_growable_buffer or taken
+ * over with #scew_writer_growable_detach.
+ *
+ * @param size the initial size of the buffer (in characters). If 0, a
+ * default size is used.
+ *
+ * @return a new SCEW writer, or NULL if the writer could not be
+ * created.
+ *
+ * @ingroup SCEWWriterMemory
+ */
+extern SCEW_API scew_writer* scew_writer_growable_create (size_t size);
+
+/**
+ * Returns the data written so far to the given growable @a writer
+ * (always null-terminated). The returned buffer is owned by the
+ * writer and is only valid until the next write, reset or detach.
+ *
+ * @pre writer != NULL
+ * @pre writer was created with #scew_writer_growable_create.
+ *
+ * @ingroup SCEWWriterMemory
+ */
+extern SCEW_API XML_Char const*
+scew_writer_growable_buffer (scew_writer *writer);
+
+/**
+ * Returns the number of characters written so far to the given
+ * growable @a writer (without the null character).
+ *
+ * @pre writer != NULL
+ * @pre writer was created with #scew_writer_growable_create.
+ *
+ * @ingroup SCEWWriterMemory
+ */
+extern SCEW_API size_t scew_writer_growable_length (scew_writer *writer);
+
+/**
+ * Takes over the buffer of the given growable @a writer, without
+ * copying it. The buffer is null-terminated and must be freed by the
+ * caller with free. After this call the writer is empty and can still
+ * be used, a new buffer will be allocated on the next write.
+ *
+ * @pre writer != NULL
+ * @pre writer was created with #scew_writer_growable_create.
+ *
+ * @param writer the writer to take the buffer from.
+ * @param length if not NULL, the number of characters in the buffer
+ * (without the null character) is stored here.
+ *
+ * @return the written data, or NULL if no memory is available.
+ *
+ * @ingroup SCEWWriterMemory
+ */
+extern SCEW_API XML_Char* scew_writer_growable_detach (scew_writer *writer,
+                                                       size_t *length);
+
+/**
+ * Discards all the data written to the given growable @a writer, so
+ * it can be reused (e.g. for another document). The buffer memory is
+ * kept to avoid new allocations. The writer is also reopened if it
+ * was closed and any previous error is cleared.
+ *
+ * @pre writer != NULL
+ * @pre writer was created with #scew_writer_growable_create.
+ *
+ * @ingroup SCEWWriterMemory
+ */
+extern SCEW_API void scew_writer_growable_reset (scew_writer *writer);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* WRITER_GROWABLE_H_2610181012 */
@@ -0,0 +1,315 @@
+/**
+ * @file     xarena.c
+ * @brief    xarena.h implementation
+ * @author   Aleix Conchillo Flaque <aconchillo@gmail.com>
+ * @date     Sun Oct 18, 2026 10:12
+ *
+ * @if copyright
+ *
+ * Copyright (C) 2026 Aleix Conchillo Flaque
+ *
+ * SCEW is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * SCEW is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ *
+ * @endif
+ */
+
+#include "xarena.h"
+
+#include "str.h"
+
+#include <assert.h>
+#include <stdlib.h>
+
+
+/* Private */
+
+enum
+  {
+    MIN_CHUNK_SIZE_ = 64 * 1024,        /**< Size of the first chunk */
+    MAX_CHUNK_SIZE_ = 4 * 1024 * 1024,  /**< Maximum size of new chunks */
+    ALIGNMENT_ = 8,                     /**< Allocation alignment */
+    MIN_NAMES_SIZE_ = 64                /**< Initial names table size */
+  };
+
+typedef struct arena_chunk arena_chunk;
+
+struct arena_chunk
+{
+  arena_chunk *next;            /**< Next (older) chunk */
+  size_t size;                  /**< Usable bytes in this chunk */
+  size_t used;                  /**< Used bytes in this chunk */
+};
+
+struct scew_arena
+{
+  arena_chunk *chunks;          /**< Current chunk (head of list) */
+  size_t next_size;             /**< Size for the next chunk */
+  scew_bool foreign;            /**< Whether foreign objects are linked */
+  XML_Char **names;             /**< Interned names (open addressing) */
+  size_t names_size;            /**< Slots in the names table */
+  size_t n_names;               /**< Number of interned names */
+};
+
+/**
+ * Header size rounded to the alignment, so chunk data is aligned.
+ */
+#define CHUNK_HEADER_SIZE_                                              \
+  ((sizeof (arena_chunk) + ALIGNMENT_ - 1) & ~((size_t) ALIGNMENT_ - 1))
+
+#define CHUNK_DATA_(chunk) ((char *) (chunk) + CHUNK_HEADER_SIZE_)
+
+static arena_chunk* add_chunk_ (scew_arena *arena, size_t size);
+
+static size_t hash_name_ (XML_Char const *name);
+static scew_bool grow_names_ (scew_arena *arena);
+
+
+/* Protected */
+
+scew_arena*
+scew_arena_create_ (void)
+{
+  scew_arena *arena = calloc (1, sizeof (scew_arena));
+
+  if (arena != NULL)
+    {
+      arena->next_size = MIN_CHUNK_SIZE_;
+    }
+
+  return arena;
+}
+
+void
+scew_arena_free_ (scew_arena *arena)
+{
+  if (arena != NULL)
+    {
+      arena_chunk *chunk = arena->chunks;
+      while (chunk != NULL)
+        {
+          arena_chunk *next = chunk->next;
+          free (chunk);
+          chunk = next;
+        }
+      free (arena->names);
+      free (arena);
+    }
+}
+
+void*
+scew_arena_alloc_ (scew_arena *arena, size_t size)
+{
+  void *ptr = NULL;
+  arena_chunk *chunk = NULL;
+
+  if (NULL == arena)
+    {
+      return calloc (1, size);
+    }
+
+  size = (size + ALIGNMENT_ - 1) & ~((size_t) ALIGNMENT_ - 1);
+
+  chunk = arena->chunks;
+  if ((NULL == chunk) || (chunk->size - chunk->used < size))
+    {
+      chunk = add_chunk_ (arena, size);
+    }
+
+  if (chunk != NULL)
+    {
+      ptr = CHUNK_DATA_ (chunk) + chunk->used;
+      chunk->used += size;
+    }
+
+  return ptr;
+}
+
+void
+scew_arena_release_ (scew_arena *arena, void *ptr)
+{
+  if (NULL == arena)
+    {
+      free (ptr);
+    }
+}
+
+XML_Char*
+scew_arena_strdup_ (scew_arena *arena, XML_Char const *src)
+{
+  XML_Char *out = NULL;
+
+  if (src != NULL)
+    {
+      size_t len = scew_strlen (src);
+      out = scew_arena_alloc_ (arena, (len + 1) * sizeof (XML_Char));
+      if (out != NULL)
+        {
+          scew_memcpy (out, src, len + 1);
+        }
+    }
+
+  return out;
+}
+
+XML_Char*
+scew_arena_intern_ (scew_arena *arena, XML_Char const *name)
+{
+  size_t mask = 0;
+  size_t slot = 0;
+
+  assert (name != NULL);
+
+  if (NULL == arena)
+    {
+      return scew_arena_strdup_ (NULL, name);
+    }
+
+  /* Keep the table at most half full. */
+  if ((2 * (arena->n_names + 1) > arena->names_size) && !grow_names_ (arena))
+    {
+      return NULL;
+    }
+
+  mask = arena->names_size - 1;
+  slot = hash_name_ (name) & mask;
+  while (arena->names[slot] != NULL)
+    {
+      if (scew_strcmp (arena->names[slot], name) == 0)
+        {
+          return arena->names[slot];
+        }
+      slot = (slot + 1) & mask;
+    }
+
+  arena->names[slot] = scew_arena_strdup_ (arena, name);
+  if (arena->names[slot] != NULL)
+    {
+      arena->n_names += 1;
+    }
+
+  return arena->names[slot];
+}
+
+void
+scew_arena_set_foreign_ (scew_arena *arena)
+{
+  if (arena != NULL)
+    {
+      arena->foreign = SCEW_TRUE;
+    }
+}
+
+scew_bool
+scew_arena_foreign_ (scew_arena const *arena)
+{
+  assert (arena != NULL);
+
+  return arena->foreign;
+}
+
+
+/* Private */
+
+arena_chunk*
+add_chunk_ (scew_arena *arena, size_t size)
+{
+  arena_chunk *chunk = NULL;
+  size_t chunk_size = arena->next_size;
+
+  /* Big objects get a chunk on their own. */
+  if (size > chunk_size / 4)
+    {
+      chunk_size = size;
+    }
+
+  /* Chunk memory comes zero-initialized. */
+  chunk = calloc (1, CHUNK_HEADER_SIZE_ + chunk_size);
+  if (chunk != NULL)
+    {
+      chunk->size = chunk_size;
+      chunk->used = 0;
+
+      if ((chunk_size == size) && (arena->chunks != NULL))
+        {
+          /* Keep allocating from the current chunk. */
+          chunk->next = arena->chunks->next;
+          arena->chunks->next = chunk;
+        }
+      else
+        {
+          chunk->next = arena->chunks;
+          arena->chunks = chunk;
+
+          /* Grow chunks geometrically so big trees use a few chunks. */
+          if (arena->next_size < MAX_CHUNK_SIZE_)
+            {
+              arena->next_size *= 2;
+            }
+        }
+    }
+
+  return chunk;
+}
+
+size_t
+hash_name_ (XML_Char const *name)
+{
+  /* FNV-1a */
+  size_t hash = 2166136261U;
+
+  while (*name != _XT('\0'))
+    {
+      hash = (hash ^ (size_t) *name) * 16777619U;
+      ++name;
+    }
+
+  return hash;
+}
+
+scew_bool
+grow_names_ (scew_arena *arena)
+{
+  size_t i = 0;
+  size_t size = (0 == arena->names_size)
+    ? MIN_NAMES_SIZE_
+    : arena->names_size * 2;
+  XML_Char **names = calloc (size, sizeof (XML_Char *));
+
+  if (NULL == names)
+    {
+      return SCEW_FALSE;
+    }
+
+  /* Rehash existing names into the new table. */
+  for (i = 0; i < arena->names_size; ++i)
+    {
+      if (arena->names[i] != NULL)
+        {
+          size_t slot = hash_name_ (arena->names[i]) & (size - 1);
+          while (names[slot] != NULL)
+            {
+              slot = (slot + 1) & (size - 1);
+            }
+          names[slot] = arena->names[i];
+        }
+    }
+
+  free (arena->names);
+  arena->names = names;
+  arena->names_size = size;
+
+  return SCEW_TRUE;
+}
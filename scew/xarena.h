@@ -0,0 +1,129 @@
+/**
+ * @file     xarena.h
+ * @brief    SCEW private memory arena
+ * @author   Aleix Conchillo Flaque <aconchillo@gmail.com>
+ * @date     Sun Oct 18, 2026 10:12
+ *
+ * @if copyright
+ *
+ * Copyright (C) 2026 Aleix Conchillo Flaque
+ *
+ * SCEW is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * SCEW is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ *
+ * @endif
+ */
+
+
+#ifndef XARENA_H_2610181012
+#define XARENA_H_2610181012
+
+#include "export.h"
+
+#include "bool.h"
+
+#include <expat.h>
+
+#include <stddef.h>
+
+
+/* Types */
+
+/**
+ * A memory arena is a set of big memory chunks from where small
+ * objects (elements, attributes, strings...) are allocated. Objects
+ * allocated from an arena are not freed individually, the whole arena
+ * is freed at once instead.
+ *
+ * Arenas also keep a table of interned names, so element and
+ * attribute names repeated across a document are only stored once.
+ *
+ * All arena functions also accept a NULL arena, in which case regular
+ * heap allocation is used. This allows objects to keep a reference to
+ * the arena they were allocated from (if any) and use the same code
+ * path in both cases.
+ */
+typedef struct scew_arena scew_arena;
+
+
+/* Functions */
+
+/**
+ * Creates a new empty arena.
+ *
+ * @return a new arena, or NULL if no memory is available.
+ */
+extern SCEW_LOCAL scew_arena* scew_arena_create_ (void);
+
+/**
+ * Frees all the memory chunks of the given @a arena, and therefore,
+ * all the objects allocated from it. If a NULL @a arena is given,
+ * this function takes no action.
+ */
+extern SCEW_LOCAL void scew_arena_free_ (scew_arena *arena);
+
+/**
+ * Allocates @a size bytes of zero-initialized memory from the given
+ * @a arena, or from the heap if @a arena is NULL.
+ *
+ * @return the allocated memory, or NULL if no memory is available.
+ */
+extern SCEW_LOCAL void* scew_arena_alloc_ (scew_arena *arena, size_t size);
+
+/**
+ * Releases the given memory, previously allocated from @a arena. If
+ * @a arena is NULL the memory is freed, otherwise this function takes
+ * no action, as the memory will be freed with the arena.
+ */
+extern SCEW_LOCAL void scew_arena_release_ (scew_arena *arena, void *ptr);
+
+/**
+ * Creates a new copy of the given string allocated from @a arena (or
+ * the heap if @a arena is NULL).
+ *
+ * @return the new string, or NULL if the given string is NULL or no
+ * memory is available.
+ */
+extern SCEW_LOCAL XML_Char* scew_arena_strdup_ (scew_arena *arena,
+                                                XML_Char const *src);
+
+/**
+ * Returns the interned copy of the given @a name in @a arena, adding
+ * it to the arena names table if necessary. Equal names interned in
+ * the same arena share the same pointer. If @a arena is NULL, a new
+ * heap copy is returned instead.
+ *
+ * @return the interned name, or NULL if no memory is available.
+ */
+extern SCEW_LOCAL XML_Char* scew_arena_intern_ (scew_arena *arena,
+                                                XML_Char const *name);
+
+/**
+ * Marks the given @a arena as having foreign objects (i.e. objects
+ * not allocated from the arena) linked to its objects. Those objects
+ * need to be freed individually. If a NULL @a arena is given, this
+ * function takes no action.
+ */
+extern SCEW_LOCAL void scew_arena_set_foreign_ (scew_arena *arena);
+
+/**
+ * Tells whether foreign objects have been linked to objects of the
+ * given @a arena.
+ *
+ * @pre arena != NULL
+ */
+extern SCEW_LOCAL scew_bool scew_arena_foreign_ (scew_arena const *arena);
+
+#endif /* XARENA_H_2610181012 */
@@ -27,6 +27,7 @@
  */
 
 #include "xattribute.h"
+#include "xerror.h"
 
 #include <assert.h>
 
@@ -34,6 +35,39 @@
 
 /* Protected */
 
+scew_attribute*
+scew_attribute_arena_create_ (scew_arena *arena,
+                              XML_Char const *name,
+                              XML_Char const *value)
+{
+  scew_attribute *attribute = NULL;
+
+  assert (name != NULL);
+  assert (value != NULL);
+
+  attribute = scew_arena_alloc_ (arena, sizeof (scew_attribute));
+
+  if (attribute != NULL)
+    {
+      attribute->arena = arena;
+      attribute->name = scew_arena_intern_ (arena, name);
+      attribute->value = scew_arena_strdup_ (arena, value);
+
+      if ((NULL == attribute->name) || (NULL == attribute->value))
+        {
+          scew_attribute_free (attribute);
+          attribute = NULL;
+        }
+    }
+
+  if (NULL == attribute)
+    {
+      scew_error_set_last_error_ (scew_error_no_memory);
+    }
+
+  return attribute;
+}
+
 void
 scew_attribute_set_parent_ (scew_attribute *attribute,
                             scew_element const *parent)
@@ -34,6 +34,8 @@
 
 #include "attribute.h"
 
+#include "xarena.h"
+
 
 /* Types */
 
@@ -42,11 +44,26 @@ struct scew_attribute
   XML_Char *name;               /**< The attribute's name */
   XML_Char *value;              /**< The attribute's value */
   scew_element *parent;         /**< The XML element parent (if any) */
+  scew_arena *arena;            /**< Arena the attribute was allocated
+                                   from (NULL if allocated from the heap) */
 };
 
 
 /* Functions */
 
+/**
+ * Creates a new attribute with the given @a name and @a value
+ * allocated from @a arena. If @a arena is NULL, this is the same as
+ * #scew_attribute_create.
+ *
+ * @pre name != NULL
+ * @pre value != NULL
+ */
+extern SCEW_LOCAL scew_attribute*
+scew_attribute_arena_create_ (scew_arena *arena,
+                              XML_Char const *name,
+                              XML_Char const *value);
+
 /**
  * Sets a new @a parent to the given @a attribute, NULL is also
  * allowed. Note that the element should be first detached from its
@@ -29,31 +29,156 @@
 #ifndef XELEMENT_H_0908270147
 #define XELEMENT_H_0908270147
 
+#include "export.h"
+
 #include "element.h"
 
 #include "list.h"
 
+#include "xarena.h"
+
 #include <expat.h>
 
 
 /* Types */
 
+/**
+ * Index of the children of an element by name.
+ */
+typedef struct scew_element_index scew_element_index;
+
+/**
+ * Index of all the elements of a tree by name (see xtree.h).
+ */
+typedef struct scew_tree_index scew_tree_index;
+
 struct scew_element
 {
   XML_Char *name;               /**< The element's name */
   XML_Char *contents;           /**< The element's text contents */
 
   scew_element *parent;         /**< The parent of the element (if any) */
-  scew_list *myself;            /**< Pointer to parent's children list
+  unsigned int index;           /**< Position in parent's children array
                                    (performance) */
 
   unsigned int n_children;      /**< Number of children (if any) */
-  scew_list *children;          /**< List of children elements */
-  scew_list *last_child;        /**< Pointer to last child (performance) */
+  unsigned int children_size;   /**< Allocated slots for children */
+  scew_element **children;      /**< Array of children elements */
+  scew_list *children_list;     /**< List view of the children array
+                                   (see #scew_element_children) */
+  scew_bool children_list_valid; /**< Whether the list view is up to
+                                    date */
+  scew_element_index *children_index; /**< Children by name (only for
+                                         elements with many children) */
 
   unsigned int n_attributes;    /**< Number of attributes (if any) */
   scew_list *attributes;        /**< List of attributes */
   scew_list *last_attribute;    /**< Pointer to last attribute (performance) */
+
+  scew_arena *arena;            /**< Arena the element was allocated from
+                                   (NULL if allocated from the heap) */
+
+  scew_hash hash;               /**< Structural hash (if computed) */
+  scew_bool hash_valid;         /**< Whether the hash is up to date */
+
+  scew_tree_index *tree_index;  /**< Index of the tree the element
+                                   belongs to (if the tree is indexed) */
 };
 
+
+
+/* Functions */
+
+/**
+ * Creates a new element with the given @a name allocated from @a
+ * arena. The element name, contents, attributes and children lists
+ * will also be allocated from the arena. If @a arena is NULL, this is
+ * the same as #scew_element_create.
+ *
+ * @pre name != NULL
+ */
+extern SCEW_LOCAL scew_element*
+scew_element_arena_create_ (scew_arena *arena, XML_Char const *name);
+
+/**
+ * Same as #scew_element_create_with_attributes, but the element and
+ * its attributes are allocated from @a arena (or the heap if @a arena
+ * is NULL).
+ *
+ * @pre name != NULL
+ * @pre attrs != NULL
+ */
+extern SCEW_LOCAL scew_element*
+scew_element_arena_create_with_attributes_ (scew_arena *arena,
+                                            XML_Char const *name,
+                                            XML_Char const **attrs);
+
+/**
+ * Makes a deep copy of the given @a element allocated from @a arena,
+ * using up to @a n_threads threads. The size of the copy is computed
+ * first, so the whole copy takes a single arena block, and subtrees
+ * are then copied in parallel into separate parts of that block.
+ *
+ * @pre arena != NULL
+ * @pre element != NULL
+ * @pre n_threads > 0
+ *
+ * @return the new element, or NULL if no memory is available.
+ */
+extern SCEW_LOCAL scew_element*
+scew_element_arena_copy_ (scew_arena *arena,
+                          scew_element const *element,
+                          unsigned int n_threads);
+
+/**
+ * Tells the given @a element and its ancestors that their structural
+ * hashes are no longer valid. Must be called whenever the name,
+ * contents, attributes or children of @a element change. If a NULL @a
+ * element is given, this function takes no action.
+ */
+extern SCEW_LOCAL void scew_element_hash_invalidate_ (scew_element *element);
+
+/**
+ * Obtains the @a children of the given @a element named @a name (in
+ * the same order as in @a element) from the children index. The
+ * index is never built here, so this does not modify @a element and
+ * might be called from different threads at the same time.
+ *
+ * @return true if the index could be used (@a n_children might be 0
+ * if no children are found), false otherwise.
+ */
+extern SCEW_LOCAL scew_bool
+scew_element_index_lookup_ (scew_element const *element,
+                            XML_Char const *name,
+                            scew_element * const **children,
+                            unsigned int *n_children);
+
+/**
+ * Builds the children index of the given @a element, but only if it
+ * has many children and it has not been built yet. Elements whose
+ * children are not added via #scew_element_index_add_ must call this.
+ */
+extern SCEW_LOCAL void scew_element_index_build_ (scew_element *element);
+
+/**
+ * Adds the given @a child of @a element to the children index, which
+ * is built once @a element has many children. Must be called once @a
+ * child has been added to @a element or renamed.
+ */
+extern SCEW_LOCAL void scew_element_index_add_ (scew_element *element,
+                                                scew_element *child);
+
+/**
+ * Removes the given @a child of @a element from the children index
+ * (if any). Must be called before @a child is detached from @a
+ * element or renamed.
+ */
+extern SCEW_LOCAL void scew_element_index_remove_ (scew_element *element,
+                                                   scew_element *child);
+
+/**
+ * Frees the children index of the given @a element (if any).
+ */
+extern SCEW_LOCAL void scew_element_index_free_ (scew_element *element);
+
 #endif /* XELEMENT_H_0908270147 */
@@ -0,0 +1,89 @@
+/**
+ * @file     xlist.h
+ * @brief    SCEW private list routines
+ * @author   Aleix Conchillo Flaque <aconchillo@gmail.com>
+ * @date     Sun Oct 18, 2026 10:12
+ *
+ * @if copyright
+ *
+ * Copyright (C) 2026 Aleix Conchillo Flaque
+ *
+ * SCEW is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * SCEW is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ *
+ * @endif
+ */
+
+
+#ifndef XLIST_H_2610181012
+#define XLIST_H_2610181012
+
+#include "export.h"
+
+#include "list.h"
+
+#include "xarena.h"
+
+
+/* Types */
+
+struct scew_list
+{
+  void *data;
+  scew_list *prev;
+  scew_list *next;
+};
+
+
+/* Functions */
+
+/**
+ * Same as #scew_list_append, but the new item is allocated from the
+ * given @a arena (or the heap if @a arena is NULL).
+ */
+extern SCEW_LOCAL scew_list* scew_list_arena_append_ (scew_arena *arena,
+                                                      scew_list *list,
+                                                      void *data);
+
+/**
+ * Same as #scew_list_delete_item, but the @a item is released to the
+ * given @a arena (or freed if @a arena is NULL).
+ */
+extern SCEW_LOCAL scew_list* scew_list_arena_delete_item_ (scew_arena *arena,
+                                                           scew_list *list,
+                                                           scew_list *item);
+
+/**
+ * Same as #scew_list_free, but all the items are released to the
+ * given @a arena (or freed if @a arena is NULL).
+ */
+extern SCEW_LOCAL void scew_list_arena_free_ (scew_arena *arena,
+                                              scew_list *list);
+
+/**
+ * Makes the given @a list contain exactly the first @a n_data
+ * pointers of @a data, in order. Existing items are reused, so they
+ * remain valid, and new items are allocated from the given @a arena
+ * (or the heap if @a arena is NULL). Items left over are released.
+ *
+ * @return the updated list (NULL if @a n_data is 0 or on memory
+ * allocation errors, in which case all the items are released).
+ */
+extern SCEW_LOCAL scew_list* scew_list_arena_assign_ (scew_arena *arena,
+                                                      scew_list *list,
+                                                      void * const *data,
+                                                      unsigned int n_data);
+
+#endif /* XLIST_H_2610181012 */
@@ -26,21 +26,36 @@
  * @endif
  */
 
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
 #include "xparser.h"
 
 #include "str.h"
 
+#include "xelement.h"
 #include "xerror.h"
+#include "xtree.h"
 
 #include <assert.h>
 
 
 /* Private */
 
+enum
+  {
+    MIN_TEXT_BUFFER_ = 256,     /**< Initial size of the text buffer */
+    MIN_STACK_SIZE_ = 16        /**< Initial size of the element stack */
+  };
+
 struct stack_element
 {
   scew_element* element;
-  struct stack_element* prev;
+  size_t text_start;            /**< Start of element text in parser */
+  scew_bool has_text;           /**< Whether non-space text was found */
+  scew_bool flattened;          /**< Whether element is its parent, as
+                                   the actual element is flattened */
 };
 
 /**
@@ -86,16 +101,35 @@ static void stop_expat_parsing_ (scew_parser *parser, scew_error error);
 static scew_tree* create_tree_ (scew_parser *parser);
 
 /**
- * Creates a new element with the given name and attributes.
+ * Creates a new element with the given name and attributes, allocated
+ * from the parser arena (if any).
  */
-static scew_element* create_element_ (XML_Char const *name,
+static scew_element* create_element_ (scew_parser *parser,
+                                      XML_Char const *name,
                                       XML_Char const **attrs);
 
 /**
- * Pushes an element into the stack returning the pushed element.
+ * Sets the text accumulated since @a start as the contents of the
+ * given element and removes it from the parser text buffer.
+ */
+static scew_bool text_flush_ (scew_parser *parser,
+                              scew_element *element,
+                              size_t start);
+
+/**
+ * Drops the text of the current element if it is only white spaces
+ * (and white spaces are ignored). Otherwise, spaces around consumed
+ * children would grow without bound.
+ */
+static void text_drop_spaces_ (scew_parser *parser);
+
+/**
+ * Pushes an element into the stack, growing it if necessary. For
+ * flattened elements, the nearest built ancestor is pushed instead.
  */
-static stack_element* parser_stack_push_ (scew_parser *parser,
-                                          scew_element *element);
+static scew_bool parser_stack_push_ (scew_parser *parser,
+                                     scew_element *element,
+                                     scew_bool flattened);
 
 /**
  * Pops an element from the stack returning the new top element (not
@@ -111,11 +145,20 @@ scew_parser_stack_free_ (scew_parser *parser)
 {
   if (parser != NULL)
     {
-      scew_element *element = parser_stack_pop_ (parser);
-      while (element != NULL)
+      while (parser->stack_depth > 0)
         {
-          scew_element_free (element);
-          element = parser_stack_pop_ (parser);
+          stack_element *top = &parser->stack[parser->stack_depth - 1];
+
+          parser->stack_depth -= 1;
+
+          /**
+           * Flattened elements repeat their parent, which is freed
+           * later. Elements in the arena are freed with the arena.
+           */
+          if (!top->flattened && (NULL == parser->arena))
+            {
+              scew_element_free (top->element);
+            }
         }
     }
 }
@@ -132,6 +175,60 @@ scew_parser_expat_install_handlers_ (scew_parser *parser)
 
   /* Data to be passed to all handlers is the SCEW parser. */
   XML_SetUserData (parser->parser, parser);
+
+  /* Expat resets this option, so it needs to be set again. */
+  scew_parser_set_stream_ (parser, parser->stream);
+}
+
+void
+scew_parser_set_stream_ (scew_parser *parser, scew_bool stream)
+{
+  parser->stream = stream;
+
+#ifdef HAVE_XML_SETREPARSEDEFERRALENABLED
+  /**
+   * Streams are split right after root end tags, so Expat must parse
+   * all the complete tokens it is given. Otherwise, the end tag of
+   * the last document might never be parsed if no more data comes.
+   */
+  XML_SetReparseDeferralEnabled (parser->parser, stream ? XML_FALSE : XML_TRUE);
+#endif /* HAVE_XML_SETREPARSEDEFERRALENABLED */
+}
+
+scew_bool
+scew_parser_text_append_ (scew_parser *parser,
+                          XML_Char const *str,
+                          size_t len)
+{
+  /* Always leave one space for the null character. */
+  size_t needed = parser->text_length + len + 1;
+
+  if (needed > parser->text_size)
+    {
+      XML_Char *text = NULL;
+      size_t size = (0 == parser->text_size)
+        ? MIN_TEXT_BUFFER_
+        : parser->text_size;
+
+      while (size < needed)
+        {
+          size *= 2;
+        }
+
+      text = realloc (parser->text, size * sizeof (XML_Char));
+      if (NULL == text)
+        {
+          return SCEW_FALSE;
+        }
+
+      parser->text = text;
+      parser->text_size = size;
+    }
+
+  scew_memcpy (&parser->text[parser->text_length], str, len);
+  parser->text_length += len;
+
+  return SCEW_TRUE;
 }
 
 
@@ -191,7 +288,7 @@ expat_default_handler_ (void *data, XML_Char const *str, int len)
     }
 
   /* Only analyze data if we still have to reach the root element. */
-  if (NULL == parser->stack)
+  if (0 == parser->stack_depth)
     {
       unsigned int total = 0;
       unsigned int total_old = 0;
@@ -232,7 +329,6 @@ expat_start_handler_ (void *data,
 {
   scew_parser *parser = (scew_parser *) data;
   scew_element *element = NULL;
-  stack_element *stack = NULL;
 
   if (NULL == parser)
     {
@@ -240,8 +336,51 @@ expat_start_handler_ (void *data,
       return;
     }
 
+  /* Only depth is tracked inside skipped subtrees. */
+  if (parser->skip_depth > 0)
+    {
+      parser->skip_depth += 1;
+      return;
+    }
+
+  /* Filter elements before allocating anything (roots are built). */
+  if ((parser->filter_hook.hook != NULL) && (parser->stack_depth > 0))
+    {
+      scew_element *parent = parser->stack[parser->stack_depth - 1].element;
+      void *user_data = parser->filter_hook.data;
+      switch (parser->filter_hook.hook (parser, parent, name, attrs,
+                                        user_data))
+        {
+        case scew_parser_filter_build:
+          break;
+        case scew_parser_filter_skip:
+          parser->skip_depth = 1;
+          return;
+        case scew_parser_filter_flatten:
+          if (!parser_stack_push_ (parser, parent, SCEW_TRUE))
+            {
+              stop_expat_parsing_ (parser, scew_error_no_memory);
+            }
+          return;
+        default:
+          stop_expat_parsing_ (parser, scew_error_hook);
+          return;
+        }
+    }
+
+  /* All the elements of a tree are allocated in the same arena. */
+  if (parser->use_arena && (NULL == parser->arena))
+    {
+      parser->arena = scew_arena_create_ ();
+      if (NULL == parser->arena)
+        {
+          stop_expat_parsing_ (parser, scew_error_no_memory);
+          return;
+        }
+    }
+
   /* Create element. */
-  element = create_element_ (name, attrs);
+  element = create_element_ (parser, name, attrs);
   if (NULL == element)
     {
       stop_expat_parsing_ (parser, scew_error_no_memory);
@@ -249,15 +388,14 @@ expat_start_handler_ (void *data,
     }
 
   /* Add the element to its parent (if any). */
-  if (parser->stack != NULL)
+  if (parser->stack_depth > 0)
     {
-      scew_element *parent = parser->stack->element;
+      scew_element *parent = parser->stack[parser->stack_depth - 1].element;
       scew_element_add_element (parent, element);
     }
 
   /* Push element onto the stack. */
-  stack = parser_stack_push_ (parser, element);
-  if (NULL == stack)
+  if (!parser_stack_push_ (parser, element, SCEW_FALSE))
     {
       stop_expat_parsing_ (parser, scew_error_no_memory);
       return;
@@ -269,24 +407,35 @@ expat_end_handler_ (void *data, XML_Char const *elem)
 {
   scew_parser *parser = (scew_parser *) data;
   scew_element *current = NULL;
-  XML_Char const *contents = NULL;
+  size_t text_start = 0;
 
   if (NULL == parser)
     {
       stop_expat_parsing_ (parser, scew_error_internal);
       return;
     }
+
+  if (parser->skip_depth > 0)
+    {
+      parser->skip_depth -= 1;
+      return;
+    }
+
+  /* Text of flattened elements is left to their parent. */
+  if (parser->stack[parser->stack_depth - 1].flattened)
+    {
+      parser_stack_pop_ (parser);
+      return;
+    }
+
+  text_start = parser->stack[parser->stack_depth - 1].text_start;
   current = parser_stack_pop_ (parser);
 
-  /* Trim element contents if necessary. */
-  contents = scew_element_contents (current);
-  if (parser->ignore_whitespaces && (contents != NULL))
+  /* Element contents are only set once, when the element is complete. */
+  if (!text_flush_ (parser, current, text_start))
     {
-      /* If element contents is all spaces, get rid of the contents. */
-      if (scew_isempty (contents))
-        {
-          scew_element_free_contents (current);
-        }
+      stop_expat_parsing_ (parser, scew_error_no_memory);
+      return;
     }
 
   /* Call loaded element hook. */
@@ -300,8 +449,30 @@ expat_end_handler_ (void *data, XML_Char const *elem)
         }
     }
 
+  /* Consumed elements leave the tree (the root is always kept). */
+  if ((parser->consume_hook.hook != NULL) && (parser->stack_depth > 0))
+    {
+      void *user_data = parser->consume_hook.data;
+      switch (parser->consume_hook.hook (parser, current, user_data))
+        {
+        case scew_parser_consume_keep:
+          break;
+        case scew_parser_consume_free:
+          scew_element_free (current);
+          text_drop_spaces_ (parser);
+          return;
+        case scew_parser_consume_take:
+          scew_element_detach (current);
+          text_drop_spaces_ (parser);
+          return;
+        default:
+          stop_expat_parsing_ (parser, scew_error_hook);
+          return;
+        }
+    }
+
   /* If there are no more elements (root node) ... */
-  if (NULL == parser->stack)
+  if (0 == parser->stack_depth)
     {
       /**
        * ... we create the XML document tree. If we need to create the
@@ -333,6 +504,13 @@ expat_end_handler_ (void *data, XML_Char const *elem)
 
       scew_tree_set_root_element (parser->tree, current);
 
+      /* The tree owns the arena (if any) from now on. */
+      if (parser->arena != NULL)
+        {
+          scew_tree_set_arena_ (parser->tree, parser->arena);
+          parser->arena = NULL;
+        }
+
       /* Call loaded tree hook. */
       if (parser->tree_hook.hook != NULL)
         {
@@ -343,6 +521,19 @@ expat_end_handler_ (void *data, XML_Char const *elem)
               return;
             }
         }
+
+      /**
+       * In streams, the tree belongs to the tree hook now. Expat is
+       * suspended so the rest of the data can be given to a new
+       * document, starting right after this end tag.
+       */
+      if (parser->stream)
+        {
+          parser->tree = NULL;
+          parser->stream_end = XML_GetCurrentByteIndex (parser->parser)
+            + XML_GetCurrentByteCount (parser->parser);
+          XML_StopParser (parser->parser, XML_TRUE);
+        }
     }
 }
 
@@ -350,11 +541,6 @@ void
 expat_char_handler_ (void *data, XML_Char const *str, int len)
 {
   scew_parser *parser = (scew_parser *) data;
-  scew_element *current = NULL;
-  XML_Char const *contents = NULL;
-  XML_Char *new_contents = NULL;
-  unsigned int total_old = 0;
-  unsigned int total = 0;
 
   if (NULL == parser)
     {
@@ -362,40 +548,21 @@ expat_char_handler_ (void *data, XML_Char const *str, int len)
       return;
     }
 
-  /**
-   * We don't want to pop here, just get the current element. Pop is
-   * done in the end handler.
-   */
-  current = parser->stack->element;
-
-  /* Get size of current contents. */
-  contents = scew_element_contents (current);
-  if (contents != NULL)
+  if (parser->skip_depth > 0)
     {
-      total_old = scew_strlen (contents);
+      return;
     }
 
   /**
-   * Calculate new size and allocate enough space (+ 1 for
-   * null-terminated string).
+   * Text is accumulated in the parser and set to the current element
+   * in the end handler. Expat might call this handler many times for
+   * the same element.
    */
-  total = (total_old + len + 1) * sizeof (XML_Char);
-  new_contents = calloc (total, 1);
-
-  /* Copy old contents (if any) and concatenate new one. */
-  if (contents != NULL)
+  if (!scew_parser_text_append_ (parser, str, len))
     {
-      scew_strcpy (new_contents, contents);
+      stop_expat_parsing_ (parser, scew_error_no_memory);
+      return;
     }
-  scew_strncat (new_contents, str, len);
-
-  scew_element_set_contents (current, new_contents);
-
-  /**
-   * new_contents is duplicated inside scew_element_set_contents so it
-   * is safe to free it here.
-   */
-  free (new_contents);
 }
 
 
@@ -424,66 +591,117 @@ create_tree_ (scew_parser *parser)
 }
 
 scew_element*
-create_element_ (XML_Char const *name, XML_Char const **attrs)
+create_element_ (scew_parser *parser,
+                 XML_Char const *name,
+                 XML_Char const **attrs)
+{
+  /* Expat already checks that attribute names are unique. */
+  return scew_element_arena_create_with_attributes_ (parser->arena,
+                                                     name,
+                                                     attrs);
+}
+
+
+/* Private (text) */
+
+scew_bool
+text_flush_ (scew_parser *parser, scew_element *element, size_t start)
 {
-  scew_element *element = scew_element_create (name);
+  scew_bool result = SCEW_TRUE;
 
-  unsigned int i = 0;
-  for (i = 0; (element != NULL) && (attrs[i] != NULL); i += 2)
+  if (parser->text_length > start)
     {
-      scew_attribute *attr = scew_element_add_attribute_pair (element,
-                                                              attrs[i],
-                                                              attrs[i + 1]);
-      if (NULL == attr)
+      XML_Char const *contents = &parser->text[start];
+
+      parser->text[parser->text_length] = _XT('\0');
+
+      /* If element contents is all spaces, get rid of the contents. */
+      if (!parser->ignore_whitespaces || !scew_isempty (contents))
         {
-          scew_element_free (element);
-          element = NULL;
+          result = (scew_element_set_contents (element, contents) != NULL);
         }
+
+      /* Text of the parent element (if any) continues from here. */
+      parser->text_length = start;
     }
 
-  return element;
+  return result;
 }
 
+void
+text_drop_spaces_ (scew_parser *parser)
+{
+  stack_element *top = &parser->stack[parser->stack_depth - 1];
+
+  /* Once some text is found, spaces are part of the contents. */
+  if (parser->ignore_whitespaces
+      && !top->has_text
+      && (parser->text_length > top->text_start))
+    {
+      parser->text[parser->text_length] = _XT('\0');
+      if (scew_isempty (&parser->text[top->text_start]))
+        {
+          parser->text_length = top->text_start;
+        }
+      else
+        {
+          top->has_text = SCEW_TRUE;
+        }
+    }
+}
+
+
 
 /* Private (stack) */
 
-stack_element*
-parser_stack_push_ (scew_parser *parser, scew_element *element)
+scew_bool
+parser_stack_push_ (scew_parser *parser,
+                    scew_element *element,
+                    scew_bool flattened)
 {
-  stack_element *stack = NULL;
+  stack_element *top = NULL;
 
   assert (parser != NULL);
   assert (element != NULL);
 
-  stack = calloc (1, sizeof (stack_element));
-
-  if (stack != NULL)
+  if (parser->stack_depth == parser->stack_size)
     {
-      stack->element = element;
-      if (parser->stack != NULL)
+      stack_element *stack = NULL;
+      unsigned int size = (0 == parser->stack_size)
+        ? MIN_STACK_SIZE_
+        : parser->stack_size * 2;
+
+      stack = realloc (parser->stack, size * sizeof (stack_element));
+      if (NULL == stack)
         {
-          stack->prev = parser->stack;
+          return SCEW_FALSE;
         }
+
       parser->stack = stack;
+      parser->stack_size = size;
     }
 
-  return stack;
+  top = &parser->stack[parser->stack_depth];
+  top->element = element;
+  top->text_start = parser->text_length;
+  top->has_text = SCEW_FALSE;
+  top->flattened = flattened;
+  parser->stack_depth += 1;
+
+  return SCEW_TRUE;
 }
 
 scew_element*
 parser_stack_pop_ (scew_parser *parser)
 {
   scew_element *element = NULL;
-  stack_element *stack = NULL;
 
   assert (parser != NULL);
 
-  stack = parser->stack;
-  if (stack != NULL)
+  if (parser->stack_depth > 0)
     {
-      element = stack->element;
-      parser->stack = stack->prev;
-      free (stack);
+      parser->stack_depth -= 1;
+      element = parser->stack[parser->stack_depth].element;
     }
 
   return element;
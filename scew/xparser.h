@@ -34,6 +34,8 @@
 
 #include "parser.h"
 
+#include "xarena.h"
+
 
 /* Types */
 
@@ -48,18 +50,48 @@ typedef struct
   void *data;                   /**< Hook user's data */
 } load_hook;
 
+typedef struct
+{
+  scew_parser_consume_hook hook; /**< Hook */
+  void *data;                   /**< Hook user's data */
+} consume_hook;
+
+typedef struct
+{
+  scew_parser_filter_hook hook; /**< Hook */
+  void *data;                   /**< Hook user's data */
+} filter_hook;
+
 struct scew_parser
 {
   XML_Parser parser;            /**< Expat parser */
   scew_tree *tree;              /**< Current parsed XML document tree */
   XML_Char *preamble;           /**< Current XML document tree preamble */
   stack_element *stack;         /**< Current parsed element stack */
+  unsigned int stack_depth;     /**< Number of elements in the stack */
+  unsigned int stack_size;      /**< Allocated elements for the stack */
+  unsigned int skip_depth;      /**< Open elements of the skipped
+                                   subtree (if any) */
+  XML_Char *text;               /**< Character data of the open elements */
+  size_t text_length;           /**< Number of characters in text */
+  size_t text_size;             /**< Allocated characters for text */
   scew_bool ignore_whitespaces; /**< Whether to ignore white spaces */
+  scew_bool use_arena;          /**< Whether to allocate trees in arenas */
+  size_t buffer_size;           /**< Characters read at once from readers */
+  scew_arena *arena;            /**< Arena of the tree being parsed */
   scew_bool parsing_started;    /**< Whether we started parsing any
                                    non-space character before a tree
                                    starts (used in streams) */
+  scew_bool stream;             /**< Whether a stream is being loaded */
+  XML_Index stream_offset;      /**< Bytes of the current stream tree
+                                   given to Expat in previous calls */
+  XML_Index stream_end;         /**< Byte index right after the root
+                                   end tag of the last stream tree */
   load_hook element_hook;       /**< Hook for loaded elements */
   load_hook tree_hook;          /**< Hook for loaded trees */
+  consume_hook consume_hook;    /**< Hook for consuming loaded elements */
+  filter_hook filter_hook;      /**< Hook for filtering elements */
+  scew_parser *pool_next;       /**< Next free parser in a parser pool */
 };
 
 
@@ -79,4 +111,19 @@ extern SCEW_LOCAL void scew_parser_stack_free_ (scew_parser *parser);
 extern SCEW_LOCAL void
 scew_parser_expat_install_handlers_ (scew_parser *parser);
 
+/**
+ * Sets whether the @a parser loads streams (see
+ * #scew_parser_load_stream), which also changes some Expat options.
+ */
+extern SCEW_LOCAL void scew_parser_set_stream_ (scew_parser *parser,
+                                                scew_bool stream);
+
+/**
+ * Appends the given characters to the parser text buffer, growing it
+ * if necessary.
+ */
+extern SCEW_LOCAL scew_bool scew_parser_text_append_ (scew_parser *parser,
+                                                      XML_Char const *str,
+                                                      size_t len);
+
 #endif /* XPARSER_H_0211250057 */
@@ -0,0 +1,61 @@
+/**
+ * @file     xstr.h
+ * @brief    SCEW private string routines
+ * @author   Aleix Conchillo Flaque <aconchillo@gmail.com>
+ * @date     Sun Oct 18, 2026 10:12
+ *
+ * @if copyright
+ *
+ * Copyright (C) 2026 Aleix Conchillo Flaque
+ *
+ * SCEW is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * SCEW is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ *
+ * @endif
+ */
+
+#ifndef XSTR_H_2610181012
+#define XSTR_H_2610181012
+
+#include "export.h"
+
+#include <expat.h>
+
+#include <stddef.h>
+
+
+/* Functions */
+
+/**
+ * Escapes the first @a length characters of @a src (see
+ * #scew_strescape) into @a dst, as long as they fit in its @a
+ * dst_size characters. The number of characters written to @a dst is
+ * stored in @a written. Dense markup is escaped character by
+ * character, and only long runs with no XML delimiters are scanned
+ * (with SIMD instructions, where available).
+ *
+ * @pre dst != NULL
+ * @pre src != NULL
+ * @pre written != NULL
+ *
+ * @return the number of characters of @a src escaped.
+ */
+extern SCEW_LOCAL size_t scew_strescape_copy_ (XML_Char *dst,
+                                               size_t dst_size,
+                                               XML_Char const *src,
+                                               size_t length,
+                                               size_t *written);
+
+#endif /* XSTR_H_2610181012 */
@@ -0,0 +1,232 @@
+/**
+ * @file     xthread.c
+ * @brief    xthread.h implementation
+ * @author   Aleix Conchillo Flaque <aconchillo@gmail.com>
+ * @date     Sun Oct 18, 2026 10:12
+ *
+ * @if copyright
+ *
+ * Copyright (C) 2026 Aleix Conchillo Flaque
+ *
+ * SCEW is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * SCEW is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ *
+ * @endif
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "xthread.h"
+
+#include <assert.h>
+#include <stdlib.h>
+
+#if defined(SCEW_SINGLE_THREADED_)
+#elif defined(_MSC_VER)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+
+/* Private */
+
+typedef struct
+{
+  scew_thread_worker_ worker;
+  void *data;
+} thread_start_;
+
+#if defined(SCEW_SINGLE_THREADED_)
+#elif defined(_MSC_VER)
+static DWORD WINAPI thread_main_ (LPVOID start);
+#else
+static void* thread_main_ (void *start);
+#endif
+
+
+/* Protected */
+
+unsigned int
+scew_thread_count_ (void)
+{
+  unsigned int count = 1;
+
+#if defined(SCEW_SINGLE_THREADED_)
+#elif defined(_MSC_VER)
+  SYSTEM_INFO info;
+  GetSystemInfo (&info);
+  count = info.dwNumberOfProcessors;
+#elif defined(_SC_NPROCESSORS_ONLN)
+  long online = sysconf (_SC_NPROCESSORS_ONLN);
+  count = (online > 0) ? (unsigned int) online : 1;
+#endif
+
+  return (count > 0) ? count : 1;
+}
+
+void
+scew_thread_run_ (unsigned int n_threads,
+                  scew_thread_worker_ worker,
+                  void *data)
+{
+#if defined(SCEW_SINGLE_THREADED_)
+  assert (n_threads > 0);
+  assert (worker != NULL);
+
+  worker (data);
+#else
+  unsigned int i = 0;
+  unsigned int started = 0;
+  thread_start_ start;
+#if defined(_MSC_VER)
+  HANDLE *threads = NULL;
+#else
+  pthread_t *threads = NULL;
+#endif
+
+  assert (n_threads > 0);
+  assert (worker != NULL);
+
+  start.worker = worker;
+  start.data = data;
+
+  /* The calling thread is the last worker. */
+  if (n_threads > 1)
+    {
+      threads = calloc (n_threads - 1, sizeof (*threads));
+    }
+
+  for (i = 0; (threads != NULL) && (i < n_threads - 1); ++i)
+    {
+#if defined(_MSC_VER)
+      threads[started] = CreateThread (NULL, 0, thread_main_, &start, 0, NULL);
+      if (threads[started] != NULL)
+        {
+          started += 1;
+        }
+#else
+      if (0 == pthread_create (&threads[started], NULL, thread_main_, &start))
+        {
+          started += 1;
+        }
+#endif
+    }
+
+  worker (data);
+
+  for (i = 0; i < started; ++i)
+    {
+#if defined(_MSC_VER)
+      WaitForSingleObject (threads[i], INFINITE);
+      CloseHandle (threads[i]);
+#else
+      pthread_join (threads[i], NULL);
+#endif
+    }
+
+  free (threads);
+#endif /* SCEW_SINGLE_THREADED_ */
+}
+
+size_t
+scew_atomic_next_ (size_t volatile *counter)
+{
+#if defined(SCEW_SINGLE_THREADED_)
+  return (*counter)++;
+#elif defined(_MSC_VER)
+#ifdef _WIN64
+  return (size_t) InterlockedExchangeAdd64 ((LONG64 volatile *) counter, 1);
+#else
+  return (size_t) InterlockedExchangeAdd ((LONG volatile *) counter, 1);
+#endif /* _WIN64 */
+#else
+  return __atomic_fetch_add (counter, 1, __ATOMIC_ACQ_REL);
+#endif
+}
+
+scew_bool
+scew_atomic_cas_ (void *volatile *where, void *expected, void *desired)
+{
+#if defined(SCEW_SINGLE_THREADED_)
+  if (*where != expected)
+    {
+      return SCEW_FALSE;
+    }
+  *where = desired;
+  return SCEW_TRUE;
+#elif defined(_MSC_VER)
+  return (InterlockedCompareExchangePointer (where, desired, expected)
+          == expected);
+#else
+  return __atomic_compare_exchange_n (where, &expected, desired, 0,
+                                      __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+#endif
+}
+
+void*
+scew_atomic_take_ (void *volatile *where)
+{
+#if defined(SCEW_SINGLE_THREADED_)
+  void *value = *where;
+  *where = NULL;
+  return value;
+#elif defined(_MSC_VER)
+  return InterlockedExchangePointer (where, NULL);
+#else
+  return __atomic_exchange_n (where, NULL, __ATOMIC_ACQ_REL);
+#endif
+}
+
+void*
+scew_atomic_load_ (void *volatile *where)
+{
+#if defined(SCEW_SINGLE_THREADED_) || defined(_MSC_VER)
+  /* Volatile reads have acquire semantics in Visual C++. */
+  return *where;
+#else
+  return __atomic_load_n (where, __ATOMIC_ACQUIRE);
+#endif
+}
+
+
+/* Private */
+
+#if defined(SCEW_SINGLE_THREADED_)
+#elif defined(_MSC_VER)
+DWORD WINAPI
+thread_main_ (LPVOID data)
+{
+  thread_start_ *start = data;
+
+  start->worker (start->data);
+
+  return 0;
+}
+#else
+void*
+thread_main_ (void *data)
+{
+  thread_start_ *start = data;
+
+  start->worker (start->data);
+
+  return NULL;
+}
+#endif
@@ -0,0 +1,102 @@
+/**
+ * @file     xthread.h
+ * @brief    SCEW private thread and atomic routines
+ * @author   Aleix Conchillo Flaque <aconchillo@gmail.com>
+ * @date     Sun Oct 18, 2026 10:12
+ *
+ * @if copyright
+ *
+ * Copyright (C) 2026 Aleix Conchillo Flaque
+ *
+ * SCEW is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * SCEW is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ *
+ * @endif
+ */
+
+#ifndef XTHREAD_H_2610181012
+#define XTHREAD_H_2610181012
+
+#include "export.h"
+
+#include "bool.h"
+
+#include <stddef.h>
+
+/* Define a single threading macro common for all platforms */
+#ifndef _MT
+#ifndef HAVE_LIBPTHREAD
+#define SCEW_SINGLE_THREADED_
+#endif /* HAVE_LIBPTHREAD */
+#endif /* _MT */
+
+
+/* Types */
+
+/**
+ * Work function run by each thread of #scew_thread_run_.
+ */
+typedef void (*scew_thread_worker_) (void *data);
+
+
+/* Functions */
+
+/**
+ * Returns the number of processors available, or 1 in single-threaded
+ * builds or if it can not be found out.
+ */
+extern SCEW_LOCAL unsigned int scew_thread_count_ (void);
+
+/**
+ * Runs @a worker with the given @a data on @a n_threads threads
+ * (including the calling thread) and waits for all of them to
+ * finish. Workers usually take their work items from a shared
+ * counter (see #scew_atomic_next_), so if some thread can not be
+ * started, the remaining ones still do all the work.
+ *
+ * In single-threaded builds @a worker is only run once, on the calling
+ * thread.
+ *
+ * @pre n_threads > 0
+ */
+extern SCEW_LOCAL void scew_thread_run_ (unsigned int n_threads,
+                                         scew_thread_worker_ worker,
+                                         void *data);
+
+/**
+ * Atomically increments the given @a counter and returns its previous
+ * value.
+ */
+extern SCEW_LOCAL size_t scew_atomic_next_ (size_t volatile *counter);
+
+/**
+ * Atomically sets @a where to @a desired if it still points to @a
+ * expected. Returns true if the pointer was set.
+ */
+extern SCEW_LOCAL scew_bool scew_atomic_cas_ (void *volatile *where,
+                                              void *expected,
+                                              void *desired);
+
+/**
+ * Atomically sets @a where to NULL, returning its previous value.
+ */
+extern SCEW_LOCAL void* scew_atomic_take_ (void *volatile *where);
+
+/**
+ * Reads the pointer at @a where, with acquire semantics.
+ */
+extern SCEW_LOCAL void* scew_atomic_load_ (void *volatile *where);
+
+#endif /* XTHREAD_H_2610181012 */
@@ -0,0 +1,158 @@
+/**
+ * @file     xtree.h
+ * @brief    Internal tree functions
+ * @author   Aleix Conchillo Flaque <aconchillo@gmail.com>
+ * @date     Sun Oct 18, 2026 10:12
+ *
+ * @if copyright
+ *
+ * Copyright (C) 2026 Aleix Conchillo Flaque
+ *
+ * SCEW is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * SCEW is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ *
+ * @endif
+ */
+
+#ifndef XTREE_H_2610181012
+#define XTREE_H_2610181012
+
+#include "export.h"
+
+#include "tree.h"
+
+#include "xarena.h"
+#include "xelement.h"
+
+
+/* Functions */
+
+/**
+ * Hands the given @a arena over to @a tree. The arena will be freed
+ * when the tree is freed. If all the tree elements were allocated from
+ * the arena, elements will not be freed one by one, only the arena.
+ *
+ * @pre tree != NULL
+ */
+extern SCEW_LOCAL void scew_tree_set_arena_ (scew_tree *tree,
+                                             scew_arena *arena);
+
+/**
+ * Creates an empty tree index. If @a attribute is not NULL, elements
+ * will also be indexed by the value of that attribute.
+ *
+ * @return a new tree index, or NULL if no memory is available.
+ */
+extern SCEW_LOCAL scew_tree_index*
+scew_tree_index_create_ (XML_Char const *attribute);
+
+/**
+ * Frees the given tree @a index. If @a detach is true, the elements
+ * of the indexed tree stop referencing the index (otherwise they must
+ * be freed without being used). If a NULL @a index is given, this
+ * function takes no action.
+ */
+extern SCEW_LOCAL void scew_tree_index_free_ (scew_tree_index *index,
+                                              scew_bool detach);
+
+/**
+ * Indexes all the elements under the given @a root element (which
+ * might be NULL), replacing the current contents of @a index.
+ *
+ * @pre index != NULL
+ *
+ * @return true if the index could be built, false otherwise (the
+ * index will need to be built again).
+ */
+extern SCEW_LOCAL scew_bool scew_tree_index_build_ (scew_tree_index *index,
+                                                    scew_element *root);
+
+/**
+ * Obtains the @a elements (in document order) with the given @a key,
+ * which is an element name or, if @a by_value is true, a value of the
+ * indexed attribute.
+ *
+ * @pre index != NULL
+ * @pre key != NULL
+ *
+ * @return true if the index could be used (@a n_elements might be 0
+ * if no elements are found), false if it needs to be updated (see
+ * #scew_tree_index_update_).
+ */
+extern SCEW_LOCAL scew_bool
+scew_tree_index_lookup_ (scew_tree_index const *index,
+                         scew_bool by_value,
+                         XML_Char const *key,
+                         scew_element * const **elements,
+                         unsigned int *n_elements);
+
+/**
+ * Brings the given @a index up to date, building it again if it could
+ * not be updated or merging added elements into place, so it can be
+ * used by #scew_tree_index_lookup_.
+ *
+ * @pre index != NULL
+ *
+ * @return true if the index is up to date, false otherwise.
+ */
+extern SCEW_LOCAL scew_bool scew_tree_index_update_ (scew_tree_index *index);
+
+/**
+ * Adds the given @a element (if @a self is true) and its descendants
+ * (if @a descendants is true) to @a index. Must be called once the
+ * elements are part of the indexed tree. If a NULL @a index is given,
+ * this function takes no action.
+ *
+ * @pre element != NULL
+ */
+extern SCEW_LOCAL void scew_tree_index_add_ (scew_tree_index *index,
+                                             scew_element *element,
+                                             scew_bool self,
+                                             scew_bool descendants);
+
+/**
+ * Removes the given @a element (if @a self is true) and its
+ * descendants (if @a descendants is true) from @a index. Must be
+ * called while the elements are still part of the indexed tree. If a
+ * NULL @a index is given, this function takes no action.
+ *
+ * @pre element != NULL
+ */
+extern SCEW_LOCAL void scew_tree_index_remove_ (scew_tree_index *index,
+                                                scew_element *element,
+                                                scew_bool self,
+                                                scew_bool descendants);
+
+/**
+ * Adds the given @a attribute to the index of the tree its parent
+ * belongs to (if any). Must be called once the attribute is added or
+ * its name or value are changed.
+ *
+ * @pre attribute != NULL
+ */
+extern SCEW_LOCAL void
+scew_tree_index_add_attribute_ (scew_attribute const *attribute);
+
+/**
+ * Removes the given @a attribute from the index of the tree its
+ * parent belongs to (if any). Must be called before the attribute is
+ * deleted or its name or value are changed.
+ *
+ * @pre attribute != NULL
+ */
+extern SCEW_LOCAL void
+scew_tree_index_remove_attribute_ (scew_attribute const *attribute);
+
+#endif /* XTREE_H_2610181012 */
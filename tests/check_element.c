@@ -232,6 +232,67 @@ START_TEST (test_attributes)
 }
 END_TEST
 
+
+/* Attributes (bulk creation) */
+
+START_TEST (test_create_with_attributes)
+{
+  static XML_Char const *ATTRS[] =
+    {
+      _XT("a1"), _XT("v1"),
+      _XT("a2"), _XT("v2"),
+      _XT("a3"), _XT(""),
+      NULL
+    };
+  static XML_Char const *NO_ATTRS[] = { NULL };
+
+  scew_element *element =
+    scew_element_create_with_attributes (_XT("element"), ATTRS);
+
+  CHECK_PTR (element, "Unable to create element with attributes");
+
+  CHECK_STR (scew_element_name (element), _XT("element"),
+             "Element name mismatch");
+  CHECK_U_INT (scew_element_attribute_count (element), 3,
+               "Number of attributes mismatch");
+
+  /* Attributes are kept in the given order. */
+  unsigned int i = 0;
+  for (i = 0; i < 3; ++i)
+    {
+      scew_attribute *attribute = scew_element_attribute_by_index (element, i);
+
+      CHECK_STR (scew_attribute_name (attribute), ATTRS[2 * i],
+                 "Attribute name mismatch");
+      CHECK_STR (scew_attribute_value (attribute), ATTRS[2 * i + 1],
+                 "Attribute value mismatch");
+      CHECK_BOOL (scew_attribute_parent (attribute) == element, SCEW_TRUE,
+                  "Attribute parent mismatch");
+    }
+
+  /* Attributes can still be updated and added later. */
+  scew_element_add_attribute_pair (element, _XT("a2"), _XT("new"));
+  scew_element_add_attribute_pair (element, _XT("a4"), _XT("v4"));
+
+  CHECK_STR (scew_attribute_value (scew_element_attribute_by_name
+                                   (element, _XT("a2"))),
+             _XT("new"), "Attribute value should be updated");
+  CHECK_U_INT (scew_element_attribute_count (element), 4,
+               "Number of attributes mismatch");
+
+  scew_element_free (element);
+
+  /* Empty attributes list */
+  element = scew_element_create_with_attributes (_XT("element"), NO_ATTRS);
+
+  CHECK_PTR (element, "Unable to create element without attributes");
+  CHECK_U_INT (scew_element_attribute_count (element), 0,
+               "Element should have no attributes");
+
+  scew_element_free (element);
+}
+END_TEST
+
 
 /* Hierarchy (basic) */
 
@@ -365,6 +426,94 @@ START_TEST (test_hierarchy_delete)
 }
 END_TEST
 
+
+/* Hierarchy (order) */
+
+START_TEST (test_hierarchy_order)
+{
+  static XML_Char const *NAMES[] =
+    {
+      _XT("a"), _XT("b"), _XT("c"), _XT("d"), _XT("e"), _XT("f")
+    };
+  static unsigned int const N_ELEMENTS = 6;
+
+  scew_element *element = scew_element_create (_XT("root"));
+
+  CHECK_PTR (element, "Unable to create element");
+
+  unsigned int i = 0;
+  for (i = 0; i < N_ELEMENTS; ++i)
+    {
+      CHECK_PTR (scew_element_add (element, NAMES[i]),
+                 "Unable to create child");
+    }
+
+  /* The list view contains all children in order. */
+  scew_list *list = scew_element_children (element);
+
+  CHECK_U_INT (scew_list_size (list), N_ELEMENTS, "List size mismatch");
+
+  scew_list *item = list;
+  for (i = 0; i < N_ELEMENTS; ++i)
+    {
+      CHECK_PTR (item, "List item missing");
+      CHECK_BOOL (scew_list_data (item) == scew_element_by_index (element, i),
+                  SCEW_TRUE, "List and index order mismatch");
+      item = scew_list_next (item);
+    }
+
+  /* Detach "b" and delete "e" (siblings move back). */
+  scew_element *child = scew_element_by_index (element, 1);
+  scew_element_detach (child);
+  scew_element_delete_by_index (element, 3);
+
+  CHECK_U_INT (scew_element_count (element), N_ELEMENTS - 2,
+               "Number of children mismatch");
+  CHECK_STR (scew_element_name (scew_element_by_index (element, 1)),
+             _XT("c"), "Child order mismatch");
+  CHECK_STR (scew_element_name (scew_element_by_index (element, 3)),
+             _XT("f"), "Child order mismatch");
+
+  /* Items are reused when the list view is updated, so the previous
+     list is only valid again after getting it from the element. */
+  list = scew_element_children (element);
+  CHECK_PTR (list, "Unable to update list view");
+  CHECK_U_INT (scew_list_size (list), N_ELEMENTS - 2, "List size mismatch");
+
+  item = list;
+  for (i = 0; i < N_ELEMENTS - 2; ++i)
+    {
+      CHECK_PTR (item, "List item missing");
+      CHECK_BOOL (scew_list_data (item) == scew_element_by_index (element, i),
+                  SCEW_TRUE, "List and index order mismatch");
+      item = scew_list_next (item);
+    }
+  CHECK_NULL_PTR (item, "List view has stale items");
+
+  /* The list view is not changed until the children change. */
+  CHECK_BOOL (scew_element_children (element) == list, SCEW_TRUE,
+              "List view should be kept");
+
+  /* Detached children can be added again (at the end). */
+  CHECK_BOOL (scew_element_add_element (element, child) == child,
+              SCEW_TRUE, "Unable to add detached child");
+  CHECK_BOOL (scew_element_by_index (element, N_ELEMENTS - 2) == child,
+              SCEW_TRUE, "Child should be the last one");
+
+  /* Growing children also updates the list view. */
+  list = scew_element_children (element);
+  CHECK_U_INT (scew_list_size (list), N_ELEMENTS - 1, "List size mismatch");
+  CHECK_BOOL (scew_list_data (scew_list_last (list)) == child, SCEW_TRUE,
+              "List view should end with the added child");
+
+  scew_element_delete_all (element);
+
+  CHECK_NULL_PTR (scew_element_children (element), "Element has no children");
+
+  scew_element_free (element);
+}
+END_TEST
+
 
 /* Search */
 
@@ -436,6 +585,81 @@ START_TEST (test_search)
 }
 END_TEST
 
+
+/* Search (many children) */
+
+START_TEST (test_search_index)
+{
+  static XML_Char const *NAMES[] =
+    {
+      _XT("a"), _XT("b"), _XT("c"), _XT("d"), _XT("e")
+    };
+  static unsigned int const N_NAMES = 5;
+  static unsigned int const N_ELEMENTS = 200;
+
+  scew_element *root = scew_element_create (_XT("root"));
+
+  CHECK_PTR (root, "Unable to create element");
+
+  unsigned int i = 0;
+  for (i = 0; i < N_ELEMENTS; ++i)
+    {
+      CHECK_PTR (scew_element_add (root, NAMES[i % N_NAMES]),
+                 "Unable to create child");
+    }
+
+  /* Wide elements are searched via an index, results must not change. */
+  CHECK_BOOL (scew_element_by_name (root, _XT("c"))
+              == scew_element_by_index (root, 2),
+              SCEW_TRUE, "First child found by name mismatch");
+  CHECK_NULL_PTR (scew_element_by_name (root, _XT("z")),
+                  "There is no child with that name");
+
+  scew_list *list = scew_element_list_by_name (root, _XT("b"));
+
+  CHECK_U_INT (scew_list_size (list), N_ELEMENTS / N_NAMES,
+               "Number of children found searching by name");
+  CHECK_BOOL (scew_list_data (list) == scew_element_by_index (root, 1),
+              SCEW_TRUE, "Children found by name are not in order");
+
+  scew_list_free (list);
+
+  /* The index follows detached, renamed and new children. */
+  scew_element_delete_by_index (root, 2);
+  scew_element_set_name (scew_element_by_index (root, 0), _XT("z"));
+  scew_element_set_name (scew_element_by_index (root, 5), _XT("c"));
+  scew_element_add (root, _XT("y"));
+
+  CHECK_BOOL (scew_element_by_name (root, _XT("c"))
+              == scew_element_by_index (root, 5),
+              SCEW_TRUE, "Renamed child should be found first");
+  CHECK_BOOL (scew_element_by_name (root, _XT("z"))
+              == scew_element_by_index (root, 0),
+              SCEW_TRUE, "Renamed child should be found");
+  CHECK_BOOL (scew_element_by_name (root, _XT("y"))
+              == scew_element_by_index (root, N_ELEMENTS - 1),
+              SCEW_TRUE, "New child should be found");
+
+  list = scew_element_list_by_name (root, _XT("c"));
+
+  CHECK_U_INT (scew_list_size (list), N_ELEMENTS / N_NAMES,
+               "Number of children found searching by name");
+
+  scew_list_free (list);
+
+  /* Delete all children with a name (one of them has been renamed). */
+  scew_element_delete_all_by_name (root, _XT("a"));
+
+  CHECK_NULL_PTR (scew_element_by_name (root, _XT("a")),
+                  "There should be no children with that name");
+  CHECK_U_INT (scew_element_count (root),
+               N_ELEMENTS - (N_ELEMENTS / N_NAMES - 1),
+               "Number of children mismatch");
+
+  scew_element_free (root);
+}
+END_TEST
+
 
 /* Comparison */
 
@@ -484,6 +708,87 @@ START_TEST (test_compare)
 }
 END_TEST
 
+/* Comparison (hashes) */
+
+START_TEST (test_hash)
+{
+  static unsigned int const N_ELEMENTS = 10;
+
+  scew_element *root = scew_element_create (_XT("root"));
+  scew_element *root_copy = NULL;
+  scew_element *child = NULL;
+  scew_attribute *attribute = NULL;
+  scew_hash hash = 0;
+  unsigned int i = 0;
+
+  for (i = 0; i < N_ELEMENTS; ++i)
+    {
+      child = scew_element_add_pair (root, _XT("child"), _XT("contents"));
+      scew_element_add_attribute_pair (child, _XT("attr"), _XT("value"));
+      scew_element_add (child, _XT("grandchild"));
+    }
+
+  root_copy = scew_element_copy (root);
+  hash = scew_element_hash (root);
+
+  CHECK_BOOL (hash == scew_element_hash (root), SCEW_TRUE,
+              "Hash should not change if element is not modified");
+  CHECK_BOOL (hash == scew_element_hash (root_copy), SCEW_TRUE,
+              "Element and element copy should have the same hash");
+  CHECK_BOOL (scew_element_compare (root, root_copy, NULL), SCEW_TRUE,
+              "Element and element copy should be equal (hashes)");
+
+  /* Modifications of descendants change the hash. */
+  child = scew_element_by_index (root_copy, N_ELEMENTS - 1);
+  scew_element_add (scew_element_by_index (child, 0), _XT("new"));
+
+  CHECK_BOOL (hash != scew_element_hash (root_copy), SCEW_TRUE,
+              "Hash should change after adding a descendant");
+  CHECK_BOOL (scew_element_compare (root, root_copy, NULL), SCEW_FALSE,
+              "Element and modified copy should be different (hashes)");
+
+  scew_element_delete_all (scew_element_by_index (child, 0));
+
+  CHECK_BOOL (hash == scew_element_hash (root_copy), SCEW_TRUE,
+              "Hash should be restored after deleting a descendant");
+
+  /* Attribute modifications change the hash. */
+  attribute = scew_element_attribute_by_index (child, 0);
+  scew_attribute_set_value (attribute, _XT("other"));
+
+  CHECK_BOOL (hash != scew_element_hash (root_copy), SCEW_TRUE,
+              "Hash should change after modifying an attribute");
+
+  scew_attribute_set_value (attribute, _XT("value"));
+
+  CHECK_BOOL (hash == scew_element_hash (root_copy), SCEW_TRUE,
+              "Hash should be restored after restoring an attribute");
+
+  /* Order of children matters. */
+  scew_element_set_contents (scew_element_by_index (root_copy, 0),
+                             _XT("first"));
+  scew_element_set_contents (scew_element_by_index (root, 1), _XT("first"));
+
+  CHECK_BOOL (scew_element_hash (root) != scew_element_hash (root_copy),
+              SCEW_TRUE, "Hash should depend on children order");
+
+  /* Contents and names are not interchangeable. */
+  child = scew_element_create (_XT("a"));
+  scew_element_set_contents (child, _XT("b"));
+  hash = scew_element_hash (child);
+  scew_element_set_name (child, _XT("ab"));
+  scew_element_free_contents (child);
+
+  CHECK_BOOL (hash != scew_element_hash (child), SCEW_TRUE,
+              "Hash should delimit name and contents");
+
+  scew_element_free (child);
+  scew_element_free (root);
+  scew_element_free (root_copy);
+}
+END_TEST
+
+
 
 /* Suite */
 
@@ -497,10 +802,14 @@ element_suite (void)
   tcase_add_test (tc_core, test_alloc);
   tcase_add_test (tc_core, test_accessors);
   tcase_add_test (tc_core, test_attributes);
+  tcase_add_test (tc_core, test_create_with_attributes);
   tcase_add_test (tc_core, test_hierarchy_basic);
   tcase_add_test (tc_core, test_hierarchy_delete);
+  tcase_add_test (tc_core, test_hierarchy_order);
   tcase_add_test (tc_core, test_search);
+  tcase_add_test (tc_core, test_search_index);
   tcase_add_test (tc_core, test_compare);
+  tcase_add_test (tc_core, test_hash);
   suite_add_tcase (s, tc_core);
 
   return s;
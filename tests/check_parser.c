@@ -31,6 +31,7 @@
 #include <scew/error.h>
 #include <scew/parser.h>
 #include <scew/reader_buffer.h>
+#include <scew/reader_file.h>
 
 #include <check.h>
 
@@ -341,6 +342,141 @@ START_TEST (test_load_chunked_stream_b)
 }
 END_TEST
 
+static scew_bool
+tree_count_stream_hook_ (scew_parser *parser, void *tree, void *user_data)
+{
+  unsigned int *counter = user_data;
+
+  scew_element *root = scew_tree_root (tree);
+
+  CHECK_U_INT (scew_element_count (root), *counter % 3,
+               "Number of children do not match");
+
+  scew_tree_free (tree);
+
+  *counter += 1;
+
+  return SCEW_TRUE;
+}
+
+START_TEST (test_load_small_chunks_stream)
+{
+  enum { N_TREES = 50 };
+
+  static XML_Char const *TREES[] =
+    {
+      _XT("<empty/>"),
+      _XT("\n  <one><a>text</a></one>"),
+      _XT("<?xml version=\"1.0\"?>\n<two><a/><b x=\"1\"/></two>\n\n")
+    };
+
+  unsigned int i = 0;
+  unsigned int counter = 0;
+
+  FILE *file = tmpfile ();
+
+  CHECK_PTR (file, "Unable to create temporary file");
+
+  for (i = 0; i < N_TREES; ++i)
+    {
+      scew_fputs (TREES[i % 3], file);
+    }
+  rewind (file);
+
+  scew_parser *parser = scew_parser_create ();
+
+  /* The reader closes the file when freed. */
+  scew_reader *reader = scew_reader_fp_create (file);
+
+  /* Trees will be split across many reads. */
+  scew_parser_set_buffer_size (parser, 7);
+  scew_parser_set_tree_hook (parser, tree_count_stream_hook_, &counter);
+
+  CHECK_BOOL (scew_parser_load_stream (parser, reader), SCEW_TRUE,
+              "Unable to parse stream");
+
+  CHECK_U_INT (counter, N_TREES, "Number of loaded trees do not match");
+
+  scew_reader_free (reader);
+  scew_parser_free (parser);
+}
+END_TEST
+
+static scew_bool
+tree_free_stream_hook_ (scew_parser *parser, void *tree, void *user_data)
+{
+  unsigned int *counter = user_data;
+
+  scew_tree_free (tree);
+
+  *counter += 1;
+
+  return SCEW_TRUE;
+}
+
+START_TEST (test_load_stream_end)
+{
+  enum { MAX_BUFFER_SIZE = 40, LONG_VALUE_SIZE = 5000 };
+
+  static XML_Char const *TREE = _XT("<?xml version=\"1.0\"?><r/>");
+
+  unsigned int i = 0;
+  unsigned int size = 0;
+  unsigned int counter = 0;
+  scew_parser *parser = NULL;
+  scew_reader *reader = NULL;
+  FILE *file = NULL;
+
+  /* The last tree must be loaded whatever the last read is. */
+  for (size = 1; size <= MAX_BUFFER_SIZE; ++size)
+    {
+      file = tmpfile ();
+      scew_fputs (TREE, file);
+      rewind (file);
+
+      parser = scew_parser_create ();
+      reader = scew_reader_fp_create (file);
+
+      counter = 0;
+      scew_parser_set_buffer_size (parser, size);
+      scew_parser_set_tree_hook (parser, tree_free_stream_hook_, &counter);
+
+      CHECK_BOOL (scew_parser_load_stream (parser, reader), SCEW_TRUE,
+                  "Unable to parse stream (buffer size %u)", size);
+      CHECK_U_INT (counter, 1, "Last tree not loaded (buffer size %u)",
+                   size);
+
+      scew_reader_free (reader);
+      scew_parser_free (parser);
+    }
+
+  /* Same with a last tree bigger than the stream chunks. */
+  file = tmpfile ();
+  scew_fputs (TREE, file);
+  scew_fputs (_XT("<r a=\""), file);
+  for (i = 0; i < LONG_VALUE_SIZE; ++i)
+    {
+      scew_fputs (_XT("v"), file);
+    }
+  scew_fputs (_XT("\"/>"), file);
+  rewind (file);
+
+  parser = scew_parser_create ();
+  reader = scew_reader_fp_create (file);
+
+  counter = 0;
+  scew_parser_set_buffer_size (parser, 3);
+  scew_parser_set_tree_hook (parser, tree_free_stream_hook_, &counter);
+
+  CHECK_BOOL (scew_parser_load_stream (parser, reader), SCEW_TRUE,
+              "Unable to parse stream with a long attribute");
+  CHECK_U_INT (counter, 2, "Number of loaded trees do not match");
+
+  scew_reader_free (reader);
+  scew_parser_free (parser);
+}
+END_TEST
+
 
 /* Load invalid */
 
@@ -422,6 +558,311 @@ START_TEST (test_ignore_white_spaces)
 }
 END_TEST
 
+
+/* Arena */
+
+START_TEST (test_load_arena)
+{
+  static unsigned int const N_CHILDREN = 4;
+
+  scew_parser *parser = scew_parser_create ();
+  scew_parser_set_arena (parser, SCEW_TRUE);
+
+  scew_reader *reader = scew_reader_buffer_create (TEST_XML,
+                                                   scew_strlen (TEST_XML));
+
+  scew_tree *tree = scew_parser_load (parser, reader);
+
+  CHECK_PTR (tree, "Unable to parse test XML in arena mode");
+
+  scew_element *root = scew_tree_root (tree);
+
+  CHECK_U_INT (scew_element_count (root), N_CHILDREN,
+               "Number of children do not match");
+
+  scew_element *element = scew_element_by_index (root, 0);
+  CHECK_STR (scew_element_contents (element), _XT("element contents"),
+             "Element contents do not match");
+
+  /* Names are interned in the arena. */
+  CHECK_BOOL (scew_element_name (element)
+              == scew_element_name (scew_element_by_index (root, 1)),
+              SCEW_TRUE, "Element names should be shared");
+
+  /* Arena trees can still be modified. */
+  scew_element_set_name (element, _XT("renamed"));
+  scew_element_set_contents (element, _XT("new contents"));
+  CHECK_STR (scew_element_name (element), _XT("renamed"),
+             "Element name do not match");
+  CHECK_STR (scew_element_contents (element), _XT("new contents"),
+             "Element contents do not match");
+
+  scew_element_add_pair (element, _XT("child"), _XT("child contents"));
+  CHECK_U_INT (scew_element_count (element), 1,
+               "Number of children do not match");
+
+  scew_element_delete_by_index (root, 1);
+  CHECK_U_INT (scew_element_count (root), N_CHILDREN - 1,
+               "Number of children do not match");
+
+  element = scew_element_by_index (root, 1);
+  scew_element_delete_attribute_by_name (element, _XT("attribute2"));
+  scew_element_add_attribute_pair (element, _XT("attribute3"), _XT("value3"));
+  CHECK_U_INT (scew_element_attribute_count (element), 2,
+               "Number of attributes do not match");
+
+  /* Elements created outside the arena can also be added. */
+  scew_element_add_element (root, scew_element_create (_XT("heap")));
+  CHECK_U_INT (scew_element_count (root), N_CHILDREN,
+               "Number of children do not match");
+
+  scew_tree_free (tree);
+  scew_reader_free (reader);
+  scew_parser_free (parser);
+}
+END_TEST
+
+static scew_parser_consume
+consume_hook_ (scew_parser *parser, scew_element *element, void *user_data)
+{
+  scew_element **taken = user_data;
+  XML_Char const *name = scew_element_name (element);
+
+  if (NULL == taken)
+    {
+      return scew_parser_consume_error;
+    }
+
+  if (scew_strcmp (name, _XT("subelement")) == 0)
+    {
+      return scew_parser_consume_free;
+    }
+
+  if (scew_element_attribute_by_name (element, _XT("attribute")) != NULL)
+    {
+      *taken = element;
+      return scew_parser_consume_take;
+    }
+
+  return scew_parser_consume_keep;
+}
+
+START_TEST (test_load_consume)
+{
+  scew_parser *parser = scew_parser_create ();
+  scew_element *taken = NULL;
+
+  scew_reader *reader = scew_reader_buffer_create (TEST_XML,
+                                                   scew_strlen (TEST_XML));
+
+  scew_parser_set_consume_hook (parser, consume_hook_, &taken);
+
+  scew_tree *tree = scew_parser_load (parser, reader);
+
+  CHECK_PTR (tree, "Unable to parse test XML consuming elements");
+
+  scew_element *root = scew_tree_root (tree);
+
+  CHECK_U_INT (scew_element_count (root), 3,
+               "Number of children do not match");
+  CHECK_U_INT (scew_element_count (scew_element_by_index (root, 2)), 0,
+               "Consumed elements should be freed");
+
+  CHECK_PTR (taken, "Element should have been taken");
+  CHECK_NULL_PTR (scew_element_parent (taken),
+                  "Taken element should be detached");
+  CHECK_U_INT (scew_element_attribute_count (taken), 1,
+               "Number of attributes do not match");
+
+  scew_element_free (taken);
+  scew_tree_free (tree);
+  scew_reader_free (reader);
+
+  /* Hooks might also stop parsing. */
+  reader = scew_reader_buffer_create (TEST_XML, scew_strlen (TEST_XML));
+
+  scew_parser_set_consume_hook (parser, consume_hook_, NULL);
+
+  tree = scew_parser_load (parser, reader);
+
+  CHECK_NULL_PTR (tree, "Consume hook should stop parsing");
+
+  scew_reader_free (reader);
+  scew_parser_free (parser);
+}
+END_TEST
+
+static scew_parser_filter
+filter_hook_ (scew_parser *parser, scew_element *parent, XML_Char const *name,
+              XML_Char const **attributes, void *user_data)
+{
+  unsigned int *counter = user_data;
+
+  *counter += 1;
+
+  CHECK_BOOL (scew_strcmp (name, _XT("test")) == 0, SCEW_FALSE,
+              "Root elements should not be filtered");
+
+  if (scew_strcmp (name, _XT("subsubelement")) == 0)
+    {
+      CHECK_STR (scew_element_name (parent), _XT("element"),
+                 "Parent should be the nearest built element");
+    }
+
+  if ((attributes[0] != NULL)
+      && (scew_strcmp (attributes[0], _XT("attribute")) == 0))
+    {
+      return scew_parser_filter_skip;
+    }
+
+  return (scew_strcmp (name, _XT("subelement")) == 0)
+    ? scew_parser_filter_flatten
+    : scew_parser_filter_build;
+}
+
+START_TEST (test_load_filter)
+{
+  static XML_Char const *INVALID_XML =
+    _XT("<test><element><subelement><b>x</b><c></subelement>"
+        "</element></test>");
+
+  unsigned int counter = 0;
+  scew_parser *parser = scew_parser_create ();
+
+  scew_reader *reader = scew_reader_buffer_create (TEST_XML,
+                                                   scew_strlen (TEST_XML));
+
+  scew_parser_set_filter_hook (parser, filter_hook_, &counter);
+
+  scew_tree *tree = scew_parser_load (parser, reader);
+
+  CHECK_PTR (tree, "Unable to parse test XML filtering elements");
+
+  CHECK_U_INT (counter, 7, "Wrong number of filtered elements");
+
+  scew_element *root = scew_tree_root (tree);
+
+  CHECK_U_INT (scew_element_count (root), 3,
+               "Number of children do not match");
+
+  scew_element *element = scew_element_by_index (root, 2);
+  CHECK_U_INT (scew_element_count (element), 1,
+               "Flattened children should be added to the parent");
+
+  element = scew_element_by_index (element, 0);
+  CHECK_STR (scew_element_name (element), _XT("subsubelement"),
+             "Element name do not match");
+  CHECK_STR (scew_element_contents (element),
+             _XT("With accents: à é è í ó ú"),
+             "Element contents do not match");
+
+  scew_tree_free (tree);
+  scew_reader_free (reader);
+
+  /* Errors inside flattened elements do not free their parent twice. */
+  reader = scew_reader_buffer_create (INVALID_XML, scew_strlen (INVALID_XML));
+  tree = scew_parser_load (parser, reader);
+
+  CHECK_NULL_PTR (tree, "Invalid XML inside flattened element loaded");
+  CHECK_U_INT (scew_error_code (), scew_error_expat,
+               "Wrong error for invalid XML inside flattened element");
+
+  scew_reader_free (reader);
+  scew_parser_free (parser);
+}
+END_TEST
+
+static scew_bool
+tree_feed_hook_ (scew_parser *parser, void *tree, void *user_data)
+{
+  unsigned int *counter = user_data;
+
+  CHECK_U_INT (scew_element_count (scew_tree_root (tree)),
+               (0 == *counter) ? 3 : 2,
+               "Number of children do not match");
+
+  scew_tree_free (tree);
+
+  *counter += 1;
+
+  return SCEW_TRUE;
+}
+
+START_TEST (test_feed)
+{
+  static XML_Char const *UNFINISHED_XML = _XT("<test><element/>");
+
+  unsigned int i = 0;
+  unsigned int counter = 0;
+  size_t length = scew_strlen (TEST_STREAM_XML);
+  scew_parser *parser = scew_parser_create ();
+
+  scew_parser_set_tree_hook (parser, tree_feed_hook_, &counter);
+
+  /* Data is given in small pieces, as it would come from a socket. */
+  for (i = 0; i < length; i += 7)
+    {
+      size_t size = (length - i < 7) ? length - i : 7;
+
+      CHECK_BOOL (scew_parser_feed (parser, TEST_STREAM_XML + i, size,
+                                    SCEW_FALSE),
+                  SCEW_TRUE, "Unable to feed stream at %u", i);
+    }
+  CHECK_U_INT (counter, 2, "Number of trees do not match");
+
+  CHECK_BOOL (scew_parser_feed (parser, NULL, 0, SCEW_TRUE), SCEW_TRUE,
+              "Unable to finish stream");
+
+  /* Unfinished documents are errors once the stream ends. */
+  counter = 0;
+  CHECK_BOOL (scew_parser_feed (parser, UNFINISHED_XML,
+                                scew_strlen (UNFINISHED_XML), SCEW_FALSE),
+              SCEW_TRUE, "Unable to feed unfinished document");
+  CHECK_BOOL (scew_parser_feed (parser, NULL, 0, SCEW_TRUE), SCEW_FALSE,
+              "Unfinished document should be an error");
+  CHECK_U_INT (scew_error_code (), scew_error_expat,
+               "Wrong error for unfinished document");
+  CHECK_U_INT (counter, 0, "No tree should be loaded");
+
+  scew_parser_free (parser);
+}
+END_TEST
+
+START_TEST (test_feed_bytes)
+{
+  static XML_Char const *PROLOG_XML =
+    _XT("<?xml version=\"1.0\"?>\n<!-- comment -->\n<test><a>text</a></test>");
+
+  unsigned int i = 0;
+  unsigned int counter = 0;
+  unsigned int length = scew_strlen (PROLOG_XML);
+  scew_parser *parser = scew_parser_create ();
+
+  scew_parser_set_tree_hook (parser, tree_free_stream_hook_, &counter);
+
+  /* The last character might also be given with the end of stream. */
+  for (i = 0; i < length; ++i)
+    {
+      CHECK_BOOL (scew_parser_feed (parser, PROLOG_XML + i, 1,
+                                    i + 1 == length),
+                  SCEW_TRUE, "Unable to feed character %u", i);
+    }
+  CHECK_U_INT (counter, 1, "Number of trees do not match");
+
+  counter = 0;
+  for (i = 0; i < length; ++i)
+    {
+      CHECK_BOOL (scew_parser_feed (parser, PROLOG_XML + i, 1, SCEW_FALSE),
+                  SCEW_TRUE, "Unable to feed character %u", i);
+    }
+  CHECK_BOOL (scew_parser_feed (parser, NULL, 0, SCEW_TRUE), SCEW_TRUE,
+              "Unable to finish stream");
+  CHECK_U_INT (counter, 1, "Number of trees do not match");
+
+  scew_parser_free (parser);
+}
+END_TEST
+
 
 /* Suite */
 
@@ -438,9 +879,16 @@ parser_suite (void)
   tcase_add_test (tc_core, test_load_stream);
   tcase_add_test (tc_core, test_load_chunked_stream_a);
   tcase_add_test (tc_core, test_load_chunked_stream_b);
+  tcase_add_test (tc_core, test_load_small_chunks_stream);
+  tcase_add_test (tc_core, test_load_stream_end);
   tcase_add_test (tc_core, test_load_invalid);
   tcase_add_test (tc_core, test_white_spaces);
   tcase_add_test (tc_core, test_ignore_white_spaces);
+  tcase_add_test (tc_core, test_load_arena);
+  tcase_add_test (tc_core, test_load_consume);
+  tcase_add_test (tc_core, test_load_filter);
+  tcase_add_test (tc_core, test_feed);
+  tcase_add_test (tc_core, test_feed_bytes);
   suite_add_tcase (s, tc_core);
 
   return s;
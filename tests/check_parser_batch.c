@@ -0,0 +1,170 @@
+/**
+ * @file     check_parser_batch.c
+ * @brief    Unit testing for SCEW batch loading
+ * @author   Aleix Conchillo Flaque <aconchillo@gmail.com>
+ * @date     Sun Oct 18, 2026 10:12
+ *
+ * @if copyright
+ *
+ * Copyright (C) 2026 Aleix Conchillo Flaque
+ *
+ * SCEW is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * SCEW is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ *
+ * @endif
+ */
+
+#include "test.h"
+
+#include <scew/attribute.h>
+#include <scew/element.h>
+#include <scew/parser_batch.h>
+#include <scew/reader_buffer.h>
+
+#include <check.h>
+
+#include <stdio.h>
+
+
+/* Unit tests */
+
+enum { N_DOCUMENTS = 50, INVALID = 17 };
+
+/* Readers */
+
+START_TEST (test_load_readers)
+{
+  static XML_Char documents[N_DOCUMENTS][64];
+
+  scew_reader *readers[N_DOCUMENTS];
+  scew_tree *trees[N_DOCUMENTS];
+  scew_error errors[N_DOCUMENTS];
+  unsigned int threads = 0;
+
+  for (threads = 0; threads <= 4; ++threads)
+    {
+      unsigned int i = 0;
+      scew_parser_pool *pool =
+        (threads % 2) ? scew_parser_pool_create () : NULL;
+
+      for (i = 0; i < N_DOCUMENTS; ++i)
+        {
+          XML_Char const *format = (INVALID == i)
+            ? _XT("<doc id=\"%u\">") : _XT("<doc id=\"%u\"/>");
+          check_sprintf (documents[i], format, i);
+          readers[i] = scew_reader_buffer_create (documents[i],
+                                                  scew_strlen (documents[i]));
+        }
+
+      CHECK_BOOL (scew_parser_load_batch (pool, readers, N_DOCUMENTS, threads,
+                                          trees, errors),
+                  SCEW_FALSE, "Invalid document not detected");
+
+      for (i = 0; i < N_DOCUMENTS; ++i)
+        {
+          if (INVALID == i)
+            {
+              CHECK_NULL_PTR (trees[i], "Invalid document %d loaded", i);
+              CHECK_S_INT (errors[i], scew_error_expat,
+                           "Invalid document %d error", i);
+            }
+          else
+            {
+              XML_Char id[16];
+              scew_element *root = NULL;
+
+              CHECK_PTR (trees[i], "Document %d not loaded", i);
+              CHECK_S_INT (errors[i], scew_error_none,
+                           "Document %d error", i);
+
+              /* Trees are in the same order as readers. */
+              root = scew_tree_root (trees[i]);
+              check_sprintf (id, _XT("%u"), i);
+              CHECK_STR (scew_attribute_value
+                         (scew_element_attribute_by_name (root, _XT("id"))),
+                         id, "Document %d out of order", i);
+            }
+
+          scew_tree_free (trees[i]);
+          scew_reader_free (readers[i]);
+        }
+
+      scew_parser_pool_free (pool);
+    }
+}
+END_TEST
+
+/* Files */
+
+START_TEST (test_load_files)
+{
+  static char const *NOT_XML = SCEW_TESTSDIR"/check_reader_file.txt";
+  static char const *MISSING = SCEW_TESTSDIR"/does_not_exist.xml";
+
+  char const *file_names[3];
+  scew_tree *trees[3];
+  scew_error errors[3];
+  char file_name[] = "/tmp/check_parser_batch_XXXXXX";
+  FILE *file = NULL;
+  int fd = mkstemp (file_name);
+
+  CHECK_S_INT (fd != -1, 1, "Unable to create temporary file");
+
+  file = fdopen (fd, "w");
+  fputs ("<doc/>", file);
+  fclose (file);
+
+  file_names[0] = file_name;
+  file_names[1] = NOT_XML;
+  file_names[2] = MISSING;
+
+  CHECK_BOOL (scew_parser_load_batch_files (NULL, file_names, 3, 2,
+                                            trees, errors),
+              SCEW_FALSE, "Invalid files not detected");
+
+  CHECK_PTR (trees[0], "Temporary file not loaded");
+  CHECK_S_INT (errors[0], scew_error_none, "Temporary file error");
+  CHECK_NULL_PTR (trees[1], "Text file loaded");
+  CHECK_S_INT (errors[1], scew_error_expat, "Text file error");
+  CHECK_NULL_PTR (trees[2], "Missing file loaded");
+  CHECK_S_INT (errors[2], scew_error_io, "Missing file error");
+
+  scew_tree_free (trees[0]);
+  remove (file_name);
+}
+END_TEST
+
+
+/* Suite */
+
+static Suite*
+parser_batch_suite (void)
+{
+  Suite *s = suite_create ("SCEW parser batch");
+
+  /* Core test case */
+  TCase *tc_core = tcase_create ("Core");
+  tcase_add_test (tc_core, test_load_readers);
+  tcase_add_test (tc_core, test_load_files);
+  suite_add_tcase (s, tc_core);
+
+  return s;
+}
+
+void
+run_tests (SRunner *sr)
+{
+  srunner_add_suite (sr, parser_batch_suite ());
+}
@@ -0,0 +1,295 @@
+/**
+ * @file     check_reader_mmap.c
+ * @brief    Unit testing for SCEW parser pools
+ * @author   Aleix Conchillo Flaque <aconchillo@gmail.com>
+ * @date     Sun Oct 18, 2026 10:12
+ *
+ * @if copyright
+ *
+ * Copyright (C) 2026 Aleix Conchillo Flaque
+ *
+ * SCEW is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * SCEW is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ *
+ * @endif
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "test.h"
+
+#include <scew/parser_pool.h>
+#include <scew/reader_buffer.h>
+
+#include <check.h>
+
+#ifdef HAVE_LIBPTHREAD
+#include <pthread.h>
+#endif /* HAVE_LIBPTHREAD */
+
+
+/* Unit tests */
+
+static XML_Char const *TEST_XML =
+  _XT("<test>\n"
+      "   <element>element contents</element>\n"
+      "   <element attribute=\"value\"/>\n"
+      "   <element> </element>\n"
+      "</test>");
+
+static scew_tree* test_load_ (scew_parser *parser);
+
+/* Allocation */
+
+START_TEST (test_alloc)
+{
+  scew_parser_pool *pool = scew_parser_pool_create ();
+
+  CHECK_PTR (pool, "Unable to create parser pool");
+
+  scew_parser_pool_free (pool);
+
+  pool = scew_parser_pool_namespace_create (_XT(':'));
+
+  CHECK_PTR (pool, "Unable to create parser pool (namespaces)");
+
+  scew_parser_pool_free (pool);
+}
+END_TEST
+
+/* Reuse */
+
+START_TEST (test_reuse)
+{
+  scew_parser_pool *pool = scew_parser_pool_create ();
+
+  scew_parser *parser = scew_parser_pool_acquire (pool);
+  scew_parser *other = scew_parser_pool_acquire (pool);
+
+  CHECK_PTR (parser, "Unable to acquire parser");
+  CHECK_PTR (other, "Unable to acquire parser");
+  fail_unless (parser != other, "Parsers in use must be different");
+
+  scew_parser_pool_release (pool, parser);
+
+  fail_unless (scew_parser_pool_acquire (pool) == parser,
+               "Released parser was not reused");
+
+  /* More parsers than a thread caches. */
+  {
+    enum { N_PARSERS = 20 };
+
+    scew_parser *parsers[N_PARSERS];
+    scew_parser *reused[N_PARSERS];
+    unsigned int i = 0;
+
+    for (i = 0; i < N_PARSERS; ++i)
+      {
+        parsers[i] = scew_parser_pool_acquire (pool);
+        CHECK_PTR (parsers[i], "Unable to acquire parser %d", i);
+      }
+    for (i = 0; i < N_PARSERS; ++i)
+      {
+        scew_parser_pool_release (pool, parsers[i]);
+      }
+
+    /* All of them are reused, whether cached or shared. */
+    for (i = 0; i < N_PARSERS; ++i)
+      {
+        reused[i] = scew_parser_pool_acquire (pool);
+      }
+    for (i = 0; i < N_PARSERS; ++i)
+      {
+        unsigned int j = 0;
+
+        for (j = 0; (j < N_PARSERS) && (parsers[j] != reused[i]); ++j)
+          {
+          }
+        fail_unless (j < N_PARSERS, "Released parser %d was not reused", i);
+        parsers[j] = NULL;
+      }
+    for (i = 0; i < N_PARSERS; ++i)
+      {
+        scew_parser_pool_release (pool, reused[i]);
+      }
+  }
+
+  scew_parser_pool_release (pool, parser);
+  scew_parser_pool_release (pool, other);
+
+  scew_parser_pool_free (pool);
+}
+END_TEST
+
+/* Configuration */
+
+static scew_bool
+element_hook_ (scew_parser *parser, void *element, void *user_data)
+{
+  unsigned int *counter = user_data;
+
+  *counter += 1;
+
+  return SCEW_TRUE;
+}
+
+START_TEST (test_configuration)
+{
+  unsigned int counter = 0;
+  unsigned int other_counter = 0;
+  scew_tree *tree = NULL;
+  scew_element *element = NULL;
+  scew_parser *parser = NULL;
+  scew_parser_pool *pool = scew_parser_pool_create ();
+
+  scew_parser_pool_set_element_hook (pool, element_hook_, &counter);
+  scew_parser_pool_ignore_whitespaces (pool, SCEW_FALSE);
+  scew_parser_pool_set_arena (pool, SCEW_TRUE);
+  scew_parser_pool_set_buffer_size (pool, 16);
+
+  parser = scew_parser_pool_acquire (pool);
+
+  tree = test_load_ (parser);
+  CHECK_PTR (tree, "Unable to load XML with pooled parser");
+  CHECK_U_INT (counter, 4, "Element hook not called for all elements");
+
+  /* White spaces are kept. */
+  element = scew_element_by_index (scew_tree_root (tree), 2);
+  CHECK_STR (scew_element_contents (element), _XT(" "),
+             "White spaces not preserved");
+  scew_tree_free (tree);
+
+  /* Changes to the parser are undone when released. */
+  scew_parser_set_element_hook (parser, element_hook_, &other_counter);
+  scew_parser_pool_release (pool, parser);
+
+  parser = scew_parser_pool_acquire (pool);
+
+  tree = test_load_ (parser);
+  CHECK_PTR (tree, "Unable to load XML with reused parser");
+  CHECK_U_INT (counter, 8, "Pool element hook not restored");
+  CHECK_U_INT (other_counter, 0, "Parser element hook not undone");
+  scew_tree_free (tree);
+
+  scew_parser_pool_release (pool, parser);
+  scew_parser_pool_free (pool);
+}
+END_TEST
+
+#ifdef HAVE_LIBPTHREAD
+
+/* Threads */
+
+enum { N_THREADS = 8, N_LOADS = 500 };
+
+static void*
+thread_loads_ (void *data)
+{
+  scew_parser_pool *pool = data;
+  unsigned long failures = 0;
+  unsigned int i = 0;
+
+  for (i = 0; i < N_LOADS; ++i)
+    {
+      scew_parser *parser = scew_parser_pool_acquire (pool);
+      scew_tree *tree = (parser != NULL) ? test_load_ (parser) : NULL;
+
+      if ((NULL == tree) || (scew_element_count (scew_tree_root (tree)) != 3))
+        {
+          failures += 1;
+        }
+
+      scew_tree_free (tree);
+      if (parser != NULL)
+        {
+          scew_parser_pool_release (pool, parser);
+        }
+    }
+
+  return (void *) failures;
+}
+
+START_TEST (test_threads)
+{
+  pthread_t threads[N_THREADS];
+  unsigned int i = 0;
+
+  scew_parser_pool *pool = scew_parser_pool_create ();
+
+  for (i = 0; i < N_THREADS; ++i)
+    {
+      CHECK_S_INT (pthread_create (&threads[i], NULL, thread_loads_, pool),
+                   0, "Unable to create thread %d", i);
+    }
+
+  for (i = 0; i < N_THREADS; ++i)
+    {
+      void *failures = NULL;
+      pthread_join (threads[i], &failures);
+      CHECK_U_INT ((unsigned long) failures, 0,
+                   "Thread %d could not load all documents", i);
+    }
+
+  scew_parser_pool_free (pool);
+}
+END_TEST
+
+#endif /* HAVE_LIBPTHREAD */
+
+
+/* Private */
+
+scew_tree*
+test_load_ (scew_parser *parser)
+{
+  scew_tree *tree = NULL;
+  scew_reader *reader =
+    scew_reader_buffer_create (TEST_XML, scew_strlen (TEST_XML));
+
+  tree = scew_parser_load (parser, reader);
+
+  scew_reader_free (reader);
+
+  return tree;
+}
+
+
+/* Suite */
+
+static Suite*
+parser_pool_suite (void)
+{
+  Suite *s = suite_create ("SCEW parser pool");
+
+  /* Core test case */
+  TCase *tc_core = tcase_create ("Core");
+  tcase_add_test (tc_core, test_alloc);
+  tcase_add_test (tc_core, test_reuse);
+  tcase_add_test (tc_core, test_configuration);
+#ifdef HAVE_LIBPTHREAD
+  tcase_add_test (tc_core, test_threads);
+#endif /* HAVE_LIBPTHREAD */
+  suite_add_tcase (s, tc_core);
+
+  return s;
+}
+
+void
+run_tests (SRunner *sr)
+{
+  srunner_add_suite (sr, parser_pool_suite ());
+}
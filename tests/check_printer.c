@@ -30,9 +30,14 @@
 
 #include <scew/printer.h>
 #include <scew/writer_buffer.h>
+#include <scew/writer_file.h>
+#include <scew/writer_growable.h>
 
 #include <check.h>
 
+#include <stdio.h>
+#include <stdlib.h>
+
 
 /* Unit tests */
 
@@ -198,6 +203,351 @@ START_TEST (test_print_attribute)
 }
 END_TEST
 
+/* Print interleaved */
+
+START_TEST (test_print_interleaved)
+{
+  enum { MAX_BUFFER = 1024 };
+
+  static XML_Char const *BEFORE = _XT("<!-- before -->\n");
+  static XML_Char const *BETWEEN = _XT("<!-- between -->");
+  static XML_Char const *AFTER = _XT("\n");
+
+  XML_Char contents[MAX_BUFFER];
+  XML_Char expected[MAX_BUFFER];
+
+  FILE *file = tmpfile ();
+
+  CHECK_PTR (file, "Unable to create temporary file");
+
+  /* The writer closes the file when freed. */
+  scew_writer *writer = scew_writer_fp_create (file);
+
+  CHECK_PTR (writer, "Unable to create file writer");
+
+  scew_printer *printer = scew_printer_create (writer);
+
+  /* Create XML tree */
+  scew_tree *tree = test_tree_create_ ();
+
+  /* Printer output must not be kept behind direct writes. */
+  scew_element *root = scew_tree_root (tree);
+  scew_fputs (BEFORE, file);
+  CHECK_BOOL (scew_printer_print_element_children (printer,
+                                                   scew_element_by_index
+                                                   (root, 3)),
+              SCEW_TRUE, "Unable to print children (subelement)");
+  scew_fputs (BETWEEN, file);
+  CHECK_BOOL (scew_printer_print_element_attributes (printer,
+                                                     scew_element_by_index
+                                                     (root, 2)),
+              SCEW_TRUE, "Unable to print element attributes");
+  scew_fputs (AFTER, file);
+
+  rewind (file);
+  size_t length = fread (contents, sizeof (XML_Char), MAX_BUFFER - 1, file);
+  contents[length] = _XT('\0');
+
+  scew_strcpy (expected, BEFORE);
+  scew_strcat (expected, TEST_CHILDREN_CONTENTS);
+  scew_strcat (expected, BETWEEN);
+  scew_strcat (expected, TEST_ATTRIBUTE_CONTENTS);
+  scew_strcat (expected, AFTER);
+
+  CHECK_STR (contents, expected, "Interleaved output does not match");
+
+  scew_tree_free (tree);
+  scew_writer_free (writer);
+  scew_printer_free (printer);
+}
+END_TEST
+
+/* Print escaped */
+
+START_TEST (test_print_escaped)
+{
+  static XML_Char const *SPECIAL = _XT("<>&'\"");
+
+  XML_Char contents[100];
+  unsigned int i = 0;
+  unsigned int j = 0;
+
+  /* Try every special character at every offset, so it is found by
+     both vectorized and scalar scans. */
+  for (i = 0; i < 5; ++i)
+    {
+      for (j = 0; j < 70; ++j)
+        {
+          XML_Char *write_buffer = NULL;
+          XML_Char *escaped = NULL;
+          XML_Char *expected = NULL;
+          unsigned int k = 0;
+
+          scew_writer *writer = test_writer_create_ (&write_buffer);
+          scew_printer *printer = scew_printer_create (writer);
+          scew_element *element = scew_element_create (_XT("e"));
+
+          for (k = 0; k < 70; ++k)
+            {
+              contents[k] = _XT('a') + (k % 26);
+            }
+          contents[j] = SPECIAL[i];
+          contents[k] = _XT('\0');
+
+          scew_element_set_contents (element, contents);
+          scew_element_add_attribute_pair (element, _XT("a"), contents);
+
+          CHECK_BOOL (scew_printer_print_element (printer, element),
+                      SCEW_TRUE, "Unable to print escaped element");
+
+          escaped = scew_strescape (contents);
+          expected = calloc (2 * scew_strlen (escaped) + 20,
+                             sizeof (XML_Char));
+          scew_strcpy (expected, _XT("<e a=\""));
+          scew_strcat (expected, escaped);
+          scew_strcat (expected, _XT("\">"));
+          scew_strcat (expected, escaped);
+          scew_strcat (expected, _XT("</e>\n"));
+
+          CHECK_STR (write_buffer, expected,
+                     "Escaped element does not match (%d, %d)", i, j);
+
+          free (expected);
+          free (escaped);
+          scew_element_free (element);
+          scew_writer_free (writer);
+          scew_printer_free (printer);
+        }
+    }
+
+  /* Long markup with clean runs of many lengths, so text is escaped
+     both inline and by scanning, and across output buffer flushes. */
+  {
+    enum { LONG_LENGTH = 20000 };
+
+    XML_Char *text = calloc (LONG_LENGTH + 1, sizeof (XML_Char));
+    XML_Char *escaped = NULL;
+    XML_Char *expected = NULL;
+    scew_writer *writer = scew_writer_growable_create (0);
+    scew_printer *printer = scew_printer_create (writer);
+    scew_element *element = scew_element_create (_XT("e"));
+    unsigned int run = 0;
+    unsigned int k = 0;
+
+    for (k = 0; k < LONG_LENGTH; ++k)
+      {
+        if (0 == run)
+          {
+            text[k] = SPECIAL[k % 5];
+            run = k % 41;
+          }
+        else
+          {
+            text[k] = _XT('a') + (k % 26);
+            run -= 1;
+          }
+      }
+
+    scew_element_set_contents (element, text);
+    scew_printer_set_indented (printer, SCEW_FALSE);
+
+    CHECK_BOOL (scew_printer_print_element (printer, element), SCEW_TRUE,
+                "Unable to print long escaped element");
+
+    escaped = scew_strescape (text);
+    expected = calloc (scew_strlen (escaped) + 10, sizeof (XML_Char));
+    scew_strcpy (expected, _XT("<e>"));
+    scew_strcat (expected, escaped);
+    scew_strcat (expected, _XT("</e>"));
+
+    CHECK_STR (scew_writer_growable_buffer (writer), expected,
+               "Long escaped element does not match");
+
+    free (expected);
+    free (escaped);
+    free (text);
+    scew_element_free (element);
+    scew_writer_free (writer);
+    scew_printer_free (printer);
+  }
+}
+END_TEST
+
+/* Print deep */
+
+START_TEST (test_print_deep)
+{
+  enum { DEPTH = 30, LENGTH = 20000 };
+
+  XML_Char *contents = calloc (LENGTH + 1, sizeof (XML_Char));
+  XML_Char *expected = calloc (2 * LENGTH, sizeof (XML_Char));
+  scew_element *root = scew_element_create (_XT("e"));
+  scew_element *element = root;
+  unsigned int i = 0;
+  unsigned int j = 0;
+
+  scew_writer *writer = scew_writer_growable_create (0);
+  scew_printer *printer = scew_printer_create (writer);
+
+  /* Deep indentation and contents bigger than any internal buffer. */
+  for (i = 0; i < LENGTH; ++i)
+    {
+      contents[i] = _XT('a') + (i % 26);
+    }
+  for (i = 1; i < DEPTH; ++i)
+    {
+      element = scew_element_add (element, _XT("e"));
+    }
+  scew_element_set_contents (element, contents);
+
+  for (i = 0; i < DEPTH; ++i)
+    {
+      for (j = 0; j < 3 * i; ++j)
+        {
+          scew_strcat (expected, _XT(" "));
+        }
+      scew_strcat (expected, _XT("<e>"));
+      if (i < DEPTH - 1)
+        {
+          scew_strcat (expected, _XT("\n"));
+        }
+    }
+  scew_strcat (expected, contents);
+  scew_strcat (expected, _XT("</e>\n"));
+  for (i = DEPTH - 1; i > 0; --i)
+    {
+      for (j = 0; j < 3 * (i - 1); ++j)
+        {
+          scew_strcat (expected, _XT(" "));
+        }
+      scew_strcat (expected, _XT("</e>\n"));
+    }
+
+  CHECK_BOOL (scew_printer_print_element (printer, root), SCEW_TRUE,
+              "Unable to print deep element");
+
+  CHECK_STR (scew_writer_growable_buffer (writer), expected,
+             "Deep element does not match");
+
+  free (expected);
+  free (contents);
+  scew_element_free (root);
+  scew_writer_free (writer);
+  scew_printer_free (printer);
+}
+END_TEST
+
+/* Print parallel */
+
+START_TEST (test_print_parallel)
+{
+  enum { CHILDREN = 1000 };
+
+  scew_element *root = scew_element_create (_XT("root"));
+  scew_element *child = NULL;
+  XML_Char name[64];
+  unsigned int i = 0;
+
+  scew_writer *sequential = scew_writer_growable_create (0);
+  scew_writer *parallel = scew_writer_growable_create (0);
+  scew_printer *printer = scew_printer_create (sequential);
+
+  /* Children of different sizes, so threads finish out of order. */
+  for (i = 0; i < CHILDREN; ++i)
+    {
+      check_sprintf (name, _XT("child%u"), i);
+      child = scew_element_add (root, name);
+      scew_element_add_attribute_pair (child, _XT("id"), name);
+      if (i % 3 == 0)
+        {
+          scew_element_set_contents (child, _XT("a < b & c"));
+        }
+      else
+        {
+          child = scew_element_add (child, _XT("nested"));
+          scew_element_add (child, _XT("leaf"));
+        }
+    }
+
+  CHECK_BOOL (scew_printer_print_element (printer, root), SCEW_TRUE,
+              "Unable to print element sequentially");
+
+  scew_printer_set_writer (printer, parallel);
+  scew_printer_set_threads (printer, 4);
+
+  CHECK_BOOL (scew_printer_print_element (printer, root), SCEW_TRUE,
+              "Unable to print element in parallel");
+
+  CHECK_U_INT (scew_writer_growable_length (parallel),
+               scew_writer_growable_length (sequential),
+               "Parallel output length does not match");
+  CHECK_STR (scew_writer_growable_buffer (parallel),
+             scew_writer_growable_buffer (sequential),
+             "Parallel output does not match");
+
+  scew_element_free (root);
+  scew_writer_free (sequential);
+  scew_writer_free (parallel);
+  scew_printer_free (printer);
+}
+END_TEST
+
+START_TEST (test_print_parallel_deep)
+{
+  enum { GROUPS = 2, SUBGROUPS = 3, ITEMS = 300 };
+
+  scew_element *root = scew_element_create (_XT("root"));
+  scew_element *group = NULL;
+  scew_element *subgroup = NULL;
+  scew_element *item = NULL;
+  unsigned int i = 0;
+  unsigned int j = 0;
+  unsigned int k = 0;
+
+  scew_writer *sequential = scew_writer_growable_create (0);
+  scew_writer *parallel = scew_writer_growable_create (0);
+  scew_printer *printer = scew_printer_create (sequential);
+
+  /* Big subtrees below elements with few children (some with text). */
+  for (i = 0; i < GROUPS; ++i)
+    {
+      group = scew_element_add (root, _XT("group"));
+      scew_element_set_contents (group, _XT("group text"));
+      for (j = 0; j < SUBGROUPS; ++j)
+        {
+          subgroup = scew_element_add (group, _XT("subgroup"));
+          for (k = 0; k < ITEMS; ++k)
+            {
+              item = scew_element_add (subgroup, _XT("item"));
+              if (k % 2 == 0)
+                {
+                  scew_element_add_pair (item, _XT("value"), _XT("1 < 2"));
+                }
+            }
+        }
+    }
+  scew_element_add (root, _XT("last"));
+
+  CHECK_BOOL (scew_printer_print_element (printer, root), SCEW_TRUE,
+              "Unable to print element sequentially");
+
+  scew_printer_set_writer (printer, parallel);
+  scew_printer_set_threads (printer, 4);
+
+  CHECK_BOOL (scew_printer_print_element (printer, root), SCEW_TRUE,
+              "Unable to print element in parallel");
+
+  CHECK_STR (scew_writer_growable_buffer (parallel),
+             scew_writer_growable_buffer (sequential),
+             "Parallel output does not match");
+
+  scew_element_free (root);
+  scew_writer_free (sequential);
+  scew_writer_free (parallel);
+  scew_printer_free (printer);
+}
+END_TEST
+
 
 /* Suite */
 
@@ -212,6 +562,11 @@ printer_suite (void)
   tcase_add_test (tc_core, test_print_tree);
   tcase_add_test (tc_core, test_print_element);
   tcase_add_test (tc_core, test_print_attribute);
+  tcase_add_test (tc_core, test_print_interleaved);
+  tcase_add_test (tc_core, test_print_escaped);
+  tcase_add_test (tc_core, test_print_deep);
+  tcase_add_test (tc_core, test_print_parallel);
+  tcase_add_test (tc_core, test_print_parallel_deep);
   suite_add_tcase (s, tc_core);
 
   return s;
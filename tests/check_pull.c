@@ -0,0 +1,252 @@
+/**
+ * @file     check_pull.c
+ * @brief    Unit testing for SCEW pull parser
+ * @author   Aleix Conchillo Flaque <aconchillo@gmail.com>
+ * @date     Sun Oct 18, 2026 10:12
+ *
+ * @if copyright
+ *
+ * Copyright (C) 2026 Aleix Conchillo Flaque
+ *
+ * SCEW is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * SCEW is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ *
+ * @endif
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "test.h"
+
+#include <scew/error.h>
+#include <scew/parser.h>
+#include <scew/pull.h>
+#include <scew/reader_buffer.h>
+
+#include <check.h>
+
+
+/* Unit tests */
+
+static XML_Char const *TEST_XML =
+  _XT("<?xml version=\"1.0\"?>\n"
+      "<config version=\"2\">\n"
+      "  <server name=\"a\" port=\"80\">primary &amp; main</server>\n"
+      "  <empty/>\n"
+      "  <group><server name=\"b\"/>text</group>\n"
+      "</config>");
+
+static XML_Char const* test_events_ (scew_parser *parser,
+                                     XML_Char const *xml);
+
+/* Events */
+
+START_TEST (test_events)
+{
+  scew_parser *parser = scew_parser_create ();
+
+  CHECK_PTR (parser, "Unable to create parser");
+
+  CHECK_STR (test_events_ (parser, TEST_XML),
+             _XT("<config:1><server:2>[primary & main:2]</server:2>"
+                 "<empty:2></empty:2><group:2><server:3></server:3>"
+                 "[text:2]</group:2></config:1>$"),
+             "Wrong pull events");
+
+  /* Whitespaces are kept if requested. */
+  scew_parser_ignore_whitespaces (parser, SCEW_FALSE);
+  CHECK_STR (test_events_ (parser, _XT("<a> <b/> </a>")),
+             _XT("<a:1>[ :1]<b:2></b:2>[ :1]</a:1>$"),
+             "Wrong pull events with whitespaces");
+
+  /* Small reads split tags and text across several reader calls. */
+  scew_parser_ignore_whitespaces (parser, SCEW_TRUE);
+  scew_parser_set_buffer_size (parser, 3);
+  CHECK_STR (test_events_ (parser, TEST_XML),
+             _XT("<config:1><server:2>[primary & main:2]</server:2>"
+                 "<empty:2></empty:2><group:2><server:3></server:3>"
+                 "[text:2]</group:2></config:1>$"),
+             "Wrong pull events with small reads");
+
+  scew_parser_free (parser);
+}
+END_TEST
+
+/* Attributes */
+
+START_TEST (test_attributes)
+{
+  scew_parser *parser = scew_parser_create ();
+  scew_reader *reader = scew_reader_buffer_create (TEST_XML,
+                                                   scew_strlen (TEST_XML));
+  scew_pull *pull = scew_pull_create (parser, reader);
+
+  CHECK_PTR (pull, "Unable to create pull parser");
+
+  CHECK_U_INT (scew_pull_next (pull), scew_pull_start_element,
+               "First event should be a start tag");
+  CHECK_U_INT (scew_pull_attribute_count (pull), 1,
+               "Wrong number of attributes for config");
+  CHECK_STR (scew_pull_attribute_by_name (pull, _XT("version")), _XT("2"),
+             "Wrong config version attribute");
+
+  CHECK_U_INT (scew_pull_next (pull), scew_pull_start_element,
+               "Second event should be a start tag");
+  CHECK_STR (scew_pull_name (pull), _XT("server"), "Wrong element name");
+  CHECK_U_INT (scew_pull_attribute_count (pull), 2,
+               "Wrong number of attributes for server");
+  CHECK_STR (scew_pull_attribute_name (pull, 0), _XT("name"),
+             "Wrong first attribute name");
+  CHECK_STR (scew_pull_attribute_value (pull, 0), _XT("a"),
+             "Wrong first attribute value");
+  CHECK_STR (scew_pull_attribute_name (pull, 1), _XT("port"),
+             "Wrong second attribute name");
+  CHECK_STR (scew_pull_attribute_value (pull, 1), _XT("80"),
+             "Wrong second attribute value");
+  CHECK_NULL_PTR (scew_pull_attribute_by_name (pull, _XT("role")),
+                  "Attribute role should not exist");
+  CHECK_NULL_PTR (scew_pull_contents (pull), "Start tags have no text");
+
+  CHECK_U_INT (scew_pull_next (pull), scew_pull_text,
+               "Third event should be text");
+  CHECK_U_INT (scew_pull_attribute_count (pull), 0,
+               "Text events have no attributes");
+  CHECK_NULL_PTR (scew_pull_name (pull), "Text events have no name");
+
+  CHECK_U_INT (scew_pull_next (pull), scew_pull_end_element,
+               "Fourth event should be an end tag");
+  CHECK_U_INT (scew_pull_attribute_count (pull), 0,
+               "End tags have no attributes");
+
+  scew_pull_free (pull);
+  scew_reader_free (reader);
+  scew_parser_free (parser);
+}
+END_TEST
+
+/* Errors */
+
+START_TEST (test_error)
+{
+  static XML_Char const *XML = _XT("<a><b></a>");
+
+  scew_parser *parser = scew_parser_create ();
+  scew_reader *reader = scew_reader_buffer_create (XML, scew_strlen (XML));
+  scew_pull *pull = scew_pull_create (parser, reader);
+  scew_tree *tree = NULL;
+
+  CHECK_U_INT (scew_pull_next (pull), scew_pull_start_element,
+               "First event should be a start tag");
+  CHECK_U_INT (scew_pull_next (pull), scew_pull_start_element,
+               "Second event should be a start tag");
+  CHECK_U_INT (scew_pull_next (pull), scew_pull_error,
+               "Mismatched tag should be an error");
+  CHECK_U_INT (scew_error_code (), scew_error_expat,
+               "Mismatched tag should be an Expat error");
+  CHECK_U_INT (scew_pull_next (pull), scew_pull_error,
+               "Errors should be permanent");
+
+  scew_pull_free (pull);
+  scew_reader_free (reader);
+
+  /* The parser can load trees again. */
+  reader = scew_reader_buffer_create (TEST_XML, scew_strlen (TEST_XML));
+  tree = scew_parser_load (parser, reader);
+
+  CHECK_PTR (tree, "Unable to load tree after pull parsing");
+  CHECK_STR (scew_element_name (scew_tree_root (tree)), _XT("config"),
+             "Wrong root element after pull parsing");
+
+  scew_tree_free (tree);
+  scew_reader_free (reader);
+  scew_parser_free (parser);
+}
+END_TEST
+
+
+/* Private */
+
+XML_Char const*
+test_events_ (scew_parser *parser, XML_Char const *xml)
+{
+  static XML_Char events[CHECK_MAX_BUFFER_];
+
+  XML_Char event[CHECK_MAX_BUFFER_];
+  scew_reader *reader = scew_reader_buffer_create (xml, scew_strlen (xml));
+  scew_pull *pull = scew_pull_create (parser, reader);
+  scew_pull_event type = scew_pull_start_element;
+
+  CHECK_PTR (pull, "Unable to create pull parser");
+
+  events[0] = _XT('\0');
+  do
+    {
+      type = scew_pull_next (pull);
+      switch (type)
+        {
+        case scew_pull_start_element:
+          check_sprintf (event, _XT("<%s:%u>"), scew_pull_name (pull),
+                         scew_pull_depth (pull));
+          break;
+        case scew_pull_end_element:
+          check_sprintf (event, _XT("</%s:%u>"), scew_pull_name (pull),
+                         scew_pull_depth (pull));
+          break;
+        case scew_pull_text:
+          check_sprintf (event, _XT("[%s:%u]"), scew_pull_contents (pull),
+                         scew_pull_depth (pull));
+          break;
+        case scew_pull_end_document:
+          scew_strcpy (event, _XT("$"));
+          break;
+        default:
+          scew_strcpy (event, _XT("!"));
+          break;
+        }
+      scew_strcat (events, event);
+    }
+  while ((type != scew_pull_end_document) && (type != scew_pull_error));
+
+  scew_pull_free (pull);
+  scew_reader_free (reader);
+
+  return events;
+}
+
+
+/* Suite */
+
+static Suite*
+pull_suite (void)
+{
+  Suite *s = suite_create ("SCEW pull parser");
+
+  /* Core test case */
+  TCase *tc_core = tcase_create ("Core");
+  tcase_add_test (tc_core, test_events);
+  tcase_add_test (tc_core, test_attributes);
+  tcase_add_test (tc_core, test_error);
+  suite_add_tcase (s, tc_core);
+
+  return s;
+}
+
+void
+run_tests (SRunner *sr)
+{
+  srunner_add_suite (sr, pull_suite ());
+}
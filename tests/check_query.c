@@ -0,0 +1,344 @@
+/**
+ * @file     check_query.c
+ * @brief    Unit testing for SCEW queries
+ * @author   Aleix Conchillo Flaque <aconchillo@gmail.com>
+ * @date     Sun Oct 18, 2026 10:12
+ *
+ * @if copyright
+ *
+ * Copyright (C) 2026 Aleix Conchillo Flaque
+ *
+ * SCEW is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * SCEW is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ *
+ * @endif
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include "test.h"
+
+#include <scew/attribute.h>
+#include <scew/error.h>
+#include <scew/parser.h>
+#include <scew/query.h>
+#include <scew/reader_buffer.h>
+
+#include <check.h>
+
+
+/* Unit tests */
+
+static XML_Char const *TEST_XML =
+  _XT("<config>\n"
+      "  <servers>\n"
+      "    <server role=\"primary\" name=\"a\"><port>80</port></server>\n"
+      "    <server role=\"backup\" name=\"b\"><port>81</port></server>\n"
+      "    <server role=\"primary\" name=\"c\"><port>82</port></server>\n"
+      "  </servers>\n"
+      "  <group>\n"
+      "    <server name=\"d\">\n"
+      "      <port>83</port>\n"
+      "      <group><server name=\"e\"/></group>\n"
+      "    </server>\n"
+      "  </group>\n"
+      "</config>");
+
+enum { MAX_MATCHES = 32 };
+
+typedef struct
+{
+  unsigned int n_matches;
+  unsigned int limit;
+  XML_Char matches[MAX_MATCHES * 8];
+} query_result;
+
+static scew_tree* test_load_ (void);
+static scew_bool test_hook_ (scew_element *element, void *data);
+static XML_Char const* test_query_ (scew_element const *element,
+                                    XML_Char const *expression);
+
+/* Allocation */
+
+START_TEST (test_alloc)
+{
+  static XML_Char const *INVALID[] =
+    {
+      _XT(""), _XT("/"), _XT("a/"), _XT("a//"), _XT("a b"), _XT("a/[1]"),
+      _XT("a["), _XT("a[]"), _XT("a[0]"), _XT("a[@]"), _XT("a[@x=1]"),
+      _XT("a[@x='v]"), _XT("a[x]"), _XT("/a/b]"), _XT("a=b")
+    };
+
+  unsigned int i = 0;
+  scew_query *query = scew_query_create (_XT("/a//b/*[@c='d'][2]"));
+
+  CHECK_PTR (query, "Unable to create query");
+
+  scew_query_free (query);
+
+  for (i = 0; i < sizeof (INVALID) / sizeof (INVALID[0]); ++i)
+    {
+      query = scew_query_create (INVALID[i]);
+
+      CHECK_NULL_PTR (query, "Query \"%s\" should not compile", INVALID[i]);
+      CHECK_U_INT (scew_error_code (), scew_error_query,
+                   "Wrong error for query \"%s\"", INVALID[i]);
+    }
+}
+END_TEST
+
+/* Child steps */
+
+START_TEST (test_child)
+{
+  scew_tree *tree = test_load_ ();
+  scew_element *root = scew_tree_root (tree);
+  scew_element *servers = scew_element_by_name (root, _XT("servers"));
+
+  CHECK_STR (test_query_ (root, _XT("/config/servers/server")),
+             _XT("a b c "), "Absolute child query does not match");
+  CHECK_STR (test_query_ (root, _XT("servers/server")),
+             _XT("a b c "), "Relative child query does not match");
+  CHECK_STR (test_query_ (servers, _XT("/config/group/server")),
+             _XT("d "), "Absolute query from a child does not match");
+  CHECK_STR (test_query_ (servers, _XT("server/port")),
+             _XT("80 81 82 "), "Query contents do not match");
+  CHECK_STR (test_query_ (root, _XT("/config/*/server")),
+             _XT("a b c d "), "Wildcard query does not match");
+  CHECK_STR (test_query_ (root, _XT("/servers")),
+             _XT(""), "Query should not match the root element");
+  CHECK_STR (test_query_ (root, _XT("config")),
+             _XT(""), "Relative query should not match the context");
+
+  scew_tree_free (tree);
+}
+END_TEST
+
+/* Predicates */
+
+START_TEST (test_predicates)
+{
+  scew_tree *tree = test_load_ ();
+  scew_element *root = scew_tree_root (tree);
+
+  CHECK_STR (test_query_ (root,
+                          _XT("/config/servers/server[@role='primary']/port")),
+             _XT("80 82 "), "Attribute value query does not match");
+  CHECK_STR (test_query_ (root, _XT("servers/server[ @role = \"backup\" ]")),
+             _XT("b "), "Attribute value query (quotes) does not match");
+  CHECK_STR (test_query_ (root, _XT("//server[@role]")),
+             _XT("a b c "), "Attribute query does not match");
+  CHECK_STR (test_query_ (root, _XT("servers/server[2]")),
+             _XT("b "), "Positional query does not match");
+  CHECK_STR (test_query_ (root, _XT("servers/server[@role='primary'][2]")),
+             _XT("c "), "Attribute and position query does not match");
+  CHECK_STR (test_query_ (root, _XT("servers/server[1][@role='backup']")),
+             _XT(""), "Position and attribute query does not match");
+  CHECK_STR (test_query_ (root, _XT("servers/server[4]")),
+             _XT(""), "Out of range position should not match");
+
+  scew_tree_free (tree);
+}
+END_TEST
+
+/* Descendant steps */
+
+START_TEST (test_descendant)
+{
+  scew_tree *tree = test_load_ ();
+  scew_element *root = scew_tree_root (tree);
+
+  CHECK_STR (test_query_ (root, _XT("//server")),
+             _XT("a b c d e "), "Descendant query does not match");
+  CHECK_STR (test_query_ (root, _XT("//group//server")),
+             _XT("d e "), "Nested descendant query has duplicates");
+  CHECK_STR (test_query_ (root, _XT("//server[1]")),
+             _XT("a d e "), "Positions are relative to each parent");
+  CHECK_STR (test_query_ (root, _XT("/config//port")),
+             _XT("80 81 82 83 "), "Descendant contents do not match");
+  CHECK_STR (test_query_ (root, _XT("group//group/server")),
+             _XT("e "), "Relative descendant query does not match");
+  CHECK_STR (test_query_ (root, _XT("//config")),
+             _XT("config "), "Descendant query should match the root");
+
+  /* Some descendant queries use the tree index. */
+  scew_tree_build_index (tree, NULL);
+
+  CHECK_STR (test_query_ (root, _XT("//server")),
+             _XT("a b c d e "), "Indexed descendant query does not match");
+  CHECK_STR (test_query_ (root, _XT("//server[@role='primary']")),
+             _XT("a c "), "Indexed attribute query does not match");
+  CHECK_STR (test_query_ (root, _XT("//server[1]")),
+             _XT("a d e "), "Indexed positional query does not match");
+
+  scew_tree_free (tree);
+}
+END_TEST
+
+/* Children index */
+
+START_TEST (test_index)
+{
+  enum { N_CHILDREN = 64 };
+
+  unsigned int i = 0;
+  XML_Char name[CHECK_MAX_BUFFER_];
+  scew_element *root = scew_element_create (_XT("root"));
+
+  for (i = 0; i < N_CHILDREN; ++i)
+    {
+      scew_element *child =
+        scew_element_add (root, (i % 2) ? _XT("odd") : _XT("even"));
+
+      check_sprintf (name, _XT("%u"), i);
+      scew_element_add_attribute_pair (child, _XT("name"), name);
+    }
+
+  /* Lookups by name build the children index. */
+  CHECK_PTR (scew_element_by_name (root, _XT("odd")),
+             "Unable to find child element");
+
+  CHECK_STR (test_query_ (root, _XT("odd[3]")),
+             _XT("5 "), "Indexed positional query does not match");
+  CHECK_STR (test_query_ (root, _XT("even[@name='62']")),
+             _XT("62 "), "Indexed attribute query does not match");
+  CHECK_STR (test_query_ (root, _XT("none")),
+             _XT(""), "Indexed query should not match");
+
+  scew_element_free (root);
+}
+END_TEST
+
+/* Stop */
+
+START_TEST (test_stop)
+{
+  scew_tree *tree = test_load_ ();
+  scew_element *root = scew_tree_root (tree);
+  scew_query *query = scew_query_create (_XT("//server"));
+  scew_element *first = NULL;
+  query_result result;
+
+  first = scew_query_first (query, root);
+
+  CHECK_PTR (first, "Unable to find first element");
+  CHECK_STR (scew_attribute_value (scew_element_attribute_by_name
+                                   (first, _XT("name"))),
+             _XT("a"), "First element does not match");
+
+  result.n_matches = 0;
+  result.limit = 2;
+  result.matches[0] = _XT('\0');
+
+  CHECK_U_INT (scew_query_run (query, root, test_hook_, &result), 2,
+               "Query should stop when the hook returns false");
+
+  scew_query_free (query);
+  scew_tree_free (tree);
+}
+END_TEST
+
+
+/* Helpers */
+
+scew_tree*
+test_load_ (void)
+{
+  scew_parser *parser = scew_parser_create ();
+  scew_reader *reader =
+    scew_reader_buffer_create (TEST_XML, scew_strlen (TEST_XML));
+  scew_tree *tree = scew_parser_load (parser, reader);
+
+  CHECK_PTR (tree, "Unable to load test XML");
+
+  scew_reader_free (reader);
+  scew_parser_free (parser);
+
+  return tree;
+}
+
+scew_bool
+test_hook_ (scew_element *element, void *data)
+{
+  query_result *result = data;
+  scew_attribute *name = scew_element_attribute_by_name (element,
+                                                         _XT("name"));
+  XML_Char const *id = scew_element_contents (element);
+
+  if (name != NULL)
+    {
+      id = scew_attribute_value (name);
+    }
+  else if (NULL == id)
+    {
+      id = scew_element_name (element);
+    }
+
+  scew_strcat (result->matches, id);
+  scew_strcat (result->matches, _XT(" "));
+  result->n_matches += 1;
+
+  return (result->n_matches < result->limit);
+}
+
+XML_Char const*
+test_query_ (scew_element const *element, XML_Char const *expression)
+{
+  static query_result result;
+  scew_query *query = scew_query_create (expression);
+
+  CHECK_PTR (query, "Unable to create query \"%s\"", expression);
+
+  result.n_matches = 0;
+  result.limit = MAX_MATCHES;
+  result.matches[0] = _XT('\0');
+
+  CHECK_U_INT (scew_query_run (query, element, test_hook_, &result),
+               result.n_matches, "Wrong number of matches for \"%s\"",
+               expression);
+
+  scew_query_free (query);
+
+  return result.matches;
+}
+
+
+/* Suite */
+
+static Suite*
+query_suite (void)
+{
+  Suite *s = suite_create ("SCEW queries");
+
+  /* Core test case */
+  TCase *tc_core = tcase_create ("Core");
+  tcase_add_test (tc_core, test_alloc);
+  tcase_add_test (tc_core, test_child);
+  tcase_add_test (tc_core, test_predicates);
+  tcase_add_test (tc_core, test_descendant);
+  tcase_add_test (tc_core, test_index);
+  tcase_add_test (tc_core, test_stop);
+  suite_add_tcase (s, tc_core);
+
+  return s;
+}
+
+void
+run_tests (SRunner *sr)
+{
+  srunner_add_suite (sr, query_suite ());
+}
@@ -95,6 +95,41 @@ START_TEST (test_read)
 }
 END_TEST
 
+/* Span */
+
+START_TEST (test_span)
+{
+  static XML_Char const *BUFFER = _XT("This is a buffer for the reader");
+
+  XML_Char const *data = NULL;
+  XML_Char first[2] = _XT("");
+
+  scew_reader *reader = scew_reader_buffer_create (BUFFER,
+                                                   scew_strlen (BUFFER));
+
+  CHECK_PTR (reader, "Unable to create buffer reader");
+
+  CHECK_U_INT (scew_reader_read (reader, first, 1), 1,
+               "Invalid number of read bytes");
+
+  /* The rest of the buffer is returned in place. */
+  size_t length = scew_reader_span (reader, &data);
+
+  CHECK_BOOL (data == BUFFER + 1, SCEW_TRUE,
+              "Span should point to the reader buffer");
+  CHECK_U_INT (length, scew_strlen (BUFFER) - 1,
+               "Span should contain the rest of the buffer");
+
+  CHECK_BOOL (scew_reader_end (reader), SCEW_TRUE,
+              "Reader should be at the end");
+
+  CHECK_U_INT (scew_reader_span (reader, &data), 0,
+               "There is no more data to span");
+
+  scew_reader_free (reader);
+}
+END_TEST
+
 /* Miscellaneous */
 
 START_TEST (test_misc)
@@ -135,6 +170,7 @@ reader_buffer_suite (void)
   TCase *tc_core = tcase_create ("Core");
   tcase_add_test (tc_core, test_alloc);
   tcase_add_test (tc_core, test_read);
+  tcase_add_test (tc_core, test_span);
   tcase_add_test (tc_core, test_misc);
   suite_add_tcase (s, tc_core);
 
@@ -123,6 +123,13 @@ START_TEST (test_misc)
   CHECK_BOOL (scew_reader_error (reader), SCEW_FALSE,
               "Reader should have no error (nothing done yet)");
 
+  /* File readers have no span hook. */
+  XML_Char const *data = _XT("");
+
+  CHECK_U_INT (scew_reader_span (reader, &data), 0,
+               "Readers with no span hook should have no span");
+  CHECK_NULL_PTR (data, "Readers with no span hook should have no data");
+
   /* Close reader */
   CHECK_BOOL (scew_reader_close (reader), SCEW_TRUE,
               "Unable to close file reader");
@@ -0,0 +1,191 @@
+/**
+ * @file     check_reader_mmap.c
+ * @brief    Unit testing for SCEW memory-mapped file reader
+ * @author   Aleix Conchillo Flaque <aconchillo@gmail.com>
+ * @date     Sun Oct 18, 2026 10:12
+ *
+ * @if copyright
+ *
+ * Copyright (C) 2026 Aleix Conchillo Flaque
+ *
+ * SCEW is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * SCEW is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ *
+ * @endif
+ */
+
+#include "test.h"
+
+#include <scew/reader_mmap.h>
+
+#include <check.h>
+
+#include <string.h>
+
+
+/* Unit tests */
+
+static char const *TEST_FILE = SCEW_TESTSDIR"/check_reader_file.txt";
+
+static XML_Char const *TEST_CONTENTS =
+  _XT("This is just a dummy file to test the SCEW reader for "
+      "files. We don't need to use an XML file as SCEW readers "
+      "do not bother about file contents.");
+
+/* Allocation */
+
+START_TEST (test_alloc)
+{
+  scew_reader *reader = scew_reader_mmap_create (TEST_FILE);
+
+  CHECK_PTR (reader, "Unable to create mmap reader: %s", TEST_FILE);
+
+  scew_reader_free (reader);
+
+  reader = scew_reader_mmap_create (SCEW_TESTSDIR"/does_not_exist.txt");
+
+  CHECK_NULL_PTR (reader, "File does not exist, no reader expected");
+}
+END_TEST
+
+/* Read */
+
+START_TEST (test_read)
+{
+  enum { MAX_BUFFER_SIZE = 512 };
+
+  XML_Char read_buffer[MAX_BUFFER_SIZE] = _XT("");
+
+  scew_reader *reader = scew_reader_mmap_create (TEST_FILE);
+
+  CHECK_PTR (reader, "Unable to create mmap reader");
+
+  unsigned int i = 0;
+  while (i < scew_strlen (TEST_CONTENTS))
+    {
+      CHECK_U_INT (scew_reader_read (reader, read_buffer + i, 1), 1,
+                   "Invalid number of read bytes");
+      i += 1;
+    }
+  read_buffer[i] = _XT('\0');
+
+  CHECK_STR (read_buffer, TEST_CONTENTS, "Buffers do not match");
+
+  CHECK_U_INT (scew_reader_read (reader, read_buffer + i, 1), 0,
+               "There are no more bytes to read");
+
+  CHECK_BOOL (scew_reader_end (reader), SCEW_TRUE,
+              "Reader should be at the end");
+
+  scew_reader_free (reader);
+
+  /* Try to read full buffer */
+  reader = scew_reader_mmap_create (TEST_FILE);
+
+  scew_reader_read (reader, read_buffer, scew_strlen (TEST_CONTENTS) + 1);
+
+  CHECK_STR (read_buffer, TEST_CONTENTS, "Buffers do not match");
+
+  CHECK_BOOL (scew_reader_end (reader), SCEW_TRUE,
+              "Reader should be at the end");
+
+  scew_reader_free (reader);
+}
+END_TEST
+
+/* Span */
+
+START_TEST (test_span)
+{
+  XML_Char const *data = NULL;
+
+  scew_reader *reader = scew_reader_mmap_create (TEST_FILE);
+
+  CHECK_PTR (reader, "Unable to create mmap reader");
+
+  /* Skip the first character to check the span offset. */
+  XML_Char first[2] = _XT("");
+  CHECK_U_INT (scew_reader_read (reader, first, 1), 1,
+               "Invalid number of read bytes");
+
+  size_t length = scew_reader_span (reader, &data);
+
+  CHECK_PTR ((void *) data, "Memory-mapped readers must support spans");
+  CHECK_U_INT (length, scew_strlen (TEST_CONTENTS) - 1,
+               "Span should contain the rest of the file");
+  CHECK_BOOL (memcmp (data, TEST_CONTENTS + 1, length * sizeof (XML_Char)) == 0,
+              SCEW_TRUE, "Span contents do not match");
+
+  CHECK_BOOL (scew_reader_end (reader), SCEW_TRUE,
+              "Reader should be at the end");
+
+  length = scew_reader_span (reader, &data);
+
+  CHECK_PTR ((void *) data, "Span data should always be valid");
+  CHECK_U_INT (length, 0, "There is no more data to span");
+
+  scew_reader_free (reader);
+}
+END_TEST
+
+/* Miscellaneous */
+
+START_TEST (test_misc)
+{
+  scew_reader *reader = scew_reader_mmap_create (TEST_FILE);
+
+  CHECK_PTR (reader, "Unable to create mmap reader: %s", TEST_FILE);
+
+  CHECK_BOOL (scew_reader_end (reader), SCEW_FALSE,
+              "Reader should be at the beginning");
+
+  CHECK_BOOL (scew_reader_error (reader), SCEW_FALSE,
+              "Reader should have no error (nothing done yet)");
+
+  /* Close reader */
+  CHECK_BOOL (scew_reader_close (reader), SCEW_TRUE,
+              "Unable to close mmap reader");
+
+  CHECK_BOOL (scew_reader_end (reader), SCEW_TRUE,
+              "Reader is closed, thus at the end");
+
+  scew_reader_free (reader);
+}
+END_TEST
+
+
+/* Suite */
+
+static Suite*
+reader_mmap_suite (void)
+{
+  Suite *s = suite_create ("SCEW memory-mapped file reader");
+
+  /* Core test case */
+  TCase *tc_core = tcase_create ("Core");
+  tcase_add_test (tc_core, test_alloc);
+  tcase_add_test (tc_core, test_read);
+  tcase_add_test (tc_core, test_span);
+  tcase_add_test (tc_core, test_misc);
+  suite_add_tcase (s, tc_core);
+
+  return s;
+}
+
+void
+run_tests (SRunner *sr)
+{
+  srunner_add_suite (sr, reader_mmap_suite ());
+}
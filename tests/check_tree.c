@@ -28,6 +28,7 @@
 
 #include "test.h"
 
+#include <scew/attribute.h>
 #include <scew/tree.h>
 
 #include <check.h>
@@ -35,6 +36,14 @@
 
 /* Unit tests */
 
+enum { MAX_INDEXED = 1024 };
+
+static void check_index_ (scew_tree const *tree, XML_Char const *name);
+static unsigned int collect_ (scew_element *element,
+                              XML_Char const *name,
+                              scew_element **elements,
+                              unsigned int n_elements);
+
 /* Allocation */
 
 START_TEST (test_alloc)
@@ -172,6 +181,275 @@ START_TEST (test_compare)
 }
 END_TEST
 
+/* Parallel copy */
+
+START_TEST (test_copy_parallel)
+{
+  static unsigned int const N_GROUPS = 3;
+  static unsigned int const N_ELEMENTS = 200;
+
+  scew_tree *tree = scew_tree_create ();
+  scew_element *root = scew_tree_set_root (tree, _XT("root"));
+  scew_element *element = NULL;
+  scew_tree *tree_copy = NULL;
+  unsigned int threads[] = { 1, 4, 0 };
+  unsigned int i = 0;
+  unsigned int j = 0;
+
+  /* Few children at the top and many below, some of them nested. */
+  for (i = 0; i < N_GROUPS; ++i)
+    {
+      scew_element *group = scew_element_add (root, _XT("group"));
+      for (j = 0; j < N_ELEMENTS; ++j)
+        {
+          element = scew_element_add (group, _XT("element"));
+          scew_element_add_attribute_pair (element, _XT("a"), _XT("1"));
+          scew_element_add_attribute_pair (element, _XT("b"), _XT("2"));
+          if (j % 2 == 0)
+            {
+              scew_element_set_contents (element, _XT("contents"));
+            }
+          else
+            {
+              scew_element_add_pair (element, _XT("nested"), _XT("value"));
+            }
+        }
+    }
+
+  /* Copies keep the hashes already computed. */
+  scew_element_hash (root);
+
+  for (i = 0; i < sizeof (threads) / sizeof (threads[0]); ++i)
+    {
+      tree_copy = scew_tree_copy_parallel (tree, threads[i]);
+
+      CHECK_PTR (tree_copy, "Unable to copy tree with %d threads", threads[i]);
+
+      CHECK_BOOL (scew_element_hash (scew_tree_root (tree_copy))
+                  == scew_element_hash (root), SCEW_TRUE,
+                  "Tree and parallel copy should have the same hash");
+
+      CHECK_BOOL (scew_tree_compare (tree, tree_copy, NULL), SCEW_TRUE,
+                  "Tree and parallel copy should be equal (%d threads)",
+                  threads[i]);
+
+      element = scew_element_by_index (scew_tree_root (tree_copy), 2);
+      element = scew_element_by_index (element, N_ELEMENTS - 1);
+
+      CHECK_U_INT (scew_element_attribute_count (element), 2,
+                   "Number of attributes does not match");
+      CHECK_PTR (scew_element_by_name (element, _XT("nested")),
+                 "Nested element not copied");
+      CHECK_BOOL (scew_element_parent (scew_element_parent (element))
+                  == scew_tree_root (tree_copy), SCEW_TRUE,
+                  "Parent of copied element does not match");
+
+      /* The copy can still be modified. */
+      scew_element_add_pair (element, _XT("new"), _XT("value"));
+      scew_element_add_attribute_pair (element, _XT("c"), _XT("3"));
+      scew_element_set_name (element, _XT("renamed"));
+
+      /* Wide copied elements are searched via their index. */
+      CHECK_BOOL (scew_element_by_name (scew_element_parent (element),
+                                        _XT("renamed")) == element,
+                  SCEW_TRUE, "Renamed copied element should be found");
+      CHECK_BOOL (scew_element_by_name (scew_element_parent (element),
+                                        _XT("element"))
+                  == scew_element_by_index (scew_element_parent (element), 0),
+                  SCEW_TRUE, "First copied element found by name mismatch");
+
+      scew_element_delete_by_index (scew_tree_root (tree_copy), 0);
+
+      CHECK_BOOL (scew_tree_compare (tree, tree_copy, NULL), SCEW_FALSE,
+                  "Tree and modified copy should be different");
+
+      scew_tree_free (tree_copy);
+    }
+
+  scew_tree_free (tree);
+}
+END_TEST
+
+/* Index */
+
+START_TEST (test_index)
+{
+  static XML_Char const *NAMES[] = { _XT("root"), _XT("group"),
+                                     _XT("item"), _XT("leaf"),
+                                     _XT("renamed"), _XT("other") };
+  static unsigned int const N_NAMES = sizeof (NAMES) / sizeof (NAMES[0]);
+  static unsigned int const N_GROUPS = 4;
+  static unsigned int const N_ITEMS = 20;
+
+  scew_tree *tree = scew_tree_create ();
+  scew_element *root = scew_tree_set_root (tree, _XT("root"));
+  scew_element *group = NULL;
+  scew_element *element = NULL;
+  scew_element *subtree = NULL;
+  scew_element * const *elements = NULL;
+  XML_Char id[CHECK_MAX_BUFFER_];
+  unsigned int i = 0;
+  unsigned int j = 0;
+
+  for (i = 0; i < N_GROUPS; ++i)
+    {
+      group = scew_element_add (root, _XT("group"));
+      for (j = 0; j < N_ITEMS; ++j)
+        {
+          check_sprintf (id, _XT("%u.%u"), i, j);
+          element = scew_element_add (group, _XT("item"));
+          scew_element_add_attribute_pair (element, _XT("id"), id);
+          if (j % 3 == 0)
+            {
+              scew_element_add (element, _XT("leaf"));
+            }
+        }
+    }
+
+  CHECK_BOOL (scew_tree_build_index (tree, _XT("id")), SCEW_TRUE,
+              "Unable to build tree index");
+
+  CHECK_U_INT (scew_tree_elements_by_name (tree, _XT("item"), &elements),
+               N_GROUPS * N_ITEMS, "Number of indexed elements does not match");
+  CHECK_U_INT (scew_tree_elements_by_name (tree, _XT("none"), &elements), 0,
+               "No elements should be found");
+  for (i = 0; i < N_NAMES; ++i)
+    {
+      check_index_ (tree, NAMES[i]);
+    }
+
+  element = scew_element_by_index (scew_element_by_index (root, 2), 5);
+  CHECK_BOOL (scew_tree_element_by_attribute (tree, _XT("2.5")) == element,
+              SCEW_TRUE, "Element by attribute does not match");
+  CHECK_NULL_PTR (scew_tree_element_by_attribute (tree, _XT("none")),
+                  "No element should be found by attribute");
+
+  /* Add a subtree in the middle of the document. */
+  subtree = scew_element_create (_XT("item"));
+  scew_element_add_attribute_pair (subtree, _XT("id"), _XT("new"));
+  scew_element_add (scew_element_add (subtree, _XT("leaf")), _XT("leaf"));
+  scew_element_add_element (scew_element_by_index (root, 1), subtree);
+
+  /* Move the last group inside the first one. */
+  group = scew_element_by_index (root, 3);
+  scew_element_detach (group);
+  scew_element_add_element (scew_element_by_index (root, 0), group);
+
+  /* The moved group is merged into place before looking up. */
+  CHECK_BOOL (scew_tree_update_index (tree), SCEW_TRUE,
+              "Unable to update tree index");
+
+  for (i = 0; i < N_NAMES; ++i)
+    {
+      check_index_ (tree, NAMES[i]);
+    }
+  CHECK_BOOL (scew_tree_element_by_attribute (tree, _XT("new")) == subtree,
+              SCEW_TRUE, "Added element not found by attribute");
+
+  /* Rename, change and delete elements and attributes. */
+  scew_element_add (scew_element_by_index (root, 0), _XT("item"));
+  scew_element_set_name (scew_element_by_index (group, 4), _XT("renamed"));
+  scew_element_delete_by_index (scew_element_by_index (root, 1), 7);
+  scew_element_delete_all (scew_element_by_index (root, 2));
+  scew_element_add (scew_element_by_index (root, 2), _XT("other"));
+  scew_element_free (subtree);
+
+  element = scew_element_by_index (group, 0);
+  scew_attribute_set_value (scew_element_attribute_by_name (element,
+                                                            _XT("id")),
+                            _XT("changed"));
+  scew_element_delete_attribute_by_name (scew_element_by_index (group, 1),
+                                         _XT("id"));
+
+  for (i = 0; i < N_NAMES; ++i)
+    {
+      check_index_ (tree, NAMES[i]);
+    }
+  CHECK_BOOL (scew_tree_element_by_attribute (tree, _XT("changed"))
+              == element, SCEW_TRUE, "Changed attribute not found");
+  CHECK_NULL_PTR (scew_tree_element_by_attribute (tree, _XT("3.0")),
+                  "Changed attribute should not be found");
+  CHECK_NULL_PTR (scew_tree_element_by_attribute (tree, _XT("3.1")),
+                  "Deleted attribute should not be found");
+  CHECK_NULL_PTR (scew_tree_element_by_attribute (tree, _XT("new")),
+                  "Freed element should not be found");
+
+  /* A new root replaces the whole index. */
+  element = scew_element_create (_XT("root"));
+  scew_element_add (element, _XT("leaf"));
+  scew_tree_set_root_element (tree, element);
+
+  CHECK_U_INT (scew_tree_elements_by_name (tree, _XT("item"), &elements), 0,
+               "Elements of the old root should not be found");
+  check_index_ (tree, _XT("leaf"));
+
+  /* The old root is no longer indexed. */
+  scew_element_add (root, _XT("leaf"));
+  scew_element_free (root);
+
+  check_index_ (tree, _XT("leaf"));
+
+  scew_tree_free_index (tree);
+  scew_element_add (element, _XT("leaf"));
+
+  CHECK_BOOL (scew_tree_build_index (tree, NULL), SCEW_TRUE,
+              "Unable to build tree index again");
+  check_index_ (tree, _XT("leaf"));
+  CHECK_NULL_PTR (scew_tree_element_by_attribute (tree, _XT("3.0")),
+                  "No attribute should be indexed");
+
+  scew_tree_free (tree);
+}
+END_TEST
+
+
+
+
+/* Private */
+
+void
+check_index_ (scew_tree const *tree, XML_Char const *name)
+{
+  scew_element *expected[MAX_INDEXED];
+  scew_element * const *elements = NULL;
+  unsigned int n_expected =
+    collect_ (scew_tree_root (tree), name, expected, 0);
+  unsigned int i = 0;
+
+  CHECK_U_INT (scew_tree_elements_by_name (tree, name, &elements),
+               n_expected, "Number of indexed %s elements does not match",
+               name);
+
+  for (i = 0; i < n_expected; ++i)
+    {
+      CHECK_BOOL (elements[i] == expected[i], SCEW_TRUE,
+                  "Indexed %s element %d is not in document order", name, i);
+    }
+}
+
+unsigned int
+collect_ (scew_element *element,
+          XML_Char const *name,
+          scew_element **elements,
+          unsigned int n_elements)
+{
+  unsigned int i = 0;
+
+  if (scew_strcmp (scew_element_name (element), name) == 0)
+    {
+      elements[n_elements++] = element;
+    }
+
+  for (i = 0; i < scew_element_count (element); ++i)
+    {
+      n_elements = collect_ (scew_element_by_index (element, i), name,
+                             elements, n_elements);
+    }
+
+  return n_elements;
+}
+
+
 
 
 /* Suite */
@@ -187,6 +465,8 @@ tree_suite (void)
   tcase_add_test (tc_core, test_properties);
   tcase_add_test (tc_core, test_contents);
   tcase_add_test (tc_core, test_compare);
+  tcase_add_test (tc_core, test_copy_parallel);
+  tcase_add_test (tc_core, test_index);
   suite_add_tcase (s, tc_core);
 
   return s;
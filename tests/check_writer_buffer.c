@@ -113,6 +113,10 @@ START_TEST (test_misc)
   CHECK_BOOL (scew_writer_error (writer), SCEW_FALSE,
               "Writer should have no error (nothing done yet)");
 
+  /* Buffer writers have no flush hook. */
+  CHECK_BOOL (scew_writer_flush (writer), SCEW_TRUE,
+              "Writers with no flush hook should always flush");
+
   /* Close writer */
   scew_writer_close (writer);
 
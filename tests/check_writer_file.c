@@ -127,6 +127,46 @@ START_TEST (test_write)
 }
 END_TEST
 
+/* Flush */
+
+START_TEST (test_flush)
+{
+  enum { MAX_BUFFER_SIZE = 512 };
+
+  XML_Char read_buffer[MAX_BUFFER_SIZE] = _XT("");
+
+  FILE *file = fopen (TEST_FILE, "wb");
+
+  scew_writer *writer = scew_writer_fp_buffered_create (file, MAX_BUFFER_SIZE);
+
+  CHECK_PTR (writer, "Unable to create buffered file pointer writer");
+
+  unsigned int i = 0;
+  while (i < scew_strlen (TEST_CONTENTS))
+    {
+      CHECK_U_INT (scew_writer_write (writer, TEST_CONTENTS + i, 1), 1,
+                   "Invalid number of written bytes");
+      i += 1;
+    }
+
+  CHECK_BOOL (scew_writer_flush (writer), SCEW_TRUE,
+              "Unable to flush writer");
+
+  /* Data must be in the file before closing the writer */
+  scew_reader *reader = scew_reader_file_create (TEST_FILE);
+
+  scew_reader_read (reader, read_buffer, scew_strlen (TEST_CONTENTS) + 1);
+
+  CHECK_STR (read_buffer, TEST_CONTENTS, "Buffers do not match");
+
+  scew_reader_free (reader);
+  scew_writer_free (writer);
+
+  /* Remove test file from hard drive */
+  remove (TEST_FILE);
+}
+END_TEST
+
 /* Miscellaneous */
 
 START_TEST (test_misc)
@@ -166,6 +206,7 @@ writer_file_suite (void)
   TCase *tc_core = tcase_create ("Core");
   tcase_add_test (tc_core, test_alloc);
   tcase_add_test (tc_core, test_write);
+  tcase_add_test (tc_core, test_flush);
   tcase_add_test (tc_core, test_misc);
   suite_add_tcase (s, tc_core);
 
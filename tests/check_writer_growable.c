@@ -0,0 +1,183 @@
+/**
+ * @file     check_writer_growable.c
+ * @brief    Unit testing for SCEW growable writer
+ * @author   Aleix Conchillo Flaque <aconchillo@gmail.com>
+ * @date     Sun Oct 18, 2026 10:12
+ *
+ * @if copyright
+ *
+ * Copyright (C) 2026 Aleix Conchillo Flaque
+ *
+ * SCEW is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * SCEW is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA
+ * 02110-1301, USA.
+ *
+ * @endif
+ */
+
+#include "test.h"
+
+#include <scew/writer_growable.h>
+#include <scew/printer.h>
+#include <scew/tree.h>
+
+#include <check.h>
+
+
+/* Unit tests */
+
+static XML_Char const *TEST_CONTENTS =
+  _XT("This is just a dummy buffer to test the SCEW growable writer. "
+      "It is longer than the initial size of the writer buffer.");
+
+/* Allocation */
+
+START_TEST (test_alloc)
+{
+  scew_writer *writer = scew_writer_growable_create (0);
+
+  CHECK_PTR (writer, "Unable to create growable writer");
+
+  CHECK_STR (scew_writer_growable_buffer (writer), _XT(""),
+             "Buffer should be empty");
+
+  scew_writer_free (writer);
+}
+END_TEST
+
+/* Write */
+
+START_TEST (test_write)
+{
+  scew_writer *writer = scew_writer_growable_create (4);
+
+  CHECK_PTR (writer, "Unable to create growable writer");
+
+  unsigned int i = 0;
+  while (i < scew_strlen (TEST_CONTENTS))
+    {
+      CHECK_U_INT (scew_writer_write (writer, TEST_CONTENTS + i, 1), 1,
+                   "Invalid number of written bytes");
+      i += 1;
+    }
+
+  CHECK_STR (scew_writer_growable_buffer (writer), TEST_CONTENTS,
+             "Buffers do not match");
+  CHECK_U_INT (scew_writer_growable_length (writer),
+               scew_strlen (TEST_CONTENTS), "Invalid buffer length");
+
+  /* Reuse the writer */
+  scew_writer_growable_reset (writer);
+
+  CHECK_U_INT (scew_writer_growable_length (writer), 0,
+               "Writer should be empty after reset");
+
+  scew_writer_write (writer, TEST_CONTENTS, scew_strlen (TEST_CONTENTS));
+
+  CHECK_STR (scew_writer_growable_buffer (writer), TEST_CONTENTS,
+             "Buffers do not match");
+
+  scew_writer_free (writer);
+}
+END_TEST
+
+/* Detach */
+
+START_TEST (test_detach)
+{
+  size_t length = 0;
+
+  scew_writer *writer = scew_writer_growable_create (0);
+  scew_tree *tree = scew_tree_create ();
+  scew_printer *printer = scew_printer_create (writer);
+
+  scew_tree_set_root (tree, _XT("root"));
+
+  CHECK_BOOL (scew_printer_print_tree (printer, tree), SCEW_TRUE,
+              "Unable to print tree");
+
+  XML_Char *detached = scew_writer_growable_detach (writer, &length);
+
+  CHECK_PTR (detached, "Unable to detach buffer");
+  CHECK_U_INT (length, scew_strlen (detached), "Invalid buffer length");
+  CHECK_U_INT (scew_writer_growable_length (writer), 0,
+               "Writer should be empty after detach");
+
+  /* Writer can still be used */
+  scew_writer_write (writer, TEST_CONTENTS, scew_strlen (TEST_CONTENTS));
+
+  CHECK_STR (scew_writer_growable_buffer (writer), TEST_CONTENTS,
+             "Buffers do not match");
+
+  free (detached);
+  scew_printer_free (printer);
+  scew_tree_free (tree);
+  scew_writer_free (writer);
+}
+END_TEST
+
+/* Miscellaneous */
+
+START_TEST (test_misc)
+{
+  scew_writer *writer = scew_writer_growable_create (0);
+
+  CHECK_PTR (writer, "Unable to create growable writer");
+
+  CHECK_BOOL (scew_writer_end (writer), SCEW_FALSE,
+              "Writer should be at the beginning");
+
+  CHECK_BOOL (scew_writer_error (writer), SCEW_FALSE,
+              "Writer should have no error (nothing done yet)");
+
+  /* Close writer */
+  scew_writer_close (writer);
+
+  CHECK_BOOL (scew_writer_end (writer), SCEW_TRUE,
+              "Writer is closed, thus at the end");
+
+  /* Reset reopens the writer */
+  scew_writer_growable_reset (writer);
+
+  CHECK_BOOL (scew_writer_end (writer), SCEW_FALSE,
+              "Writer should be reopened after reset");
+
+  scew_writer_free (writer);
+}
+END_TEST
+
+
+/* Suite */
+
+static Suite*
+writer_growable_suite (void)
+{
+  Suite *s = suite_create ("SCEW growable writer");
+
+  /* Core test case */
+  TCase *tc_core = tcase_create ("Core");
+  tcase_add_test (tc_core, test_alloc);
+  tcase_add_test (tc_core, test_write);
+  tcase_add_test (tc_core, test_detach);
+  tcase_add_test (tc_core, test_misc);
+  suite_add_tcase (s, tc_core);
+
+  return s;
+}
+
+void
+run_tests (SRunner *sr)
+{
+  srunner_add_suite (sr, writer_growable_suite ());
+}